@@ -49,14 +49,80 @@
 #define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
 #define configMAX_PRIORITIES		( 4 )
 #define configMINIMAL_STACK_SIZE	( ( unsigned short ) 90 )
-#define configTOTAL_HEAP_SIZE		( ( size_t ) 13 * 1024 )
+#define configTOTAL_HEAP_SIZE		( ( size_t ) 8 * 1024 )	/* Leaves room in the 16KB of RAM for the trace buffer. */
 #define configMAX_TASK_NAME_LEN		( 8 )
 #define configUSE_TRACE_FACILITY	1
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 
+/* The 8KB heap holds the three 512 word task stacks, the idle task and the serial driver
+	with about 500 bytes to spare.  The deepest task, Task3 writing the stats to the serial
+	port, was measured to use 1976 bytes of a host stack with 8 byte words, including about
+	1KB of saved context where the ARM7 port saves 72 bytes, so 512 words leaves it about
+	half its stack free.  Check the stacks at each context switch and stop if either a stack
+	or the heap runs out, the "stack" column of the stats on the serial port shows the high
+	water mark of each task on the board */
+#define configCHECK_FOR_STACK_OVERFLOW	2
+#define configUSE_MALLOC_FAILED_HOOK	1
+
+/* Stop the tick while no job is Ready and program Timer0 to interrupt at the next task
+	wakeup instead, the processor waits in idle mode in between */
+#define configUSE_TICKLESS_IDLE		1
+
 #define configUSE_EDF_SCHEDULER		1
 
+/* Set to 1, with configUSE_EDF_SCHEDULER set to 0, to dispatch from a schedule table made
+	offline by Project/Tools/tt_schedule_gen instead, see xTaskSetTimeTriggeredSchedule() */
+#define configUSE_TIME_TRIGGERED_SCHEDULER	0
+
+/* Set to 1, with configUSE_EDF_SCHEDULER set to 0, to give the tasks made by xTaskPeriodicCreate()
+	rate monotonic (tskPRIORITY_RATE_MONOTONIC) or deadline monotonic (tskPRIORITY_DEADLINE_MONOTONIC)
+	priorities instead of the priority passed in, see eTaskTestFixedPriorityTaskSet() */
+#define configUSE_FP_PRIORITY_ASSIGNMENT	0
+#define configFP_PRIORITY_POLICY			tskPRIORITY_RATE_MONOTONIC
+
+/* Set to 1 to keep the EDF ready tasks in a binary heap instead of a sorted list,
+	the heap has a place for every task but the idle task, and creating a task fails once all are taken */
+#define configEDF_USE_READY_HEAP		0
+#define configEDF_READY_HEAP_LENGTH	( 8 )
+
+/* Set to 1 to keep fixed priority scheduling between priorities, with EDF only inside the
+	priorities set in configEDF_BAND_MASK, so tasks deferred from interrupts can run above the jobs */
+#define configUSE_EDF_PRIORITY_BANDS	0
+#define configEDF_BAND_MASK			( 1UL << 1 )
+
+/* Deadline misses are always counted per task, set these to 1 to also catch them from
+	the tick while the late job is still ready and to call vApplicationDeadlineMissHook() */
+#define configEDF_CHECK_DEADLINES_ON_TICK	1
+#define configUSE_DEADLINE_MISS_HOOK		0
+
+/* Refuse a periodic task at creation if the task set would no longer be schedulable */
+#define configUSE_EDF_ADMISSION_CONTROL	1
+
+/* The longest interval in ticks the admission test checks constrained deadlines over, a task
+	set that needs a longer one is refused so the test cannot hold the scheduler off for long */
+#define configEDF_MAX_DEMAND_INTERVAL	10000
+
+/* Set to 1 to build the constant bandwidth server in cbs.c for aperiodic jobs */
+#define configUSE_EDF_CBS				0
+
+/* Set to 1 to build xTaskSporadicCreate() for event released jobs with a minimum inter-arrival time */
+#define configUSE_EDF_SPORADIC_TASKS	0
+
+/* Set to 1 to charge each job's run time against its WCET and apply the overrun policy
+	(tskOVERRUN_NOTIFY, tskOVERRUN_DEMOTE or tskOVERRUN_THROTTLE) to a job that exceeds it,
+	the run time counter below counts microseconds so a budget is the WCET in ticks times 1000 */
+#define configUSE_EDF_BUDGET_ENFORCEMENT	0
+#define configEDF_OVERRUN_POLICY			tskOVERRUN_DEMOTE
+#define configEDF_RUN_TIME_COUNTS_PER_TICK	( configRUN_TIME_COUNTER_HZ / configTICK_RATE_HZ )
+
+/* Set to 1 to keep the response time, start jitter and last job timing of each periodic
+	task, vTaskGetJobStats() formats them as a table */
+#define configUSE_EDF_JOB_STATISTICS		1
+
+/* Set to 1 to build xTaskChangeMode() for switching the periodic tasks between modes at run time */
+#define configUSE_EDF_MODE_CHANGES		0
+
 
 #define configQUEUE_REGISTRY_SIZE 	0
 #define configUSE_MUTEXES				1
@@ -82,49 +148,28 @@ to exclude the API function. */
 #define configUSE_APPLICATION_TASK_TAG	1
 
 
-/* Here we define our tracing macro for when we switch into a task and we assigned a GPIO for each task
-	and according to the value of the current task tag that we assigned in our application, we set the corresponding GPIO */
-	
-#define traceTASK_SWITCHED_IN() 		do\
-	{\
-  if( (int) pxCurrentTCB->pxTaskTag == 1 )/* Task 1 */\
-	{\
-		GPIO_write(PORT_0, PIN3, PIN_IS_HIGH);\
-	}\
-	else if( (int) pxCurrentTCB->pxTaskTag == 2 )/* Task 2 */\
-	{\
-		GPIO_write(PORT_0, PIN4, PIN_IS_HIGH);\
-	}\
-	else if( (int) pxCurrentTCB->pxTaskTag == 3 )/* Task 3 */\
-	{\
-		GPIO_write(PORT_0, PIN5, PIN_IS_HIGH);\
-	}\
-}while(0)
-
-
-/* Here we define our tracing macro similarly for when we switch out from a task and we assigned a GPIO for each task
-	and according to the value of the current task tag that we assigned in our application, we set the corresponding GPIO */
-#define traceTASK_SWITCHED_OUT() 		do\
-	{\
-  if( (int) pxCurrentTCB->pxTaskTag == 1 )\
-	{\
-		GPIO_write(PORT_0, PIN3, PIN_IS_LOW);\
-	}\
-	else if( (int) pxCurrentTCB->pxTaskTag == 2 )\
-	{\
-		GPIO_write(PORT_0, PIN4, PIN_IS_LOW);\
-	}\
-	else if( (int) pxCurrentTCB->pxTaskTag == 3 )\
-	{\
-		GPIO_write(PORT_0, PIN5, PIN_IS_LOW);\
-	}\
-}while(0)
-
-
-/* Run time status */
+/* Record the kernel events (task switches, ready and blocked tasks, queues, ticks, deadline
+	misses) into a RAM ring buffer as binary records of 3 to 4 bytes, decoded on the host with
+	Project/Tools/trace_decode.  In snapshot mode the oldest records are overwritten so the buffer
+	holds the latest history, see trace_recorder.h */
+#define configUSE_TRACE_RECORDER			1
+#define configTRACE_RECORDER_BUFFER_SIZE	( 4096 )
+#define configTRACE_RECORDER_MODE			tskTRACE_SNAPSHOT
+
+/* The events are stamped with the tick count rather than the microsecond run time counter,
+	which keeps the time of most records to one byte.  The ticks are then implied by the time
+	of each record and are not recorded, with the three tasks of main.c 4KB holds about 48
+	seconds of history */
+#define configTRACE_RECORDER_TIMESTAMP()	( ( uint32_t ) xTaskGetTickCountFromISR() )
+#define traceTASK_INCREMENT_TICK( xTickCount )
+#define traceINCREASE_TICK_COUNT( xTicksToJump )
+
+
+/* Run time status, counted by the port on Timer1 in microseconds.  A 32 bit count would
+	wrap after 71 minutes, the port extends it to 64 bits */
 #define configGENERATE_RUN_TIME_STATS  1
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() 
-#define portGET_RUN_TIME_COUNTER_VALUE() xTaskGetTickCount()	/* Here i could not find timerconfig so i just decided to use the RTOS tick for my calculation */
+#define configRUN_TIME_COUNTER_HZ		( 1000000UL )
+#define configRUN_TIME_COUNTER_TYPE		uint64_t
 #define configSUPPORT_DYNAMIC_ALLOCATION	1
 #define configUSE_STATS_FORMATTING_FUNCTIONS    1
 
@@ -87,7 +87,10 @@ typedef enum
 } eBaud;
 
 void xSerialPortInitMinimal( unsigned long ulWantedBaud);
+/* vSerialPutString() and xSerialPutStringTimeout() with no block time do not
+wait for space, so they can only send strings of up to 200 bytes. */
 signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength);
+signed portBASE_TYPE xSerialPutStringTimeout( const signed char * const pcString, unsigned short usStringLength, TickType_t xBlockTime );
 signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar);
 void xSerialPutChar(signed char cOutChar);
 
@@ -96,8 +96,13 @@ const TickType_t xTask1Frequency = 300 ;
 const TickType_t xTask2Frequency = 500 ;
 const TickType_t xTask3Frequency = 750 ;
 
-/* a buffer to store the runtime stats */
-char runTimeStatusBuffer[200];
+/* The worst case execution time of each of the tasks in ms, used by the admission test */
+const TickType_t xTask1Wcet = 50 ;
+const TickType_t xTask2Wcet = 150 ;
+const TickType_t xTask3Wcet = 100 ;
+
+/* Writes each record of the runtime stats to the serial port as it is made */
+static BaseType_t prvSendStatsRecord( const uint8_t * pucRecord, size_t xLength, void * pvContext );
 
 
 /* A dummy delay function to simulate a task load in ms */
@@ -113,12 +118,11 @@ void dummyLoad_ms(uint32_t delay)
 /* Task 1, has a period of 300ms with a load of 50ms */
 void vTask1_300( void * pvParameters )
 {
-		TickType_t xLastWakeTime = 0;
-
 		for( ;; )
 		{
+			/* The kernel releases a job every period */
+			xTaskWaitForNextPeriod( NULL );
 			dummyLoad_ms(50);
-			vTaskDelayUntil( &xLastWakeTime, xTask1Frequency );
 		}
 }
 
@@ -126,35 +130,38 @@ void vTask1_300( void * pvParameters )
 /* Task 2, has a period of 500ms with a load of 150ms */
 void vTask2_500( void * pvParameters )
 {
-		TickType_t xLastWakeTime = 0;
-
 		for( ;; )
 		{
+			xTaskWaitForNextPeriod( NULL );
 			dummyLoad_ms(150);
-			vTaskDelayUntil( &xLastWakeTime, xTask2Frequency );
 		}
 }
 
 /* Task 3, has a period of 750ms with a load of 100ms and we print the runtime status in this task */
 void vTask3_750( void * pvParameters )
 {
-		TickType_t xLastWakeTime = 0;
-
 		for( ;; )
 		{
+			xTaskWaitForNextPeriod( NULL );
 			/* making the delay 99 instead of 100 to compensate */
 			dummyLoad_ms(99);
-			/* Here we print the runtime status */
-			vTaskGetRunTimeStats( runTimeStatusBuffer );
-			xSerialPutChar('\n');
-			vSerialPutString( runTimeStatusBuffer, 200 ); 
-			vTaskDelayUntil( &xLastWakeTime, xTask3Frequency );
-			
-
+			/* Here we print the runtime status, one task at a time so nothing
+			has to be allocated or held for all the tasks at once */
+			uxTaskStreamStats( eTaskStatsCSV, prvSendStatsRecord, NULL );
 		}
 }
 
 
+static BaseType_t prvSendStatsRecord( const uint8_t * pucRecord, size_t xLength, void * pvContext )
+{
+	( void ) pvContext;
+
+	/* Block until the serial driver has room for the record, the task is not
+	using the processor while the UART sends the lines before it */
+	return xSerialPutStringTimeout( ( const signed char * ) pucRecord, ( unsigned short ) xLength, portMAX_DELAY );
+}
+
+
 int main( void )
 {
 	/* Setup the hardware for use with the Keil demo board. */
@@ -162,29 +169,32 @@ int main( void )
 	
 	xTaskPeriodicCreate(	vTask3_750 ,       /* Function that implements the task. */
 												"Task3",          /* Text name for the task. */
-												1000,      /* Stack size in words, not bytes. */
+												512,       /* Stack size in words, not bytes. */
 												( void * ) 0,    /* Parameter passed into the task. */
 												1,/* Priority at which the task is created. */
-												&xTask3Handle,
-												xTask3Frequency/* Used to pass out the created task's handle. */
+												&xTask3Handle,/* Used to pass out the created task's handle. */
+												xTask3Frequency,/* Period of the task. */
+												xTask3Wcet/* Worst case execution time of the task. */
 										);									
 								
 	xTaskPeriodicCreate(	vTask2_500 ,       /* Function that implements the task. */
 												"Task2",          /* Text name for the task. */
-												1000,      /* Stack size in words, not bytes. */
+												512,       /* Stack size in words, not bytes. */
 												( void * ) 0,    /* Parameter passed into the task. */
 												1,/* Priority at which the task is created. */
-												&xTask2Handle,
-												xTask2Frequency/* Used to pass out the created task's handle. */
+												&xTask2Handle,/* Used to pass out the created task's handle. */
+												xTask2Frequency,/* Period of the task. */
+												xTask2Wcet/* Worst case execution time of the task. */
 										);
 
 	xTaskPeriodicCreate(	vTask1_300 ,       /* Function that implements the task. */
 												"Task1",          /* Text name for the task. */
-												1000,      /* Stack size in words, not bytes. */
+												512,       /* Stack size in words, not bytes. */
 												( void * ) 0,    /* Parameter passed into the task. */
 												1,/* Priority at which the task is created. */
-												&xTask1Handle,
-												xTask1Frequency/* Used to pass out the created task's handle. */
+												&xTask1Handle,/* Used to pass out the created task's handle. */
+												xTask1Frequency,/* Period of the task. */
+												xTask1Wcet/* Worst case execution time of the task. */
 										);
 											
 	/* Set application tags for each of the task to be used for debugging with the trace APIs */										
@@ -224,4 +234,24 @@ static void prvSetupHardware( void )
 }
 /*-----------------------------------------------------------*/
 
+/* Called from the context switch when the stack of xTask has overflowed.  Stop here
+with the trace buffer holding the events that led up to it */
+void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName )
+{
+	( void ) xTask;
+	( void ) pcTaskName;
+
+	taskDISABLE_INTERRUPTS();
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
+/* Called when pvPortMalloc() fails, the heap is too small for the tasks and drivers */
+void vApplicationMallocFailedHook( void )
+{
+	taskDISABLE_INTERRUPTS();
+	for( ;; );
+}
+/*-----------------------------------------------------------*/
+
 
@@ -27,10 +27,12 @@
 
 
 /* 
-	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART0. 
+	BASIC INTERRUPT DRIVEN SERIAL PORT DRIVER FOR UART1. 
 
-	Note this driver is used to test the FreeRTOS port.  It is NOT intended to
-	be an example of an efficient implementation!
+	Transmitted strings are appended to a stream buffer, which the THRE
+	interrupt empties into the UART FIFO up to 16 characters at a time.  The
+	tasks writing to the port take a mutex so their strings are not mixed, the
+	stream buffer itself only supports a single writer.
 */
 
 /* Standard includes. */
@@ -39,7 +41,9 @@
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "queue.h"
+#include "semphr.h"
 #include "task.h"
+#include "stream_buffer.h"
 
 /* Demo application includes. */
 #include "serial.h"
@@ -76,13 +80,40 @@
 #define serINTERRUPT_SOURCE_MASK		( ( unsigned char ) 0x0f )
 #define serINTERRUPT_IS_PENDING			( ( unsigned char ) 0x01 )
 
+/* Constants for the transmit path.  The stream buffer holds as many bytes as
+it is created with, so a string of up to 200 bytes, the most the previous
+driver took in one call, can be sent without blocking. */
+#define serTX_BUFFER_LENGTH				( ( size_t ) 200 )
+#define serTX_FIFO_LENGTH				( ( size_t ) 16 )
+#define serNO_BLOCK						( ( TickType_t ) 0 )
+
 /*-----------------------------------------------------------*/
 unsigned char receivedChar;
 unsigned char isNewCharAvailable = 0;
 
-unsigned char txBuffer[200];
-unsigned char txDataSizeToSend;
-unsigned char txDataSizeLeftToSend;
+/* The characters waiting to be moved to the UART FIFO. */
+static StreamBufferHandle_t xTxStream = NULL;
+
+/* Held by the task writing to xTxStream. */
+static SemaphoreHandle_t xTxMutex = NULL;
+
+/* pdTRUE when the FIFO has been emptied with nothing left to send, so no
+THRE interrupt will come and the next string has to start the transmission
+itself. */
+static volatile portBASE_TYPE xTxIdle = pdTRUE;
+
+/*
+ * Move up to a FIFO's worth of characters from xTxStream to the UART,
+ * returning the number moved.  Must be called from the ISR or with
+ * interrupts disabled.
+ */
+static size_t prvFillTxFifo( portBASE_TYPE *pxHigherPriorityTaskWoken );
+
+/*
+ * Start sending the characters in xTxStream if the UART is idle.
+ */
+static void prvStartTransmission( void );
+
 /*
  * The asm wrapper for the interrupt service routine.
  */
@@ -99,6 +130,12 @@ void xSerialPortInitMinimal( unsigned long ulWantedBaud)
 {
     unsigned long ulDivisor, ulWantedClock;
 	
+	/* Create the transmit buffer and the mutex that serialises its writers. */
+	xTxStream = xStreamBufferCreate( serTX_BUFFER_LENGTH, ( size_t ) 1 );
+	xTxMutex = xSemaphoreCreateMutex();
+	configASSERT( xTxStream );
+	configASSERT( xTxMutex );
+
 	/* Configure the UART1 pins.  All other pins remain at their default of 0. */
 	PINSEL0 |= mainTX_ENABLE;
 	PINSEL0 |= mainRX_ENABLE;
@@ -149,34 +186,111 @@ signed portBASE_TYPE xSerialGetChar(signed char *pcRxedChar)
 }
 /*-----------------------------------------------------------*/
 
-signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
+signed portBASE_TYPE xSerialPutStringTimeout( const signed char * const pcString, unsigned short usStringLength, TickType_t xBlockTime )
 {
-	int i;
+TimeOut_t xTimeOut;
+const signed char *pcNext = pcString;
+size_t xLeft = ( size_t ) usStringLength, xSent;
 
-	if(txDataSizeLeftToSend == 0 && pcString != NULL)
+	if( pcString == NULL )
 	{
-	  txDataSizeToSend = usStringLength;
-	  txDataSizeLeftToSend = usStringLength;
-	
-	  for(i = 0;i < usStringLength; i++)
-	  {
-		  txBuffer[i] = pcString[i];
-	  }
-	
-	  xSerialPutChar(txBuffer[txDataSizeToSend - txDataSizeLeftToSend--]);
-		
-	  return pdTRUE;
+		return pdFALSE;
 	}
-	else
+
+	vTaskSetTimeOutState( &xTimeOut );
+
+	/* Only one task at a time can write to the stream buffer. */
+	if( xSemaphoreTake( xTxMutex, xBlockTime ) == pdFALSE )
+	{
+		return pdFALSE;
+	}
+
+	/* Without a block time the string is sent whole or not at all, so it
+	must fit in the buffer. */
+	configASSERT( ( xBlockTime != serNO_BLOCK ) || ( xLeft <= serTX_BUFFER_LENGTH ) );
+
+	if( ( xBlockTime == serNO_BLOCK ) && ( xStreamBufferSpacesAvailable( xTxStream ) < xLeft ) )
 	{
+		( void ) xSemaphoreGive( xTxMutex );
 		return pdFALSE;
 	}
+
+	/* Take the time spent waiting for the mutex off the block time. */
+	if( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE )
+	{
+		xBlockTime = serNO_BLOCK;
+	}
+
+	/* A string longer than the buffer goes in as the ISR makes room, the
+	transmission is started after each part so the ISR is always emptying the
+	buffer while this task waits for space. */
+	for( ;; )
+	{
+		xSent = xStreamBufferSend( xTxStream, pcNext, xLeft, xBlockTime );
+		pcNext += xSent;
+		xLeft -= xSent;
+
+		prvStartTransmission();
+
+		if( ( xLeft == ( size_t ) 0 ) || ( xTaskCheckForTimeOut( &xTimeOut, &xBlockTime ) != pdFALSE ) )
+		{
+			break;
+		}
+	}
+
+	( void ) xSemaphoreGive( xTxMutex );
+
+	return ( xLeft == ( size_t ) 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+signed portBASE_TYPE vSerialPutString(const signed char * const pcString, unsigned short usStringLength )
+{
+	return xSerialPutStringTimeout( pcString, usStringLength, serNO_BLOCK );
 }
 /*-----------------------------------------------------------*/
 
 void xSerialPutChar(signed char cOutChar)
 {
-	U1THR = cOutChar;
+	( void ) xSerialPutStringTimeout( &cOutChar, 1, serNO_BLOCK );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvFillTxFifo( portBASE_TYPE *pxHigherPriorityTaskWoken )
+{
+unsigned char ucFifo[ serTX_FIFO_LENGTH ];
+size_t xCount, x;
+
+	/* The FIFO is empty when THRE is set, so it can take a whole FIFO's worth
+	with one read of the stream buffer. */
+	xCount = xStreamBufferReceiveFromISR( xTxStream, ucFifo, sizeof( ucFifo ), pxHigherPriorityTaskWoken );
+
+	for( x = 0; x < xCount; x++ )
+	{
+		U1THR = ucFifo[ x ];
+	}
+
+	return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTransmission( void )
+{
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
+
+	/* No task can be waiting for space in the stream buffer as the caller is
+	its only writer, so xHigherPriorityTaskWoken is not used. */
+	portENTER_CRITICAL();
+	{
+		if( xTxIdle != pdFALSE )
+		{
+			if( prvFillTxFifo( &xHigherPriorityTaskWoken ) > ( size_t ) 0 )
+			{
+				xTxIdle = pdFALSE;
+			}
+		}
+	}
+	portEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
 
@@ -184,6 +298,7 @@ void vUART_ISRHandler( void )
 {
 signed char cChar;
 unsigned char ucInterrupt;
+portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
 	ucInterrupt = U1IIR;
 
@@ -199,10 +314,11 @@ unsigned char ucInterrupt;
 	
 			case serSOURCE_THRE	:	/* The THRE is empty */
 				
-				/* Do nothing */
-				if(txDataSizeLeftToSend > 0)
+				/* Refill the FIFO, or note that the next string has to
+				start the transmission if there is nothing left to send. */
+				if( prvFillTxFifo( &xHigherPriorityTaskWoken ) == ( size_t ) 0 )
 				{
-					U1THR = txBuffer[txDataSizeToSend - txDataSizeLeftToSend--];
+					xTxIdle = pdTRUE;
 				}
 				
 				break;
@@ -223,6 +339,10 @@ unsigned char ucInterrupt;
 
 	/* Clear the ISR in the VIC. */
 	VICVectAddr = serCLEAR_VIC_INTERRUPT;
+
+	/* Exit the ISR.  If a task was waiting for space in the stream buffer
+	then a context switch will occur. */
+	portEXIT_SWITCHING_ISR( xHigherPriorityTaskWoken );
 }
 /*-----------------------------------------------------------*/
 
@@ -0,0 +1,228 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "cbs.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the constant bandwidth server functionality. */
+#if ( configUSE_EDF_CBS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use the constant bandwidth server.
+    #endif
+
+/* An aperiodic job as held in the job queue of a server. */
+    typedef struct CBSJobParameters
+    {
+        CBSJobFunction_t pxJobFunction; /*<< The function that implements the job. */
+        void * pvParameter;             /*<< The value passed into the job function. */
+    } CBSJob_t;
+
+/* The definition of a server.  The budget and deadline of the server are held
+ * in the TCB of the server task, where the scheduler can charge and postpone
+ * them. */
+    typedef struct CBSServerDefinition
+    {
+        QueueHandle_t xJobQueue; /*<< Jobs posted to the server and not yet started. */
+        TaskHandle_t xTask;      /*<< The task that runs the jobs. */
+    } CBSServer_t;
+
+/*
+ * The task that runs the jobs posted to a server.
+ */
+    static portTASK_FUNCTION_PROTO( prvCBSServerTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCBSServerCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                 const configSTACK_DEPTH_TYPE usStackDepth,
+                                 UBaseType_t uxPriority,
+                                 TickType_t xBudget,
+                                 TickType_t xPeriod,
+                                 UBaseType_t uxQueueLength,
+                                 CBSServerHandle_t * const pxCreatedServer )
+    {
+        CBSServer_t * pxNewServer;
+        PeriodicTaskParameters_t xTaskDefinition;
+        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+        configASSERT( xBudget > ( TickType_t ) 0U );
+        configASSERT( xBudget <= xPeriod );
+        configASSERT( uxQueueLength > ( UBaseType_t ) 0U );
+
+        pxNewServer = ( CBSServer_t * ) pvPortMalloc( sizeof( CBSServer_t ) );
+
+        if( pxNewServer != NULL )
+        {
+            pxNewServer->xJobQueue = xQueueCreate( uxQueueLength, ( UBaseType_t ) sizeof( CBSJob_t ) );
+
+            if( pxNewServer->xJobQueue != NULL )
+            {
+                /* The server is admitted as a periodic task that executes for
+                 * at most its budget each period. */
+                xTaskDefinition.pvTaskCode = prvCBSServerTask;
+                xTaskDefinition.pcName = pcName;
+                xTaskDefinition.usStackDepth = usStackDepth;
+                xTaskDefinition.pvParameters = ( void * ) pxNewServer;
+                xTaskDefinition.uxPriority = uxPriority;
+                xTaskDefinition.xPeriod = xPeriod;
+                xTaskDefinition.xRelativeDeadline = xPeriod;
+                xTaskDefinition.xWcet = xBudget;
+                xTaskDefinition.xReleaseOffset = ( TickType_t ) 0U;
+
+                xReturn = xTaskPeriodicCreateExtended( &xTaskDefinition, &( pxNewServer->xTask ) );
+
+                if( xReturn == pdPASS )
+                {
+                    vTaskCBSInitialise( pxNewServer->xTask, xBudget );
+                }
+                else
+                {
+                    vQueueDelete( pxNewServer->xJobQueue );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xReturn != pdPASS )
+            {
+                vPortFree( pxNewServer );
+                pxNewServer = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxCreatedServer != NULL )
+        {
+            *pxCreatedServer = pxNewServer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCBSServerPostJob( CBSServerHandle_t xServer,
+                                  CBSJobFunction_t pxJobFunction,
+                                  void * pvParameter,
+                                  TickType_t xTicksToWait )
+    {
+        CBSJob_t xJob;
+
+        configASSERT( xServer );
+        configASSERT( pxJobFunction );
+
+        xJob.pxJobFunction = pxJobFunction;
+        xJob.pvParameter = pvParameter;
+
+        /* If the server is idle this unblocks it, at which point the scheduler
+         * applies the CBS job arrival rule. */
+        return xQueueSendToBack( xServer->xJobQueue, &xJob, xTicksToWait );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCBSServerPostJobFromISR( CBSServerHandle_t xServer,
+                                         CBSJobFunction_t pxJobFunction,
+                                         void * pvParameter,
+                                         BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        CBSJob_t xJob;
+
+        configASSERT( xServer );
+        configASSERT( pxJobFunction );
+
+        xJob.pxJobFunction = pxJobFunction;
+        xJob.pvParameter = pvParameter;
+
+        return xQueueSendToBackFromISR( xServer->xJobQueue, &xJob, pxHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xCBSServerGetTaskHandle( CBSServerHandle_t xServer )
+    {
+        configASSERT( xServer );
+        return xServer->xTask;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvCBSServerTask, pvParameters )
+    {
+        CBSServer_t * const pxServer = ( CBSServer_t * ) pvParameters;
+        CBSJob_t xJob;
+
+        for( ; ; )
+        {
+            /* The server is idle from the moment it looks for a job with none
+             * queued until a job is posted, which applies the arrival rule as
+             * the server is unblocked.  A job that is already queued is run
+             * with the current deadline and budget. */
+            vTaskCBSSetServerIdle( pdTRUE );
+
+            if( xQueueReceive( pxServer->xJobQueue, &xJob, portMAX_DELAY ) != pdFALSE )
+            {
+                vTaskCBSSetServerIdle( pdFALSE );
+                xJob.pxJobFunction( xJob.pvParameter );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_EDF_CBS == 1 */
@@ -74,6 +74,43 @@
     #include <reent.h>
 #endif
 
+/* The ways configTRACE_RECORDER_MODE can keep the trace once the buffer is
+ * full. */
+#define tskTRACE_SNAPSHOT    0 /* Overwrite the oldest events, so the buffer always holds the latest history. */
+#define tskTRACE_STREAM      1 /* Drop new events until xTraceRecorderRead() makes room, counting what was lost. */
+
+/* Must be defaulted before the trace macros below, which the trace recorder
+ * replaces. */
+#ifndef configUSE_TRACE_RECORDER
+
+/* Defaults to 0.  Set to 1 to record the kernel trace events as compact
+ * binary records in a RAM buffer, see trace_recorder.h. */
+    #define configUSE_TRACE_RECORDER    0
+#endif
+
+#ifndef configTRACE_RECORDER_BUFFER_SIZE
+    #define configTRACE_RECORDER_BUFFER_SIZE    2048
+#endif
+
+#ifndef configTRACE_RECORDER_MODE
+    #define configTRACE_RECORDER_MODE    tskTRACE_SNAPSHOT
+#endif
+
+#ifndef configTRACE_RECORDER_TIMESTAMP
+
+/* The time each event is recorded at.  Only the difference between two
+ * readings is used, so the counter may wrap. */
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #define configTRACE_RECORDER_TIMESTAMP()    ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+    #else
+        #define configTRACE_RECORDER_TIMESTAMP()    ( ( uint32_t ) xTaskGetTickCountFromISR() )
+    #endif
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+    #include "trace_recorder.h"
+#endif
+
 /*
  * Check all the required application specific macros have been defined.
  * These macros are application specific and (as downloaded) are defined
@@ -564,6 +601,18 @@
     #define traceTASK_DELAY_UNTIL( x )
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB, xLateness )
+#endif
+
+#ifndef traceTASK_BUDGET_OVERRUN
+    #define traceTASK_BUDGET_OVERRUN( pxTCB, ulExecutionTime )
+#endif
+
+#ifndef traceTASK_SLOT_OVERRUN
+    #define traceTASK_SLOT_OVERRUN( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY
     #define traceTASK_DELAY()
 #endif
@@ -886,6 +935,170 @@
     #define configUSE_POSIX_ERRNO    0
 #endif
 
+#ifndef configUSE_EDF_SCHEDULER
+    #define configUSE_EDF_SCHEDULER    0
+#endif
+
+/* The orders configFP_PRIORITY_POLICY can rank the periodic tasks in. */
+#define tskPRIORITY_RATE_MONOTONIC        0 /* The shorter the period, the higher the priority. */
+#define tskPRIORITY_DEADLINE_MONOTONIC    1 /* The shorter the relative deadline, the higher the priority. */
+
+#ifndef configUSE_FP_PRIORITY_ASSIGNMENT
+
+/* Defaults to 0.  Set to 1, with configUSE_EDF_SCHEDULER set to 0, to include
+ * xTaskPeriodicCreate() in the fixed priority scheduler.  The priorities of the
+ * periodic tasks are then assigned from their rank in configFP_PRIORITY_POLICY
+ * order instead of being passed in, see eTaskTestFixedPriorityTaskSet(). */
+    #define configUSE_FP_PRIORITY_ASSIGNMENT    0
+#endif
+
+#ifndef configFP_PRIORITY_POLICY
+    #define configFP_PRIORITY_POLICY    tskPRIORITY_RATE_MONOTONIC
+#endif
+
+#ifndef configFP_HIGHEST_PERIODIC_PRIORITY
+
+/* The priority given to the highest ranked periodic task, the others are
+ * ranked down from it to the priority above the idle priority.  Lower it to
+ * keep the priorities above it free for the timer task and for tasks deferred
+ * from interrupts. */
+    #define configFP_HIGHEST_PERIODIC_PRIORITY    ( configMAX_PRIORITIES - 1 )
+#endif
+
+/* Periodic tasks are scheduled by deadline under EDF, or by the priority
+ * assigned from their timing when configUSE_FP_PRIORITY_ASSIGNMENT is 1. */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) || ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 ) )
+    #define tskPERIODIC_TASKS_SUPPORTED    1
+#else
+    #define tskPERIODIC_TASKS_SUPPORTED    0
+#endif
+
+#ifndef configUSE_TIME_TRIGGERED_SCHEDULER
+
+/* Defaults to 0.  Set to 1 to dispatch the tasks named in a schedule table
+ * from the tick interrupt, see xTaskSetTimeTriggeredSchedule().  The time the
+ * table leaves free is shared by priority. */
+    #define configUSE_TIME_TRIGGERED_SCHEDULER    0
+#endif
+
+#ifndef configEDF_USE_READY_HEAP
+
+/* Defaults to 0, in which case the EDF ready tasks are held in a list sorted
+ * by deadline.  Set to 1 to hold them in a binary heap instead, which makes
+ * adding a task to the Ready state O(log n) rather than O(n).
+ * Project/Tools/kernel_sim/ready_queue_bench.c measures both.  The heap has
+ * room for configEDF_READY_HEAP_LENGTH tasks besides the idle task, creating a
+ * task once that many exist fails with errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY. */
+    #define configEDF_USE_READY_HEAP    0
+#endif
+
+#ifndef configUSE_EDF_PRIORITY_BANDS
+
+/* Defaults to 0, in which case every task above the idle priority is scheduled
+ * by deadline whatever its priority.  Set to 1 to schedule the priorities by
+ * fixed priority instead, as without EDF, with the Ready tasks of each priority
+ * whose bit is set in configEDF_BAND_MASK ordered by deadline and those of the
+ * other priorities taking turns.  A task then only preempts a task of a lower
+ * priority, or one with a later deadline in the same EDF band. */
+    #define configUSE_EDF_PRIORITY_BANDS    0
+#endif
+
+#ifndef configUSE_EDF_ADMISSION_CONTROL
+
+/* Defaults to 0.  Set to 1 to run a schedulability test when a periodic task
+ * is created, and refuse the task if the task set would no longer be
+ * schedulable under EDF. */
+    #define configUSE_EDF_ADMISSION_CONTROL    0
+#endif
+
+#ifndef configEDF_MAX_DEMAND_INTERVAL
+
+/* Defaults to 10000.  The longest interval, in ticks, over which the admission
+ * test checks the processor demand of a task set with constrained deadlines.
+ * A task set that cannot be shown schedulable within it is refused, which
+ * bounds the time the test runs with the scheduler suspended. */
+    #define configEDF_MAX_DEMAND_INTERVAL    10000
+#endif
+
+#ifndef configUSE_EDF_CBS
+
+/* Defaults to 0.  Set to 1 to include the constant bandwidth server in cbs.c,
+ * which runs aperiodic jobs under EDF within a reserved budget. */
+    #define configUSE_EDF_CBS    0
+#endif
+
+#ifndef configUSE_EDF_SPORADIC_TASKS
+
+/* Defaults to 0.  Set to 1 to include xTaskSporadicCreate() and the functions
+ * that release the jobs of a sporadic task. */
+    #define configUSE_EDF_SPORADIC_TASKS    0
+#endif
+
+#ifndef configEDF_SPORADIC_QUEUE_LENGTH
+
+/* Defaults to 4.  The number of release requests a sporadic task can have
+ * pending, each with the time it arrived, while it is still busy with an
+ * earlier job. */
+    #define configEDF_SPORADIC_QUEUE_LENGTH    4
+#endif
+
+/* The actions configEDF_OVERRUN_POLICY can select for a job that executes for
+ * longer than its budget. */
+#define tskOVERRUN_NOTIFY      0 /* Only count the overrun and call the trace macro and hook. */
+#define tskOVERRUN_DEMOTE      1 /* Run the rest of the job in the background, with the idle priority tasks. */
+#define tskOVERRUN_THROTTLE    2 /* Suspend the job until the next release of the task. */
+
+#ifndef configUSE_EDF_BUDGET_ENFORCEMENT
+
+/* Defaults to 0.  Set to 1 to charge the run time of each job against the
+ * budget of its task at every context switch, and to apply
+ * configEDF_OVERRUN_POLICY to a job that exceeds it. */
+    #define configUSE_EDF_BUDGET_ENFORCEMENT    0
+#endif
+
+#ifndef configEDF_OVERRUN_POLICY
+    #define configEDF_OVERRUN_POLICY    tskOVERRUN_NOTIFY
+#endif
+
+#ifndef configEDF_RUN_TIME_COUNTS_PER_TICK
+
+/* The number of run time counter increments in one tick period, used to
+ * convert the WCET given to xTaskPeriodicCreate() into a default budget. */
+    #define configEDF_RUN_TIME_COUNTS_PER_TICK    1
+#endif
+
+#ifndef configUSE_BUDGET_OVERRUN_HOOK
+    #define configUSE_BUDGET_OVERRUN_HOOK    0
+#endif
+
+#ifndef configUSE_EDF_JOB_STATISTICS
+
+/* Defaults to 0.  Set to 1 to record the release, start, completion and
+ * deadline of each job and keep the response time and start jitter of each
+ * periodic or sporadic task, see vTaskGetJobStats(). */
+    #define configUSE_EDF_JOB_STATISTICS    0
+#endif
+
+#ifndef configUSE_EDF_MODE_CHANGES
+
+/* Defaults to 0.  Set to 1 to change the periods, deadlines and execution times
+ * of a set of periodic tasks, or disable some of them, at the end of their
+ * current jobs, see xTaskChangeMode(). */
+    #define configUSE_EDF_MODE_CHANGES    0
+#endif
+
+#ifndef configUSE_DEADLINE_MISS_HOOK
+    #define configUSE_DEADLINE_MISS_HOOK    0
+#endif
+
+#ifndef configEDF_CHECK_DEADLINES_ON_TICK
+
+/* Defaults to 0, in which case a deadline miss is only detected when the late
+ * job completes.  Set to 1 to also check the earliest deadline from the tick
+ * interrupt so a miss is reported while the late job is still Ready. */
+    #define configEDF_CHECK_DEADLINES_ON_TICK    0
+#endif
+
 #ifndef portTICK_TYPE_IS_ATOMIC
     #define portTICK_TYPE_IS_ATOMIC    0
 #endif
@@ -938,6 +1151,100 @@
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if ( configEDF_USE_READY_HEAP == 1 )
+    #if ( configUSE_EDF_SCHEDULER != 1 )
+        #error configUSE_EDF_SCHEDULER must be set to 1 to use the EDF ready heap
+    #endif
+
+    #ifndef configEDF_READY_HEAP_LENGTH
+        #error configEDF_READY_HEAP_LENGTH must be set to the maximum number of tasks, other than the idle task, that can exist at once when configEDF_USE_READY_HEAP is 1
+    #endif
+#endif
+
+#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+    #if ( configUSE_EDF_SCHEDULER != 1 )
+        #error configUSE_EDF_SCHEDULER must be set to 1 to use priority bands
+    #endif
+
+    #ifndef configEDF_BAND_MASK
+        #error configEDF_BAND_MASK must set bit n for each priority n that is scheduled by EDF when configUSE_EDF_PRIORITY_BANDS is 1
+    #endif
+
+    #if ( ( configEDF_BAND_MASK & 1 ) != 0 )
+        #error The idle priority cannot be an EDF band, it holds the background tasks
+    #endif
+
+    #if ( configEDF_USE_READY_HEAP == 1 )
+        #error configEDF_USE_READY_HEAP must be 0 when configUSE_EDF_PRIORITY_BANDS is 1, each band keeps its own ready list sorted by deadline
+    #endif
+#endif
+
+#if ( ( configEDF_CHECK_DEADLINES_ON_TICK == 1 ) || ( configUSE_EDF_ADMISSION_CONTROL == 1 ) || ( configUSE_EDF_CBS == 1 ) || ( configUSE_EDF_SPORADIC_TASKS == 1 ) || ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 ) || ( configUSE_EDF_JOB_STATISTICS == 1 ) || ( configUSE_EDF_MODE_CHANGES == 1 ) )
+    #if ( configUSE_EDF_SCHEDULER != 1 )
+        #error configUSE_EDF_SCHEDULER must be set to 1 to use deadline checks from the tick, admission control, the constant bandwidth server, sporadic tasks, budget enforcement, job statistics or mode changes
+    #endif
+#endif
+
+#if ( ( configUSE_EDF_SPORADIC_TASKS == 1 ) && ( configEDF_SPORADIC_QUEUE_LENGTH < 1 ) )
+    #error configEDF_SPORADIC_QUEUE_LENGTH must be at least 1
+#endif
+
+#if ( ( configUSE_DEADLINE_MISS_HOOK == 1 ) && ( tskPERIODIC_TASKS_SUPPORTED != 1 ) )
+    #error configUSE_EDF_SCHEDULER or configUSE_FP_PRIORITY_ASSIGNMENT must be set to 1 to use the deadline miss hook
+#endif
+
+#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+    #if ( ( configUSE_EDF_SCHEDULER != 0 ) || ( configUSE_TIME_TRIGGERED_SCHEDULER != 0 ) )
+        #error configUSE_FP_PRIORITY_ASSIGNMENT can only be set to 1 when configUSE_EDF_SCHEDULER and configUSE_TIME_TRIGGERED_SCHEDULER are 0
+    #endif
+
+    #if ( ( configFP_PRIORITY_POLICY != tskPRIORITY_RATE_MONOTONIC ) && ( configFP_PRIORITY_POLICY != tskPRIORITY_DEADLINE_MONOTONIC ) )
+        #error configFP_PRIORITY_POLICY must be set to tskPRIORITY_RATE_MONOTONIC or tskPRIORITY_DEADLINE_MONOTONIC
+    #endif
+
+    #if ( ( configFP_HIGHEST_PERIODIC_PRIORITY < 1 ) || ( configFP_HIGHEST_PERIODIC_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configFP_HIGHEST_PERIODIC_PRIORITY must be above the idle priority and below configMAX_PRIORITIES
+    #endif
+#endif
+
+#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+    #if ( configGENERATE_RUN_TIME_STATS != 1 )
+        #error configGENERATE_RUN_TIME_STATS must be set to 1 to use budget enforcement, as jobs are charged with the run time stats clock
+    #endif
+
+    #if ( ( configEDF_OVERRUN_POLICY != tskOVERRUN_NOTIFY ) && ( configEDF_OVERRUN_POLICY != tskOVERRUN_DEMOTE ) && ( configEDF_OVERRUN_POLICY != tskOVERRUN_THROTTLE ) )
+        #error configEDF_OVERRUN_POLICY must be set to tskOVERRUN_NOTIFY, tskOVERRUN_DEMOTE or tskOVERRUN_THROTTLE
+    #endif
+#endif
+
+#if ( ( configUSE_BUDGET_OVERRUN_HOOK == 1 ) && ( configUSE_EDF_BUDGET_ENFORCEMENT != 1 ) )
+    #error configUSE_EDF_BUDGET_ENFORCEMENT must be set to 1 to use the budget overrun hook
+#endif
+
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+    #if ( configUSE_EDF_SCHEDULER != 0 )
+        #error configUSE_EDF_SCHEDULER and configUSE_TIME_TRIGGERED_SCHEDULER cannot both be 1
+    #endif
+
+    #if ( configUSE_PREEMPTION != 1 )
+        #error configUSE_PREEMPTION must be set to 1 to use the time-triggered scheduler, as every slot boundary preempts the running task
+    #endif
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+    #if ( configUSE_TRACE_FACILITY != 1 )
+        #error configUSE_TRACE_FACILITY must be set to 1 to use the trace recorder, events identify tasks and queues by their trace numbers
+    #endif
+
+    #if ( configTRACE_RECORDER_BUFFER_SIZE < 64 )
+        #error configTRACE_RECORDER_BUFFER_SIZE must be at least 64 bytes
+    #endif
+
+    #if ( ( configTRACE_RECORDER_MODE != tskTRACE_SNAPSHOT ) && ( configTRACE_RECORDER_MODE != tskTRACE_STREAM ) )
+        #error configTRACE_RECORDER_MODE must be set to tskTRACE_SNAPSHOT or tskTRACE_STREAM
+    #endif
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
     #define configINITIAL_TICK_COUNT    0
 #endif
@@ -1188,6 +1495,51 @@ typedef struct xSTATIC_TCB
     UBaseType_t uxDummy5;
     void * pxDummy6;
     uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        TickType_t xDummy23[ 8 ];
+        UBaseType_t uxDummy25[ 2 ];
+        uint8_t ucDummy26[ 2 ];
+        #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+            uint32_t ulDummy27[ 2 ];
+            void * pvDummy28;
+        #endif
+        #if ( configUSE_EDF_CBS == 1 )
+            TickType_t xDummy29[ 2 ];
+            uint8_t ucDummy30;
+        #endif
+        #if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+            TickType_t xDummy33[ 1 + configEDF_SPORADIC_QUEUE_LENGTH ];
+            UBaseType_t uxDummy34[ 3 ];
+            uint8_t ucDummy35[ 2 ];
+        #endif
+        #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+            configRUN_TIME_COUNTER_TYPE ulDummy36[ 2 ];
+            UBaseType_t uxDummy37;
+            uint8_t ucDummy38;
+        #endif
+        #if ( configUSE_EDF_JOB_STATISTICS == 1 )
+            UBaseType_t uxDummy39;
+            TickType_t xDummy40[ 6 ];
+            uint32_t ulDummy41;
+            TickType_t xDummy42[ 3 ];
+            uint8_t ucDummy43;
+        #endif
+        #if ( configUSE_EDF_MODE_CHANGES == 1 )
+            TickType_t xDummy46[ 3 ];
+            uint8_t ucDummy48[ 3 ];
+        #endif
+        #if ( configUSE_MUTEXES == 1 )
+            TickType_t xDummy31;
+            uint8_t ucDummy32;
+        #endif
+        #if ( configEDF_USE_READY_HEAP == 1 )
+            UBaseType_t uxDummy24[ 2 ];
+        #endif
+    #endif
+    #if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+        UBaseType_t uxDummy44;
+        uint8_t ucDummy45[ 3 ];
+    #endif
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         void * pxDummy8;
     #endif
@@ -0,0 +1,239 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef CBS_H
+#define CBS_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include cbs.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+ * happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/**
+ * Type by which constant bandwidth servers are referenced.  For example, a
+ * call to xCBSServerCreate() passes back a CBSServerHandle_t variable that can
+ * then be used as a parameter to xCBSServerPostJob() to queue an aperiodic job
+ * to the server.
+ */
+struct CBSServerDefinition;
+typedef struct CBSServerDefinition * CBSServerHandle_t;
+
+/*
+ * Defines the prototype to which aperiodic job functions must conform.
+ */
+typedef void (* CBSJobFunction_t)( void * pvParameter );
+
+/*-----------------------------------------------------------
+* SERVER API
+*----------------------------------------------------------*/
+
+/**
+ * cbs.h
+ * @code{c}
+ * BaseType_t xCBSServerCreate( const char * const pcName,
+ *                              const configSTACK_DEPTH_TYPE usStackDepth,
+ *                              UBaseType_t uxPriority,
+ *                              TickType_t xBudget,
+ *                              TickType_t xPeriod,
+ *                              UBaseType_t uxQueueLength,
+ *                              CBSServerHandle_t * const pxCreatedServer );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_CBS is set to 1.
+ *
+ * Create a constant bandwidth server (CBS) that runs aperiodic jobs under the
+ * EDF scheduler.  The server is a task that executes the jobs queued to it one
+ * after the other, in the order they were posted.  The server is allowed to
+ * execute for xBudget ticks with a given deadline.  Each time the budget is
+ * exhausted it is recharged and the deadline of the server is postponed by
+ * xPeriod ticks.  The aperiodic jobs can therefore never take more than
+ * xBudget / xPeriod of the processor away from the periodic tasks, however
+ * many jobs are posted.
+ *
+ * When a job arrives while the server is idle the server is given the
+ * deadline now + xPeriod and a full budget, unless the deadline and budget it
+ * already has can be kept without exceeding its bandwidth.
+ *
+ * With configUSE_EDF_ADMISSION_CONTROL set to 1 the server is admitted as a
+ * periodic task with a worst case execution time of xBudget.
+ *
+ * @param pcName A descriptive name for the server task.
+ *
+ * @param usStackDepth The size of the server task stack, in words.  The job
+ * functions execute on this stack.
+ *
+ * @param uxPriority The priority at which the server task should run.
+ *
+ * @param xBudget The execution time available to the server per period, in
+ * ticks.  Must be greater than 0 and not greater than xPeriod.
+ *
+ * @param xPeriod The server period, in ticks.
+ *
+ * @param uxQueueLength The maximum number of jobs that can be waiting to be
+ * run by the server at any one time.
+ *
+ * @param pxCreatedServer Used to pass back a handle by which the created
+ * server can be referenced.
+ *
+ * @return pdPASS if the server was created, errTASK_NOT_SCHEDULABLE if the
+ * server task was refused by the admission test, otherwise an error code
+ * defined in the file projdefs.h
+ *
+ * Example usage:
+ * @code{c}
+ * CBSServerHandle_t xSirenServer;
+ *
+ * void vSirenJob( void * pvParameter )
+ * {
+ *  // Drive the siren for the alarm passed in pvParameter.
+ * }
+ *
+ * void vAlarmISR( void )
+ * {
+ *  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  xCBSServerPostJobFromISR( xSirenServer, vSirenJob, NULL, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vSetup( void )
+ * {
+ *  // Up to 10 ticks of siren work every 100 ticks.
+ *  xCBSServerCreate( "Siren", 200, 1, 10, 100, 4, &xSirenServer );
+ * }
+ * @endcode
+ * \defgroup xCBSServerCreate xCBSServerCreate
+ * \ingroup CBS
+ */
+BaseType_t xCBSServerCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                             const configSTACK_DEPTH_TYPE usStackDepth,
+                             UBaseType_t uxPriority,
+                             TickType_t xBudget,
+                             TickType_t xPeriod,
+                             UBaseType_t uxQueueLength,
+                             CBSServerHandle_t * const pxCreatedServer ) PRIVILEGED_FUNCTION;
+
+/**
+ * cbs.h
+ * @code{c}
+ * BaseType_t xCBSServerPostJob( CBSServerHandle_t xServer,
+ *                               CBSJobFunction_t pxJobFunction,
+ *                               void * pvParameter,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Queue an aperiodic job to a constant bandwidth server.  The server calls
+ * pxJobFunction( pvParameter ) once all the jobs posted before it have
+ * completed.
+ *
+ * @param xServer The server that will run the job.
+ *
+ * @param pxJobFunction The function that implements the job.
+ *
+ * @param pvParameter The value passed into pxJobFunction.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state for space to become available on the job queue,
+ * should the queue already be full.
+ *
+ * @return pdPASS if the job was queued, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xCBSServerPostJob xCBSServerPostJob
+ * \ingroup CBS
+ */
+BaseType_t xCBSServerPostJob( CBSServerHandle_t xServer,
+                              CBSJobFunction_t pxJobFunction,
+                              void * pvParameter,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * cbs.h
+ * @code{c}
+ * BaseType_t xCBSServerPostJobFromISR( CBSServerHandle_t xServer,
+ *                                      CBSJobFunction_t pxJobFunction,
+ *                                      void * pvParameter,
+ *                                      BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xCBSServerPostJob() that can be called from an interrupt
+ * service routine.
+ *
+ * @param xServer The server that will run the job.
+ *
+ * @param pxJobFunction The function that implements the job.
+ *
+ * @param pvParameter The value passed into pxJobFunction.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the job unblocked
+ * the server task and a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * @return pdPASS if the job was queued, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xCBSServerPostJobFromISR xCBSServerPostJobFromISR
+ * \ingroup CBS
+ */
+BaseType_t xCBSServerPostJobFromISR( CBSServerHandle_t xServer,
+                                     CBSJobFunction_t pxJobFunction,
+                                     void * pvParameter,
+                                     BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * cbs.h
+ * @code{c}
+ * TaskHandle_t xCBSServerGetTaskHandle( CBSServerHandle_t xServer );
+ * @endcode
+ *
+ * Returns the handle of the task that runs the jobs of xServer, for example
+ * to read its run time or deadline miss count with uxTaskGetSystemState().
+ *
+ * \defgroup xCBSServerGetTaskHandle xCBSServerGetTaskHandle
+ * \ingroup CBS
+ */
+TaskHandle_t xCBSServerGetTaskHandle( CBSServerHandle_t xServer ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* CBS_H */
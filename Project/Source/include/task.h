@@ -149,6 +149,89 @@ typedef struct xTASK_PARAMETERS
     #endif
 } TaskParameters_t;
 
+/*
+ * Parameters required to create a periodic task.
+ */
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
+    typedef struct xPERIODIC_TASK_PARAMETERS
+    {
+        TaskFunction_t pvTaskCode;
+        const char * pcName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        configSTACK_DEPTH_TYPE usStackDepth;
+        void * pvParameters;
+        UBaseType_t uxPriority;
+        TickType_t xPeriod;           /* Time between the releases of consecutive jobs, in ticks. */
+        TickType_t xRelativeDeadline; /* Deadline of each job relative to its release, in ticks.  0 means the deadline is equal to xPeriod. */
+        TickType_t xWcet;             /* Worst case execution time of each job, in ticks.  Used by the admission test, 0 means the task is not accounted for. */
+        TickType_t xReleaseOffset;    /* Time from the creation of the task to the release of its first job, in ticks. */
+    } PeriodicTaskParameters_t;
+
+/* Used with the xTaskWaitForNextPeriod() function to return the job that has
+ * just been released. */
+    typedef struct xPERIODIC_JOB
+    {
+        UBaseType_t uxJobIndex;  /* The number of jobs the task released before this one, 0 for the first job. */
+        TickType_t xReleaseTime; /* The tick at which the job was released. */
+        TickType_t xDeadline;    /* The absolute deadline of the job. */
+    } PeriodicJob_t;
+#endif
+
+/*
+ * The new parameters of one periodic task, passed to xTaskChangeMode().
+ */
+#if ( configUSE_EDF_MODE_CHANGES == 1 )
+    typedef struct xMODE_TASK_PARAMETERS
+    {
+        TaskHandle_t xTask;           /* The periodic task to change. */
+        TickType_t xPeriod;           /* Time between the releases of consecutive jobs in the new mode, in ticks.  0 disables the task. */
+        TickType_t xRelativeDeadline; /* Deadline of each job relative to its release in the new mode, in ticks.  0 means the deadline is equal to xPeriod. */
+        TickType_t xWcet;             /* Worst case execution time of each job in the new mode, in ticks.  0 means the task is not accounted for. */
+    } ModeTaskParameters_t;
+#endif
+
+/*
+ * The schedule table followed by the time-triggered scheduler.  The table
+ * covers one hyperperiod, which then repeats.  Each slot gives the processor
+ * to one task from its start time until the start time of the next slot.
+ */
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+
+/* The task index of a slot in which no task of the table runs. */
+    #define tskTT_IDLE_SLOT    ( ( uint8_t ) 0xFFU )
+
+    typedef struct xTIME_TRIGGERED_SLOT
+    {
+        TickType_t xStartTime; /* Start of the slot relative to the start of the hyperperiod, in ticks. */
+        uint8_t ucTask;        /* Index of the task that owns the slot, or tskTT_IDLE_SLOT. */
+        uint8_t ucRelease;     /* pdTRUE if the slot releases a new job of the task, pdFALSE if it continues the last one. */
+    } TimeTriggeredSlot_t;
+
+    typedef struct xTIME_TRIGGERED_SCHEDULE
+    {
+        const TimeTriggeredSlot_t * pxSlots; /* The slots in order of start time, the first starting at 0. */
+        UBaseType_t uxNumberOfSlots;         /* The number of entries in pxSlots. */
+        TickType_t xHyperperiod;             /* The length of the table, in ticks. */
+    } TimeTriggeredSchedule_t;
+#endif
+
+/* Used within the TaskStatus_t structure to return the timing of the jobs a
+ * periodic or sporadic task has completed, all times in ticks.  The response
+ * time of a job runs from its release to its completion, and its start delay
+ * from its release to the first time it ran. */
+typedef struct xTASK_JOB_STATISTICS
+{
+    UBaseType_t uxJobsCompleted;  /* The number of jobs of the task that have completed. */
+    TickType_t xLastRelease;      /* The release time of the last job to complete. */
+    TickType_t xLastStart;        /* The tick at which the last job to complete first ran. */
+    TickType_t xLastCompletion;   /* The tick at which the last job completed. */
+    TickType_t xLastDeadline;     /* The absolute deadline of the last job to complete. */
+    TickType_t xMinResponseTime;  /* The shortest response time of a job, portMAX_DELAY until a job completes. */
+    TickType_t xMaxResponseTime;  /* The longest response time of a job. */
+    uint32_t ulTotalResponseTime; /* The sum of the response times, divide by uxJobsCompleted for the mean. */
+    TickType_t xMinStartDelay;    /* The shortest start delay of a job, portMAX_DELAY until a job completes. */
+    TickType_t xMaxStartDelay;    /* The longest start delay of a job, less xMinStartDelay it is the start jitter of the task. */
+} TaskJobStatistics_t;
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
  * in the system. */
 typedef struct xTASK_STATUS
@@ -162,8 +245,30 @@ typedef struct xTASK_STATUS
     configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /* The total run time allocated to the task so far, as defined by the run time stats clock.  See https://www.FreeRTOS.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
     StackType_t * pxStackBase;                    /* Points to the lowest address of the task's stack area. */
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+    UBaseType_t uxDeadlineMisses;                 /* The number of jobs of the task that missed their absolute deadline.  Only valid if configUSE_EDF_SCHEDULER or configUSE_FP_PRIORITY_ASSIGNMENT is defined as 1 in FreeRTOSConfig.h. */
+    TickType_t xMaxLateness;                      /* The largest number of ticks by which a job of the task completed after its absolute deadline.  Only valid if configUSE_EDF_SCHEDULER or configUSE_FP_PRIORITY_ASSIGNMENT is defined as 1 in FreeRTOSConfig.h. */
+    UBaseType_t uxSeparationViolations;           /* The number of releases of a sporadic task that came before its minimum inter-arrival time had elapsed.  Only valid if configUSE_EDF_SPORADIC_TASKS is defined as 1 in FreeRTOSConfig.h. */
+    UBaseType_t uxBudgetOverruns;                 /* The number of jobs of the task that executed for longer than its budget.  Only valid if configUSE_EDF_BUDGET_ENFORCEMENT is defined as 1 in FreeRTOSConfig.h. */
+    TaskJobStatistics_t xJobStatistics;           /* The response time, start delay and timing of the last completed job of the task.  Only valid if configUSE_EDF_JOB_STATISTICS is defined as 1 in FreeRTOSConfig.h. */
+    UBaseType_t uxSlotOverruns;                   /* The number of jobs of the task that were still running when the schedule table released the next one.  Only valid if configUSE_TIME_TRIGGERED_SCHEDULER is defined as 1 in FreeRTOSConfig.h. */
 } TaskStatus_t;
 
+/* The encodings uxTaskStreamStats() can write each task record in. */
+typedef enum
+{
+    eTaskStatsCSV = 0, /* One line of comma separated ASCII text per task, after a line naming the columns. */
+    eTaskStatsBinary   /* A length byte followed by the fields of the task as LEB128 varints and the name. */
+} eTaskStatsEncoding;
+
+/*
+ * Defines the prototype to which the sink passed to uxTaskStreamStats() must
+ * conform.  The sink is given one record at a time and returns pdFALSE to
+ * stop the stream.
+ */
+typedef BaseType_t (* TaskStatsSink_t)( const uint8_t * pucRecord,
+                                        size_t xLength,
+                                        void * pvContext );
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -172,6 +277,14 @@ typedef enum
     eNoTasksWaitingTimeout /* No tasks are waiting for a timeout so it is safe to enter a sleep mode that can only be exited by an external interrupt. */
 } eSleepModeStatus;
 
+/* Possible return values for eTaskTestFixedPriorityTaskSet(). */
+typedef enum
+{
+    eFixedPriorityBoundMet = 0,     /* The utilisation is within the Liu and Layland bound, so every deadline is met. */
+    eFixedPriorityResponseTimesMet, /* The bound does not apply or is exceeded, but every worst case response time is within its deadline. */
+    eFixedPriorityDeadlineMissed    /* The worst case response time of at least one task exceeds its deadline. */
+} eFixedPriorityTestResult;
+
 /**
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -179,6 +292,14 @@ typedef enum
  */
 #define tskIDLE_PRIORITY    ( ( UBaseType_t ) 0U )
 
+/**
+ * The processor utilisation values used by the EDF admission test are fixed
+ * point, tskUTILISATION_SCALE represents a fully loaded processor.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskUTILISATION_SCALE    ( ( uint32_t ) 0x10000UL )
+
 /**
  * task. h
  *
@@ -354,6 +475,175 @@ typedef enum
                             TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TaskHandle_t * const pxCreatedTask,
+ *                                 TickType_t period,
+ *                                 TickType_t wcet );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SCHEDULER or
+ * configUSE_FP_PRIORITY_ASSIGNMENT is set to 1.
+ *
+ * Create a new periodic task and add it to the list of tasks that are ready
+ * to run.  The parameters are those of xTaskCreate() plus the period and the
+ * worst case execution time of the task in ticks.  The EDF scheduler orders
+ * the jobs of the task by their absolute deadline, which for tasks created
+ * with this function is equal to the release time of the job plus the period
+ * (an implicit deadline).
+ *
+ * Deadlines are ordered by their distance from each other, so the order holds
+ * when the tick count wraps, provided the deadlines of the Ready jobs are less
+ * than half the range of TickType_t apart.
+ *
+ * If configUSE_EDF_ADMISSION_CONTROL is set to 1 the task is only created if
+ * the task set, including the new task, remains schedulable under EDF given
+ * the declared worst case execution times.
+ *
+ * If configUSE_FP_PRIORITY_ASSIGNMENT is set to 1 uxPriority is ignored.
+ * The periodic tasks are ranked by period, or by relative deadline, as set
+ * by configFP_PRIORITY_POLICY, and each is given the priority of its rank
+ * counting down from configFP_HIGHEST_PERIODIC_PRIORITY.  Tasks with the
+ * same period or deadline share a priority, as do the lowest ranked tasks
+ * once the priorities above the idle priority run out.  The priorities are
+ * assigned again whenever a periodic task is created or deleted.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, errTASK_NOT_SCHEDULABLE if the task was refused by the admission
+ * test, otherwise an error code defined in the file projdefs.h
+ *
+ * \defgroup xTaskPeriodicCreate xTaskPeriodicCreate
+ * \ingroup Tasks
+ */
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
+    BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t period,
+                                    TickType_t wcet ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskPeriodicCreateExtended( const PeriodicTaskParameters_t * const pxTaskDefinition, TaskHandle_t * const pxCreatedTask );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SCHEDULER or
+ * configUSE_FP_PRIORITY_ASSIGNMENT is set to 1.
+ *
+ * Create a new periodic task whose relative deadline can be shorter than its
+ * period (a constrained deadline).  The EDF scheduler orders the jobs of the
+ * task by their release time plus xRelativeDeadline, so a task can be given
+ * a tight deadline without shortening its period.  With
+ * configUSE_FP_PRIORITY_ASSIGNMENT set to 1 the priority is assigned as for
+ * xTaskPeriodicCreate(), and a deadline monotonic policy ranks the task by
+ * xRelativeDeadline.
+ *
+ * If configUSE_EDF_ADMISSION_CONTROL is set to 1 the task is only created if
+ * the task set remains schedulable.  While every task has an implicit deadline
+ * the test compares the total utilisation against the processor capacity,
+ * once a constrained deadline is involved a processor demand test is run over
+ * the synchronous busy period instead, or up to the bound La when that is
+ * shorter.  The task is refused if neither falls within
+ * configEDF_MAX_DEMAND_INTERVAL ticks.
+ *
+ * The first job of the task is released xReleaseOffset ticks after the task
+ * is created, later jobs are released every xPeriod ticks from then on.  The
+ * release times are only enforced for a task that waits for its jobs with
+ * xTaskWaitForNextPeriod().
+ *
+ * @param pxTaskDefinition Pointer to a structure that contains a member for
+ * each of the xTaskPeriodicCreate() parameters plus the relative deadline
+ * and the release offset.
+ *
+ * @param pxCreatedTask Used to pass back a handle by which the created task
+ * can be referenced.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, errTASK_NOT_SCHEDULABLE if the task was refused by the admission
+ * test, otherwise an error code defined in the file projdefs.h
+ *
+ * Example usage:
+ * @code{c}
+ * static const PeriodicTaskParameters_t xUARTTaskParameters =
+ * {
+ *  vUARTTask,  // pvTaskCode - the function that implements the task.
+ *  "UART",     // pcName - just a text name for the task to assist debugging.
+ *  100,        // usStackDepth - the stack size DEFINED IN WORDS.
+ *  NULL,       // pvParameters - passed into the task function as the function parameters.
+ *  1,          // uxPriority - task priority.
+ *  100,        // xPeriod - a job is released every 100 ticks.
+ *  10,         // xRelativeDeadline - each job must complete within 10 ticks of its release.
+ *  4,          // xWcet - each job executes for at most 4 ticks.
+ *  20          // xReleaseOffset - the first job is released 20 ticks after the task is created.
+ * };
+ *
+ * xTaskPeriodicCreateExtended( &xUARTTaskParameters, NULL );
+ * @endcode
+ * \defgroup xTaskPeriodicCreateExtended xTaskPeriodicCreateExtended
+ * \ingroup Tasks
+ */
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
+    BaseType_t xTaskPeriodicCreateExtended( const PeriodicTaskParameters_t * const pxTaskDefinition,
+                                            TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSporadicCreate( TaskFunction_t pxTaskCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TaskHandle_t * const pxCreatedTask,
+ *                                 TickType_t xMinInterArrival,
+ *                                 TickType_t xRelativeDeadline,
+ *                                 TickType_t xWcet );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SPORADIC_TASKS is set to 1.
+ *
+ * Create a new sporadic task.  Unlike a periodic task the jobs of a sporadic
+ * task are released by events, using xTaskReleaseSporadic() or
+ * xTaskReleaseSporadicFromISR(), that are separated by at least
+ * xMinInterArrival ticks.  Each job must complete within xRelativeDeadline
+ * ticks of its release, or of xMinInterArrival ticks if xRelativeDeadline is
+ * 0.  The task waits for each release with xTaskWaitForNextPeriod().
+ *
+ * If configUSE_EDF_ADMISSION_CONTROL is set to 1 the task is admitted as if it
+ * were a periodic task with a period of xMinInterArrival ticks, which bounds
+ * the processor demand of its jobs.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, errTASK_NOT_SCHEDULABLE if the task was refused by the admission
+ * test, otherwise an error code defined in the file projdefs.h
+ *
+ * \defgroup xTaskSporadicCreate xTaskSporadicCreate
+ * \ingroup Tasks
+ */
+#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+    BaseType_t xTaskSporadicCreate( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask,
+                                    TickType_t xMinInterArrival,
+                                    TickType_t xRelativeDeadline,
+                                    TickType_t xWcet ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -855,6 +1145,455 @@ void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
 BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
                             const TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskWaitForNextPeriod( PeriodicJob_t * const pxJob );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SCHEDULER or
+ * configUSE_FP_PRIORITY_ASSIGNMENT is set to 1.
+ *
+ * Wait for the next job of the calling periodic task to be released.  The
+ * kernel knows the period and release offset of the task, so unlike
+ * xTaskDelayUntil() no wake time has to be kept and initialised by the task.
+ *
+ * The function must be called at the start of each job.  The first call waits
+ * for the release of the first job, xReleaseOffset ticks after the task was
+ * created, each later call completes the current job and waits for the
+ * release of the next one.  A job that completes after its deadline is
+ * counted as a deadline miss.
+ *
+ * @param pxJob Used to pass out the index, release time and deadline of the
+ * job that has been released.  Can be NULL if the information is not
+ * required.
+ *
+ * For a sporadic task created with xTaskSporadicCreate() the call waits until
+ * the task is released by xTaskReleaseSporadic() or
+ * xTaskReleaseSporadicFromISR(), or returns straight away if a release is
+ * already pending.
+ *
+ * @return pdTRUE if the task had to wait for the release, pdFALSE if the
+ * release time had already passed, which means the previous job overran
+ * into the period of the new one.
+ *
+ * Example usage:
+ * @code{c}
+ * void vTaskFunction( void * pvParameters )
+ * {
+ * PeriodicJob_t xJob;
+ *
+ *   for( ;; )
+ *   {
+ *       xTaskWaitForNextPeriod( &xJob );
+ *
+ *       // Perform the job released at xJob.xReleaseTime here.
+ *   }
+ * }
+ * @endcode
+ * \defgroup xTaskWaitForNextPeriod xTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
+    BaseType_t xTaskWaitForNextPeriod( PeriodicJob_t * const pxJob ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSetPeriod( TaskHandle_t xTask, TickType_t xNewPeriod );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SCHEDULER is set to 1.
+ *
+ * Change the period of a periodic task, or the minimum inter-arrival time of a
+ * sporadic task, while it runs.  A task with an implicit deadline keeps a
+ * deadline equal to its new period.
+ *
+ * The current job keeps the deadline it was released with.  The new timing
+ * takes effect when the job completes: the next job is released one new
+ * period after the release of the current one, so the ready and delayed lists
+ * never hold a task under timing it was not queued with.  A task that is
+ * already waiting for its next release takes the new timing at the end of
+ * that job.  Calling the function again before the change is made
+ * replaces it.
+ *
+ * If configUSE_EDF_ADMISSION_CONTROL is set to 1 the task set, with the task
+ * at its new timing, must pass the admission test.  The utilisation accounted
+ * for the task is updated when the change is made, an increase is claimed
+ * straight away so the processor time cannot be given to another task in
+ * between.  Until the change is made the admission test refuses every other
+ * task and change of timing, as the test cannot account for a task under two
+ * deadlines.
+ *
+ * @param xTask The handle of the task.  Passing NULL changes the calling task.
+ *
+ * @param xNewPeriod The new period in ticks, which must not be 0.
+ *
+ * @return pdPASS if the change will be made, errTASK_NOT_SCHEDULABLE if it was
+ * refused by the admission test, pdFAIL if the task is changing to a new mode
+ * or is disabled by xTaskChangeMode().
+ *
+ * Example usage:
+ * @code{c}
+ * void vSampleTask( void * pvParameters )
+ * {
+ *   for( ;; )
+ *   {
+ *       xTaskWaitForNextPeriod( NULL );
+ *
+ *       // Sample faster while the signal changes quickly.
+ *       if( xSignalIsSettled() == pdFALSE )
+ *       {
+ *           xTaskSetPeriod( NULL, 10 );
+ *       }
+ *       else
+ *       {
+ *           xTaskSetPeriod( NULL, 100 );
+ *       }
+ *   }
+ * }
+ * @endcode
+ * \defgroup xTaskSetPeriod xTaskSetPeriod
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    BaseType_t xTaskSetPeriod( TaskHandle_t xTask,
+                               TickType_t xNewPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSetRelativeDeadline( TaskHandle_t xTask, TickType_t xNewRelativeDeadline );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SCHEDULER is set to 1.
+ *
+ * Change the deadline of the jobs of a periodic or sporadic task relative to
+ * their release.  As with xTaskSetPeriod(), the current job keeps its
+ * deadline and the jobs released after it completes take the new one, and
+ * if configUSE_EDF_ADMISSION_CONTROL is set to 1 the change must pass the
+ * admission test.
+ *
+ * @param xTask The handle of the task.  Passing NULL changes the calling task.
+ *
+ * @param xNewRelativeDeadline The new relative deadline in ticks.  0 makes
+ * the deadline equal to the period.
+ *
+ * @return pdPASS if the change will be made, errTASK_NOT_SCHEDULABLE if it was
+ * refused by the admission test, pdFAIL if the task is changing to a new mode
+ * or is disabled by xTaskChangeMode().
+ *
+ * \defgroup xTaskSetRelativeDeadline xTaskSetRelativeDeadline
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    BaseType_t xTaskSetRelativeDeadline( TaskHandle_t xTask,
+                                         TickType_t xNewRelativeDeadline ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskReleaseSporadic( TaskHandle_t xTaskToRelease );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SPORADIC_TASKS is set to 1.
+ *
+ * Release a job of a sporadic task created with xTaskSporadicCreate().  The
+ * job is released now and its absolute deadline is the current time plus the
+ * relative deadline of the task.
+ *
+ * A release that comes less than the minimum inter-arrival time after the
+ * previous one breaks the assumption the task was admitted with.  It is
+ * counted in the uxSeparationViolations member of the TaskStatus_t structure
+ * and the job is not released until the minimum inter-arrival time has
+ * elapsed, with its deadline measured from then.  Up to
+ * configEDF_SPORADIC_QUEUE_LENGTH releases are queued with the time each was
+ * requested, so no event is lost while the task is still busy with an earlier
+ * job, and a queued job is never released before its own request.  A release
+ * that finds the queue full is dropped and counted as a violation.
+ *
+ * @param xTaskToRelease The handle of the sporadic task to release.
+ *
+ * @return pdPASS if the job was released, pdFAIL if the release violated the
+ * minimum inter-arrival time and has been deferred, or was dropped because
+ * the queue was full.
+ *
+ * \defgroup xTaskReleaseSporadic xTaskReleaseSporadic
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+    BaseType_t xTaskReleaseSporadic( TaskHandle_t xTaskToRelease ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskReleaseSporadicFromISR( TaskHandle_t xTaskToRelease, BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SPORADIC_TASKS is set to 1.
+ *
+ * A version of xTaskReleaseSporadic() that can be called from an interrupt
+ * service routine, so the event that triggers a sporadic job can release it
+ * directly.
+ *
+ * @param xTaskToRelease The handle of the sporadic task to release.
+ *
+ * @param pxHigherPriorityTaskWoken xTaskReleaseSporadicFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if the released job has an earlier
+ * deadline than the task that was running when the interrupt occurred.  If it
+ * is set to pdTRUE a context switch should be requested before the interrupt
+ * is exited.
+ *
+ * @return pdPASS if the job was released, pdFAIL if the release violated the
+ * minimum inter-arrival time and has been deferred, or was dropped because
+ * the queue was full.
+ *
+ * Example usage:
+ * @code{c}
+ * void vButtonISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *   // Clear the interrupt source here, then release the job that handles it.
+ *   xTaskReleaseSporadicFromISR( xButtonTask, &xHigherPriorityTaskWoken );
+ *
+ *   portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xTaskReleaseSporadicFromISR xTaskReleaseSporadicFromISR
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+    BaseType_t xTaskReleaseSporadicFromISR( TaskHandle_t xTaskToRelease,
+                                            BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskChangeMode( const ModeTaskParameters_t * const pxTasks, const UBaseType_t uxNumberOfTasks );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_MODE_CHANGES is set to 1.
+ *
+ * Request a change to a new mode, given as the new period, relative deadline
+ * and worst case execution time of each periodic task that differs from the
+ * current mode.  Tasks that are not listed keep their parameters.  A change
+ * made by xTaskSetPeriod() or xTaskSetRelativeDeadline() that is still
+ * pending for a listed task is dropped.
+ *
+ * No job is cut short and no job runs with mixed parameters.  Each listed task
+ * takes its new parameters at the end of its current job, the next time it
+ * calls xTaskWaitForNextPeriod(), or vTaskDelayUntil() or vTaskDelay() for a
+ * task that paces itself with those.  Its next job is still released at the
+ * end of the old period, later jobs follow the new period.  So the change is
+ * complete, and uxTaskGetPendingModeChanges() returns 0, within the longest
+ * old period of the listed tasks provided every job completes.
+ *
+ * A task with a period of 0 is disabled: it completes its current job, then
+ * blocks in xTaskWaitForNextPeriod() until a later mode enables it again.  A
+ * disabled task is changed straight away, and if enabled its first job is
+ * released at once.
+ *
+ * When configUSE_EDF_ADMISSION_CONTROL is 1 the change is refused unless the
+ * tasks stay schedulable throughout the transition, while old and new jobs
+ * overlap.  The test is sufficient: the sum of the densities (worst case
+ * execution time divided by the smaller of the deadline and the period) of the
+ * admitted tasks, plus the increase in density of each listed task, must not
+ * exceed one.  Until the change is complete the increases stay claimed and no
+ * new periodic task is admitted.
+ *
+ * Only periodic tasks can be listed, each at most once, sporadic tasks cannot.
+ * A task disabled while it paces itself with delays keeps running, but without
+ * a deadline, so only when no job is Ready.  A listed task that neither waits
+ * for its period nor delays never takes the mode, and every later mode change,
+ * and with configUSE_EDF_ADMISSION_CONTROL every new periodic task, is refused
+ * until it does.  The function does not allocate memory and runs in time
+ * proportional to uxNumberOfTasks plus the number of admitted tasks.
+ *
+ * @param pxTasks The new parameters of the tasks to change.
+ *
+ * @param uxNumberOfTasks The number of entries in pxTasks.
+ *
+ * @return pdPASS if the change was accepted, pdFAIL if an earlier change is
+ * not yet complete or the new mode failed the admission test.
+ *
+ * Example usage:
+ * @code{c}
+ * void vEnterDegradedMode( void )
+ * {
+ * static const ModeTaskParameters_t xDegraded[] =
+ * {
+ *   // Slow the control loop down and stop logging.
+ *   { NULL, 20, 0, 4 },
+ *   { NULL, 0, 0, 0 }
+ * };
+ * ModeTaskParameters_t xMode[ 2 ];
+ *
+ *   memcpy( xMode, xDegraded, sizeof( xMode ) );
+ *   xMode[ 0 ].xTask = xControlTask;
+ *   xMode[ 1 ].xTask = xLogTask;
+ *
+ *   if( xTaskChangeMode( xMode, 2 ) != pdPASS )
+ *   {
+ *       // Stay in the current mode.
+ *   }
+ * }
+ * @endcode
+ * \defgroup xTaskChangeMode xTaskChangeMode
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_MODE_CHANGES == 1 )
+    BaseType_t xTaskChangeMode( const ModeTaskParameters_t * const pxTasks,
+                                const UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetPendingModeChanges( void );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_MODE_CHANGES is set to 1.
+ *
+ * @return The number of tasks that have not yet taken the parameters of the
+ * mode requested by the last call to xTaskChangeMode().  0 once the change is
+ * complete, when a new change can be requested.
+ *
+ * \defgroup uxTaskGetPendingModeChanges uxTaskGetPendingModeChanges
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_MODE_CHANGES == 1 )
+    UBaseType_t uxTaskGetPendingModeChanges( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetJobBudget( TaskHandle_t xTask, configRUN_TIME_COUNTER_TYPE ulBudget );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_BUDGET_ENFORCEMENT is set to 1.
+ *
+ * Set the execution budget of each job of a periodic or sporadic task, in
+ * units of the run time stats clock.  A task is given a budget of its WCET
+ * times configEDF_RUN_TIME_COUNTS_PER_TICK when it is created, this function
+ * can set a budget with the resolution of the run time stats clock instead.
+ *
+ * The run time of the running job is charged at every context switch, and the
+ * tick interrupt forces a context switch once the running job has used up its
+ * budget.  A job that exceeds its budget is counted in the uxBudgetOverruns
+ * member of the TaskStatus_t structure and handled as configEDF_OVERRUN_POLICY
+ * selects:
+ *
+ * tskOVERRUN_NOTIFY - the job continues as before.
+ *
+ * tskOVERRUN_DEMOTE - the rest of the job only runs while no other job is
+ * Ready, like a task at the idle priority.
+ *
+ * tskOVERRUN_THROTTLE - the job is suspended until the next release of the
+ * task and then continues with a new budget.  A job that is Blocked when the
+ * overrun is detected, or whose next release has already passed, is demoted
+ * instead.
+ *
+ * The budget is renewed each time the task starts a new job.
+ *
+ * @param xTask The handle of the task.  Passing NULL sets the budget of the
+ * calling task.
+ *
+ * @param ulBudget The budget of each job, or 0 to stop enforcing a budget for
+ * the task.
+ *
+ * \defgroup vTaskSetJobBudget vTaskSetJobBudget
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+    void vTaskSetJobBudget( TaskHandle_t xTask,
+                            configRUN_TIME_COUNTER_TYPE ulBudget ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSetTimeTriggeredSchedule( const TimeTriggeredSchedule_t * const pxSchedule, TaskHandle_t const * const pxTasks, const UBaseType_t uxNumberOfTasks );
+ * @endcode
+ *
+ * Only available when configUSE_TIME_TRIGGERED_SCHEDULER is set to 1.  Must be
+ * called before vTaskStartScheduler().
+ *
+ * Make the scheduler follow a precomputed schedule table, such as one
+ * generated offline by Project/Tools/tt_schedule_gen.  The hyperperiod starts
+ * when the scheduler is started.  At the start of each slot the tick interrupt
+ * gives the processor to the task that owns the slot, releasing a new job of
+ * the task if it is a release slot, so the dispatch cost is the same for every
+ * slot and does not depend on the number of tasks.
+ *
+ * A task of the table runs its jobs in a loop that calls
+ * vTaskWaitForNextSlot() before each job.  Outside its slots, and once its job
+ * has completed, the processor goes to the other Ready tasks by priority.  The
+ * tasks of the table should be created at a priority above the tasks that only
+ * use this free time, so that a task readied within its own slot preempts
+ * them straight away.
+ *
+ * @param pxSchedule The schedule table.  The table is checked by this
+ * function and must not be changed afterwards.
+ *
+ * @param pxTasks The handles of the tasks named by the slots of the table, by
+ * task index.  The array must remain valid while the scheduler is running.
+ *
+ * @param uxNumberOfTasks The number of handles in pxTasks.
+ *
+ * @return pdPASS if the table was accepted.  pdFAIL if its first slot does not
+ * start at 0, its slots are not in order of start time within the
+ * hyperperiod, or a slot names a task that is not in pxTasks.
+ *
+ * \defgroup xTaskSetTimeTriggeredSchedule xTaskSetTimeTriggeredSchedule
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+    BaseType_t xTaskSetTimeTriggeredSchedule( const TimeTriggeredSchedule_t * const pxSchedule,
+                                              TaskHandle_t const * const pxTasks,
+                                              const UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskWaitForNextSlot( void );
+ * @endcode
+ *
+ * Only available when configUSE_TIME_TRIGGERED_SCHEDULER is set to 1.
+ *
+ * Complete the current job of the calling task and block until the schedule
+ * table releases the next one.  If the next job was already released, because
+ * the previous job overran its slots or the task had not yet waited for its
+ * first job, the function returns straight away.  A job that is still running
+ * when the next one is released is counted in the uxSlotOverruns member of the
+ * TaskStatus_t structure and reported through traceTASK_SLOT_OVERRUN().
+ *
+ * Example usage:
+ * @code{c}
+ * void vControlTask( void * pvParameters )
+ * {
+ *   for( ;; )
+ *   {
+ *       vTaskWaitForNextSlot();
+ *
+ *       // Perform the job of this task.
+ *   }
+ * }
+ * @endcode
+ * \defgroup vTaskWaitForNextSlot vTaskWaitForNextSlot
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+    void vTaskWaitForNextSlot( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * vTaskDelayUntil() is the older version of xTaskDelayUntil() and does not
  * return a value.
@@ -1657,6 +2396,52 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
 
 #endif
 
+#if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationDeadlineMissHook( TaskHandle_t xTask, TickType_t xLateness );
+ * @endcode
+ *
+ * The application deadline miss hook is called once for each job that misses
+ * its absolute deadline.  It is called when the late job completes by calling
+ * xTaskDelayUntil(), or from the tick interrupt if
+ * configEDF_CHECK_DEADLINES_ON_TICK is set to 1 and the deadline expires while
+ * the job is still Ready.  In both cases the scheduler is not able to switch
+ * tasks, so the hook must not call any API function that might block.
+ *
+ * @param xTask the task whose job missed its deadline.
+ * @param xLateness the number of ticks that had passed since the deadline when
+ * the miss was detected.
+ */
+    void vApplicationDeadlineMissHook( TaskHandle_t xTask,
+                                       TickType_t xLateness ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
+#if ( configUSE_BUDGET_OVERRUN_HOOK == 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationBudgetOverrunHook( TaskHandle_t xTask, configRUN_TIME_COUNTER_TYPE ulExecutionTime );
+ * @endcode
+ *
+ * The application budget overrun hook is called once for each job that
+ * executes for longer than its budget, before configEDF_OVERRUN_POLICY is
+ * applied.  It is called from the context switch, so it must be short and must
+ * not call any API function that might block.
+ *
+ * @param xTask the task whose job overran its budget.
+ * @param ulExecutionTime the run time the job had used, in units of the run
+ * time stats clock.
+ */
+    void vApplicationBudgetOverrunHook( TaskHandle_t xTask,
+                                        configRUN_TIME_COUNTER_TYPE ulExecutionTime ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 /**
@@ -1910,6 +2695,117 @@ void vTaskList( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unquali
  */
 void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetJobStats( char *pcWriteBuffer );
+ * @endcode
+ *
+ * configUSE_EDF_JOB_STATISTICS, configUSE_TRACE_FACILITY and
+ * configUSE_STATS_FORMATTING_FUNCTIONS must all be defined as 1 for this
+ * function to be available.
+ *
+ * Setting configUSE_EDF_JOB_STATISTICS to 1 records the release, start,
+ * completion and deadline of each job of a periodic or sporadic task, and
+ * keeps the minimum, mean and maximum response time and the start jitter of
+ * the task.  A job starts the first time it runs after its release and
+ * completes when the task waits for its next release.  Calling
+ * vTaskGetJobStats() writes these statistics, with the maximum lateness and the
+ * number of deadline misses, into a buffer as one line per task that has
+ * completed a job.  All values are in ticks.
+ *
+ * NOTE:  This function is provided for convenience only, like
+ * vTaskGetRunTimeStats(), and disables interrupts for its duration.  Production
+ * systems should read the xJobStatistics member of the TaskStatus_t structures
+ * returned by uxTaskGetSystemState() or vTaskGetInfo() instead.
+ *
+ * @param pcWriteBuffer A buffer into which the statistics will be written, in
+ * ASCII form.  This buffer is assumed to be large enough to contain the
+ * generated report.  Approximately 60 bytes per task should be sufficient.
+ *
+ * \defgroup vTaskGetJobStats vTaskGetJobStats
+ * \ingroup TaskUtils
+ */
+void vTaskGetJobStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskStreamStats( eTaskStatsEncoding eEncoding, TaskStatsSink_t pxSink, void * pvContext );
+ * @endcode
+ *
+ * configUSE_TRACE_FACILITY and configUSE_STATS_FORMATTING_FUNCTIONS must both
+ * be defined as 1 for this function to be available.  It does not need
+ * configSUPPORT_DYNAMIC_ALLOCATION.
+ *
+ * uxTaskStreamStats() reports the same information as vTaskList() and
+ * vTaskGetRunTimeStats() together, but passes it to pxSink one task at a time
+ * instead of writing it to a buffer.  Nothing is allocated and sprintf() is not
+ * used, so the stack used is bounded by one TaskStatus_t and one record of
+ * less than configMAX_TASK_NAME_LEN + 96 bytes whatever the number of tasks.
+ *
+ * The tasks are reported in the order they were created.  The scheduler is
+ * suspended only while the next task is found and its status read, which
+ * takes time in proportion to the number of tasks, and the sink is called
+ * with the scheduler running, so it can block, for example to wait for a
+ * UART.  A task created part way through is still reported, and one deleted
+ * part way through is reported in the Deleted state until the idle task has
+ * freed it.
+ *
+ * With eTaskStatsCSV the first record names the columns:
+ *
+ * @code{c}
+ * name,number,state,priority,stack,run_time,cpu\r\n
+ * @endcode
+ *
+ * and each task is then a line such as "Task1,3,B,1,402,1450321,24.50\r\n",
+ * giving its name, task number, state as the character used by vTaskList(),
+ * current priority, stack high water mark in words, run time counter and
+ * percentage of the total run time.  Commas in task names are not escaped.
+ *
+ * With eTaskStatsBinary each record is a byte holding the length of the rest
+ * of the record, the state as an eTaskState value, then the task number,
+ * current priority, stack high water mark, run time counter and percentage of
+ * the total run time in hundredths, each as an unsigned LEB128 varint (seven
+ * bits per byte, least significant first, the top bit set on all but the last
+ * byte), and last a byte holding the length of the name followed by the name
+ * without its terminator.
+ *
+ * The run time and percentage are 0 unless configGENERATE_RUN_TIME_STATS is
+ * 1.  The percentage is of the total run time read when the call starts.
+ *
+ * @param eEncoding The encoding of the records, eTaskStatsCSV or
+ * eTaskStatsBinary.
+ *
+ * @param pxSink The function each record is passed to.  The record is only
+ * valid until the sink returns.  The stream stops early if the sink returns
+ * pdFALSE.
+ *
+ * @param pvContext Passed to pxSink unchanged.
+ *
+ * @return The number of task records accepted by the sink, not counting the
+ * column names of eTaskStatsCSV.
+ *
+ * Example usage:
+ * @code{c}
+ * static BaseType_t prvPrintRecord( const uint8_t * pucRecord, size_t xLength, void * pvContext )
+ * {
+ *     ( void ) pvContext;
+ *     return ( fwrite( pucRecord, 1, xLength, stdout ) == xLength ) ? pdTRUE : pdFALSE;
+ * }
+ *
+ * void vPrintTasks( void )
+ * {
+ *     ( void ) uxTaskStreamStats( eTaskStatsCSV, prvPrintRecord, NULL );
+ * }
+ * @endcode
+ * \defgroup uxTaskStreamStats uxTaskStreamStats
+ * \ingroup TaskUtils
+ */
+UBaseType_t uxTaskStreamStats( eTaskStatsEncoding eEncoding,
+                               TaskStatsSink_t pxSink,
+                               void * pvContext ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -1951,6 +2847,90 @@ void vTaskGetRunTimeStats( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * uint32_t ulTaskGetRemainingUtilisation( void );
+ * @endcode
+ *
+ * configUSE_EDF_ADMISSION_CONTROL must be defined as 1 for this function to be
+ * available.
+ *
+ * Returns the processor utilisation that has not yet been claimed by the
+ * periodic tasks accepted by the admission test, where tskUTILISATION_SCALE
+ * is the whole processor.  A task whose worst case execution time divided by
+ * its period exceeds this value will be refused.  A task with a constrained
+ * deadline can be refused even if it fits, as its deadline is also checked.
+ *
+ * @return The unclaimed utilisation, scaled by tskUTILISATION_SCALE.
+ *
+ * \defgroup ulTaskGetRemainingUtilisation ulTaskGetRemainingUtilisation
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+    uint32_t ulTaskGetRemainingUtilisation( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * uint32_t ulTaskGetAvoidedContextSwitches( void );
+ * @endcode
+ *
+ * Only available when configUSE_EDF_SCHEDULER is set to 1.
+ *
+ * Every EDF task runs at the same priority, so the kernel decides whether a
+ * task that has just been readied preempts the running task by comparing
+ * their deadlines.  This function returns the number of times a readied task
+ * did not preempt the running task because its deadline was not earlier,
+ * each of which is a context switch a comparison of the priorities would
+ * have made.
+ *
+ * @return The number of context switches avoided since the scheduler started.
+ *
+ * \defgroup ulTaskGetAvoidedContextSwitches ulTaskGetAvoidedContextSwitches
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    uint32_t ulTaskGetAvoidedContextSwitches( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * eFixedPriorityTestResult eTaskTestFixedPriorityTaskSet( TaskHandle_t * const pxFailingTask );
+ * @endcode
+ *
+ * configUSE_FP_PRIORITY_ASSIGNMENT must be defined as 1 for this function to
+ * be available.
+ *
+ * Tests whether the periodic tasks, at the priorities assigned to them, meet
+ * their deadlines under the fixed priority scheduler.  Only tasks created
+ * with a non-zero worst case execution time are accounted for.
+ *
+ * While every deadline is equal to its period and no two tasks with different
+ * periods share a priority, the total utilisation is first compared against
+ * the Liu and Layland bound n(2^(1/n) - 1).  If the bound does not apply or is
+ * exceeded the worst case response time of each task is found by response
+ * time analysis, in which the tasks of the same priority as the task being
+ * analysed count as interference too.  The result is exact for distinct
+ * priorities and pessimistic otherwise.
+ *
+ * @param pxFailingTask Used to pass out the highest priority task whose worst
+ * case response time exceeds its deadline.  Set to NULL if every deadline is
+ * met.  Can be NULL if the task is not required.
+ *
+ * @return eFixedPriorityBoundMet if the bound shows the task set is
+ * schedulable, eFixedPriorityResponseTimesMet if the response time analysis
+ * does, otherwise eFixedPriorityDeadlineMissed.
+ *
+ * \defgroup eTaskTestFixedPriorityTaskSet eTaskTestFixedPriorityTaskSet
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+    eFixedPriorityTestResult eTaskTestFixedPriorityTaskSet( TaskHandle_t * const pxFailingTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -3032,7 +4012,11 @@ BaseType_t xTaskGetSchedulerState( void ) PRIVILEGED_FUNCTION;
 
 /*
  * Raises the priority of the mutex holder to that of the calling task should
- * the mutex holder have a priority less than the calling task.
+ * the mutex holder have a priority less than the calling task.  Under EDF the
+ * mutex holder inherits the deadline of the calling task instead, should that
+ * deadline be earlier than its own.  Neither is transitive: if the mutex holder
+ * is itself blocked on a mutex held by another task, that other task inherits
+ * nothing.
  */
 BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
@@ -3048,7 +4032,11 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
  * priority task then timed out without obtaining the mutex, then the lower
  * priority task will disinherit the priority again - but only down as far as
  * the highest priority task that is still waiting for the mutex (if there were
- * more than one task waiting for the mutex).
+ * more than one task waiting for the mutex).  Under EDF the deadlines of the
+ * tasks still waiting are not known, so an inherited deadline is only given
+ * back if no task is left waiting and the holder holds no other mutex -
+ * otherwise it is kept until the holder gives the mutex back, even if it was
+ * the task that timed out that lent it.
  */
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
@@ -3103,6 +4091,28 @@ TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_EDF_CBS == 1 )
+
+/*
+ * For internal use only.  Turn the periodic task xTask into a constant
+ * bandwidth server with a budget of xBudget ticks every xTaskPeriod ticks.
+ * From then on the budget is charged each tick the task runs, and the
+ * deadline of the task is postponed by one period each time the budget is
+ * exhausted.
+ */
+    void vTaskCBSInitialise( TaskHandle_t xTask,
+                             TickType_t xBudget ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Called by a constant bandwidth server task with
+ * xIdle set to pdTRUE just before it blocks to wait for a job, and with xIdle
+ * set to pdFALSE once it has a job to run.  If the server is unblocked while
+ * idle its deadline and budget are set by the CBS job arrival rule.
+ */
+    void vTaskCBSSetServerIdle( BaseType_t xIdle ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_CBS */
+
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
@@ -0,0 +1,267 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The trace recorder writes the kernel trace events into a RAM buffer as
+ * compact binary records.  It is included by FreeRTOS.h when
+ * configUSE_TRACE_RECORDER is set to 1, and defines the trace macros listed at
+ * the end of this file.  A trace macro already defined in FreeRTOSConfig.h is
+ * left as it is, and that event is not recorded.
+ *
+ * Each record is an event byte followed by unsigned LEB128 varints: the time
+ * since the previous record, as counted by configTRACE_RECORDER_TIMESTAMP(),
+ * then the parameters of the event.  recorderEVENT_TASK_CREATE ends with the
+ * length and the characters of the task name.  A varint holds 7 bits per byte,
+ * so most records take 3 or 4 bytes.
+ *
+ * Ticks are not recorded one by one.  They are counted, and the count is
+ * written as a recorderEVENT_TICKS record in front of the next other record,
+ * so a system that is mostly idle uses no buffer space for its ticks.
+ *
+ * The cost of an event is bounded: it is encoded into at most
+ * recorderMAX_RECORD_LENGTH bytes, and in snapshot mode at most that many
+ * bytes of old records are dropped to make room, all with interrupts masked
+ * through portSET_INTERRUPT_MASK_FROM_ISR(), which the port must implement for
+ * events recorded from tasks to be safe from interrupts.
+ *
+ * To decode a snapshot, stop the recorder with vTraceRecorderStop() and read
+ * xTraceRecorderBuffer, for example with the debugger.  The oldest record
+ * starts at ulTail and its time is counted from ulTailTimestamp.  In stream
+ * mode the records are read out with xTraceRecorderRead() as they are made.
+ * Project/Tools/trace_decode prints either as text.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include trace_recorder.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/* The events and their parameters.  Tasks and queues are identified by their
+ * trace numbers. */
+#define recorderEVENT_TICKS                  ( ( uint8_t ) 0 )  /* Number of ticks since the last record. */
+#define recorderEVENT_TASK_SWITCHED_IN       ( ( uint8_t ) 1 )  /* Task. */
+#define recorderEVENT_TASK_READY             ( ( uint8_t ) 2 )  /* Task. */
+#define recorderEVENT_TASK_DELAY             ( ( uint8_t ) 3 )  /* Ticks until the running task wakes. */
+#define recorderEVENT_BLOCK_ON_SEND          ( ( uint8_t ) 4 )  /* Queue the running task blocks to send to. */
+#define recorderEVENT_BLOCK_ON_RECEIVE       ( ( uint8_t ) 5 )  /* Queue the running task blocks to receive from. */
+#define recorderEVENT_QUEUE_SEND             ( ( uint8_t ) 6 )  /* Queue. */
+#define recorderEVENT_QUEUE_SEND_FAILED      ( ( uint8_t ) 7 )  /* Queue. */
+#define recorderEVENT_QUEUE_RECEIVE          ( ( uint8_t ) 8 )  /* Queue. */
+#define recorderEVENT_QUEUE_RECEIVE_FAILED   ( ( uint8_t ) 9 )  /* Queue. */
+#define recorderEVENT_QUEUE_SEND_FROM_ISR    ( ( uint8_t ) 10 ) /* Queue. */
+#define recorderEVENT_QUEUE_RECEIVE_FROM_ISR ( ( uint8_t ) 11 ) /* Queue. */
+#define recorderEVENT_QUEUE_CREATE           ( ( uint8_t ) 12 ) /* Queue, queue type. */
+#define recorderEVENT_TASK_CREATE            ( ( uint8_t ) 13 ) /* Task, priority, name length, name. */
+#define recorderEVENT_TASK_DELETE            ( ( uint8_t ) 14 ) /* Task. */
+#define recorderEVENT_DEADLINE_MISSED        ( ( uint8_t ) 15 ) /* Task, lateness in ticks. */
+#define recorderEVENT_ISR_ENTER              ( ( uint8_t ) 16 ) /* Interrupt number given to vTraceRecorderISREnter(). */
+#define recorderEVENT_ISR_EXIT               ( ( uint8_t ) 17 ) /* None. */
+#define recorderEVENT_DROPPED                ( ( uint8_t ) 18 ) /* Number of records lost in stream mode. */
+#define recorderNUMBER_OF_EVENTS             ( ( uint8_t ) 19 )
+
+/* The longest record: an event byte, the time and two parameters as varints of
+ * up to 5 bytes, and a task name with its length. */
+#define recorderMAX_RECORD_LENGTH            ( 1 + ( 3 * 5 ) + 1 + configMAX_TASK_NAME_LEN )
+
+/* The recorder state and buffer, laid out for reading from a memory dump. */
+typedef struct xTRACE_RECORDER_BUFFER
+{
+    uint32_t ulHead;          /* Index in ucData at which the next record is written. */
+    uint32_t ulTail;          /* Index in ucData of the oldest record. */
+    uint32_t ulUsed;          /* Number of bytes of ucData holding records. */
+    uint32_t ulTailTimestamp; /* The time the oldest record's time is counted from. */
+    uint32_t ulLastTimestamp; /* The time of the newest record. */
+    uint32_t ulPendingTicks;  /* Ticks not yet written as a recorderEVENT_TICKS record. */
+    uint32_t ulDropped;       /* Records lost in stream mode and not yet reported. */
+    uint32_t ulRunning;       /* pdTRUE while events are recorded. */
+    uint8_t ucData[ configTRACE_RECORDER_BUFFER_SIZE ];
+} TraceRecorderBuffer_t;
+
+extern TraceRecorderBuffer_t xTraceRecorderBuffer;
+
+/*-----------------------------------------------------------
+* RECORDER API
+*----------------------------------------------------------*/
+
+/*
+ * Empty the buffer and start recording.  The recorder starts out recording,
+ * so events from before the scheduler starts are kept.
+ */
+void vTraceRecorderStart( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stop recording, so the buffer can be read out as it is.
+ */
+void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Stream mode only.  Copy up to xLength bytes of the oldest records into
+ * pucBuffer and remove them from the buffer, for a task or a host link to
+ * pass on as fast as the events are recorded.  A record can be split between
+ * two reads.  Returns the number of bytes copied.
+ */
+#if ( configTRACE_RECORDER_MODE == tskTRACE_STREAM )
+    size_t xTraceRecorderRead( uint8_t * pucBuffer,
+                               size_t xLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Record that the interrupt ucISR was entered or exited.  Called by the
+ * application at the start and end of the interrupt service routines it wants
+ * to see in the trace.
+ */
+void vTraceRecorderISREnter( uint8_t ucISR ) PRIVILEGED_FUNCTION;
+void vTraceRecorderISRExit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by the trace macros below, callable from tasks and interrupts.
+ */
+void vTraceRecorderEvent( uint8_t ucEvent,
+                          uint32_t ulParameter1,
+                          uint32_t ulParameter2 ) PRIVILEGED_FUNCTION;
+void vTraceRecorderTaskCreate( uint32_t ulTask,
+                               uint32_t ulPriority,
+                               const char * pcName ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTraceRecorderNextQueueNumber( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------
+* TRACE MACROS
+*----------------------------------------------------------*/
+
+/* A task switch only records the task switched in, which implies the one
+ * switched out. */
+#ifndef traceTASK_SWITCHED_IN
+    #define traceTASK_SWITCHED_IN()    vTraceRecorderEvent( recorderEVENT_TASK_SWITCHED_IN, ( uint32_t ) pxCurrentTCB->uxTCBNumber, 0 )
+#endif
+
+#ifndef traceMOVED_TASK_TO_READY_STATE
+    #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    vTraceRecorderEvent( recorderEVENT_TASK_READY, ( uint32_t ) ( pxTCB )->uxTCBNumber, 0 )
+#endif
+
+/* Called from the tick interrupt, only counts the tick.  A tick that comes
+ * while the scheduler is suspended is counted when xTaskResumeAll() replays
+ * it. */
+#ifndef traceTASK_INCREMENT_TICK
+    #define traceTASK_INCREMENT_TICK( xTickCount )         \
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) \
+    {                                                     \
+        xTraceRecorderBuffer.ulPendingTicks++;            \
+    }
+#endif
+
+/* Called with the scheduler suspended after tickless idle, counts the ticks
+ * slept through. */
+#ifndef traceINCREASE_TICK_COUNT
+    #define traceINCREASE_TICK_COUNT( xTicksToJump )    ( xTraceRecorderBuffer.ulPendingTicks += ( uint32_t ) ( xTicksToJump ) )
+#endif
+
+#ifndef traceTASK_CREATE
+    #define traceTASK_CREATE( pxNewTCB )    vTraceRecorderTaskCreate( ( uint32_t ) ( pxNewTCB )->uxTCBNumber, ( uint32_t ) ( pxNewTCB )->uxPriority, ( pxNewTCB )->pcTaskName )
+#endif
+
+#ifndef traceTASK_DELETE
+    #define traceTASK_DELETE( pxTCB )    vTraceRecorderEvent( recorderEVENT_TASK_DELETE, ( uint32_t ) ( pxTCB )->uxTCBNumber, 0 )
+#endif
+
+#ifndef traceTASK_DELAY
+    #define traceTASK_DELAY()    vTraceRecorderEvent( recorderEVENT_TASK_DELAY, ( uint32_t ) xTicksToDelay, 0 )
+#endif
+
+#ifndef traceTASK_DELAY_UNTIL
+    #define traceTASK_DELAY_UNTIL( xTimeToWake )    vTraceRecorderEvent( recorderEVENT_TASK_DELAY, ( uint32_t ) ( TickType_t ) ( ( xTimeToWake ) - xTickCount ), 0 )
+#endif
+
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB, xLateness )    vTraceRecorderEvent( recorderEVENT_DEADLINE_MISSED, ( uint32_t ) ( pxTCB )->uxTCBNumber, ( uint32_t ) ( xLateness ) )
+#endif
+
+/* Queues are numbered as they are created, vQueueSetQueueNumber() can
+ * renumber them afterwards. */
+#ifndef traceQUEUE_CREATE
+    #define traceQUEUE_CREATE( pxNewQueue )                                           \
+    do {                                                                              \
+        ( pxNewQueue )->uxQueueNumber = uxTraceRecorderNextQueueNumber();            \
+        vTraceRecorderEvent( recorderEVENT_QUEUE_CREATE, ( uint32_t ) ( pxNewQueue )->uxQueueNumber, ( uint32_t ) ( pxNewQueue )->ucQueueType ); \
+    } while( 0 )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_SEND
+    #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )    vTraceRecorderEvent( recorderEVENT_BLOCK_ON_SEND, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+    #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )    vTraceRecorderEvent( recorderEVENT_BLOCK_ON_RECEIVE, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceBLOCKING_ON_QUEUE_PEEK
+    #define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )    vTraceRecorderEvent( recorderEVENT_BLOCK_ON_RECEIVE, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceQUEUE_SEND
+    #define traceQUEUE_SEND( pxQueue )    vTraceRecorderEvent( recorderEVENT_QUEUE_SEND, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceQUEUE_SEND_FAILED
+    #define traceQUEUE_SEND_FAILED( pxQueue )    vTraceRecorderEvent( recorderEVENT_QUEUE_SEND_FAILED, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceQUEUE_RECEIVE
+    #define traceQUEUE_RECEIVE( pxQueue )    vTraceRecorderEvent( recorderEVENT_QUEUE_RECEIVE, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FAILED
+    #define traceQUEUE_RECEIVE_FAILED( pxQueue )    vTraceRecorderEvent( recorderEVENT_QUEUE_RECEIVE_FAILED, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceQUEUE_SEND_FROM_ISR
+    #define traceQUEUE_SEND_FROM_ISR( pxQueue )    vTraceRecorderEvent( recorderEVENT_QUEUE_SEND_FROM_ISR, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_FROM_ISR
+    #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )    vTraceRecorderEvent( recorderEVENT_QUEUE_RECEIVE_FROM_ISR, ( uint32_t ) ( pxQueue )->uxQueueNumber, 0 )
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* TRACE_RECORDER_H */
@@ -42,6 +42,7 @@
 
 /* Constants required to setup the tick ISR. */
 #define portENABLE_TIMER			( ( uint8_t ) 0x01 )
+#define portDISABLE_TIMER			( ( uint8_t ) 0x00 )
 #define portPRESCALE_VALUE			0x00
 #define portINTERRUPT_ON_MATCH		( ( uint32_t ) 0x01 )
 #define portRESET_COUNT_ON_MATCH	( ( uint32_t ) 0x02 )
@@ -55,6 +56,18 @@
 #define portTIMER_MATCH_ISR_BIT		( ( uint8_t ) 0x01 )
 #define portCLEAR_VIC_INTERRUPT		( ( uint32_t ) 0 )
 
+/* Constants required to enter the idle power mode. */
+#define portPCON_IDLE_MODE			( ( uint8_t ) 0x01 )
+
+/* Constants required to setup Timer1 as the run time counter. */
+#define portRESET_TIMER				( ( uint8_t ) 0x02 )
+#define portRUN_TIME_MATCH_HALF		( ( uint32_t ) 0x80000000UL )
+#define portRUN_TIME_MATCH_WRAP		( ( uint32_t ) 0x00000000UL )
+#define portINTERRUPT_ON_MR0_AND_MR1	( ( uint32_t ) 0x09 )
+#define portRUN_TIME_MATCH_ISR_BITS	( ( uint8_t ) 0x03 )
+#define portRUN_TIME_VIC_CHANNEL	( ( uint32_t ) 0x0005 )
+#define portRUN_TIME_VIC_CHANNEL_BIT	( ( uint32_t ) 0x0020 )
+
 /*-----------------------------------------------------------*/
 
 /* The code generated by the Keil compiler does not maintain separate
@@ -68,9 +81,52 @@ volatile uint32_t ulCriticalNesting = 9999UL;
 
 /*-----------------------------------------------------------*/
 
+#if configUSE_TICKLESS_IDLE == 1
+
+	/* The number of timer counts that make up one tick period. */
+	static uint32_t ulTimerCountsForOneTick = 0;
+
+	/* The maximum number of tick periods that can be suppressed is limited by
+	the 32 bit resolution of the match register. */
+	static TickType_t xMaximumPossibleSuppressedTicks = 0;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if configGENERATE_RUN_TIME_STATS == 1
+
+	/* The rate Timer1 counts at, which divides the peripheral clock. */
+	#ifndef configRUN_TIME_COUNTER_HZ
+		#define configRUN_TIME_COUNTER_HZ	configCPU_CLOCK_HZ
+	#endif
+
+	/* Timer1 gives the low 32 bits of the run time counter.  The high 32 bits
+	are counted in software each time the count is seen to have wrapped,
+	which it is at least twice per wrap by the match interrupts at 0 and
+	0x80000000. */
+	static uint32_t ulRunTimeCounterHigh = 0;
+	static uint32_t ulRunTimeCounterLastCount = 0;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
 /* Setup the timer to generate the tick interrupts. */
 static void prvSetupTimerInterrupt( void );
 
+#if configGENERATE_RUN_TIME_STATS == 1
+
+	/* Read Timer1 and extend it to 64 bits.  Must be called with IRQ
+	disabled. */
+	static uint64_t prvExtendRunTimeCounter( void );
+
+	/* The Timer1 match interrupt, which keeps the high 32 bits up to date
+	when the counter is not read for a long time. */
+	static void prvRunTimeCounterISR( void ) __irq;
+
+#endif
+
 /* 
  * The scheduler can only be started from ARM mode, so 
  * vPortStartFirstSTask() is defined in portISR.c. 
@@ -232,6 +288,13 @@ uint32_t ulCompareMatch;
 
 	T0MR0 = ulCompareMatch;
 
+	#if configUSE_TICKLESS_IDLE == 1
+	{
+		ulTimerCountsForOneTick = ulCompareMatch;
+		xMaximumPossibleSuppressedTicks = ( TickType_t ) ( 0xffffffffUL / ulCompareMatch );
+	}
+	#endif
+
 	/* Generate tick with timer 0 compare match. */
 	T0MCR = portRESET_COUNT_ON_MATCH | portINTERRUPT_ON_MATCH;
 
@@ -259,6 +322,162 @@ uint32_t ulCompareMatch;
 }
 /*-----------------------------------------------------------*/
 
+#if configUSE_TICKLESS_IDLE == 1
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+	uint32_t ulCountAfterSleep, ulCompleteTickPeriods;
+	TickType_t xModifiableIdleTime;
+
+		/* Make sure the match value does not overflow the timer. */
+		if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+		{
+			xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+		}
+
+		/* Stop the timer while it is reprogrammed.  This loses a few timer
+		counts on each sleep, so the tick count drifts slightly against
+		calendar time. */
+		portDISABLE_INTERRUPTS();
+		T0TCR = portDISABLE_TIMER;
+
+		/* Abandon the sleep if a context switch is pending, a task was made
+		Ready while the scheduler was suspended, or the tick interrupt is
+		already waiting to be serviced. */
+		if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) || ( ( T0IR & portTIMER_MATCH_ISR_BIT ) != 0 ) )
+		{
+			T0TCR = portENABLE_TIMER;
+			portENABLE_INTERRUPTS();
+		}
+		else
+		{
+			/* The timer counts up from zero and generates the tick when it
+			matches MR0.  Moving the match xExpectedIdleTime - 1 tick periods
+			further out leaves the current tick period as it was and the
+			timer running from the same count. */
+			T0MR0 = ulTimerCountsForOneTick * xExpectedIdleTime;
+			T0TCR = portENABLE_TIMER;
+
+			/* Allow the application to define some pre-sleep processing,
+			which can set xModifiableIdleTime to 0 to skip the sleep. */
+			xModifiableIdleTime = xExpectedIdleTime;
+			configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+			if( xModifiableIdleTime > 0 )
+			{
+				/* Stop the processor clock until an enabled interrupt is
+				raised.  IRQs are masked in the CPSR, so the interrupt that
+				ends the sleep is only serviced once the tick count has been
+				corrected below. */
+				PCON = portPCON_IDLE_MODE;
+			}
+
+			configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+			/* Stop the timer again while the time spent asleep is worked
+			out. */
+			T0TCR = portDISABLE_TIMER;
+
+			if( ( T0IR & portTIMER_MATCH_ISR_BIT ) != 0 )
+			{
+				/* The tick interrupt ended the sleep, so the whole expected
+				idle time has passed and the timer has restarted from zero.
+				The pending tick interrupt counts the last tick period when
+				interrupts are enabled again. */
+				T0MR0 = ulTimerCountsForOneTick;
+				vTaskStepTick( xExpectedIdleTime - ( TickType_t ) 1 );
+			}
+			else
+			{
+				/* Another interrupt ended the sleep.  Count the tick periods
+				that have completed and wind the timer back into the tick
+				period that is in progress, at the end of which the tick
+				interrupt counts it as normal. */
+				ulCountAfterSleep = T0TC;
+				ulCompleteTickPeriods = ulCountAfterSleep / ulTimerCountsForOneTick;
+				T0TC = ulCountAfterSleep - ( ulCompleteTickPeriods * ulTimerCountsForOneTick );
+				T0MR0 = ulTimerCountsForOneTick;
+				vTaskStepTick( ( TickType_t ) ulCompleteTickPeriods );
+			}
+
+			T0TCR = portENABLE_TIMER;
+			portENABLE_INTERRUPTS();
+		}
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if configGENERATE_RUN_TIME_STATS == 1
+
+	void vPortConfigureRunTimeCounter( void )
+	{
+		/* The peripheral clock is the processor clock, as for the tick. */
+		configASSERT( ( configCPU_CLOCK_HZ % configRUN_TIME_COUNTER_HZ ) == 0 );
+
+		T1TCR = portRESET_TIMER;
+		T1PR = ( configCPU_CLOCK_HZ / configRUN_TIME_COUNTER_HZ ) - 1UL;
+		T1MR0 = portRUN_TIME_MATCH_WRAP;
+		T1MR1 = portRUN_TIME_MATCH_HALF;
+
+		/* Interrupt on both matches without resetting the count, so the
+		timer runs freely through the whole 32 bit range. */
+		T1MCR = portINTERRUPT_ON_MR0_AND_MR1;
+		T1IR = portRUN_TIME_MATCH_ISR_BITS;
+
+		/* Vectored slot 0 is the tick and slot 1 the UART. */
+		VICIntSelect &= ~( portRUN_TIME_VIC_CHANNEL_BIT );
+		VICVectAddr2 = ( uint32_t ) prvRunTimeCounterISR;
+		VICVectCntl2 = portRUN_TIME_VIC_CHANNEL | portTIMER_VIC_ENABLE;
+		VICIntEnable |= portRUN_TIME_VIC_CHANNEL_BIT;
+
+		ulRunTimeCounterHigh = 0;
+		ulRunTimeCounterLastCount = 0;
+		T1TCR = portENABLE_TIMER;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint64_t prvExtendRunTimeCounter( void )
+	{
+	uint32_t ulCount = T1TC;
+
+		if( ulCount < ulRunTimeCounterLastCount )
+		{
+			ulRunTimeCounterHigh++;
+		}
+
+		ulRunTimeCounterLastCount = ulCount;
+
+		return ( ( uint64_t ) ulRunTimeCounterHigh << 32 ) | ( uint64_t ) ulCount;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRunTimeCounterISR( void ) __irq
+	{
+		( void ) prvExtendRunTimeCounter();
+
+		T1IR = portRUN_TIME_MATCH_ISR_BITS;			/* Clear the timer events. */
+		VICVectAddr = portCLEAR_VIC_INTERRUPT;		/* Acknowledge the Interrupt */
+	}
+	/*-----------------------------------------------------------*/
+
+	uint64_t ullPortGetRunTimeCounterValue( void )
+	{
+	unsigned long ulSavedMask;
+	uint64_t ullCount;
+
+		/* Also called from the kernel in ISRs and critical sections, so IRQ
+		is masked rather than a critical section entered. */
+		ulSavedMask = ulPortSetInterruptMask();
+		ullCount = prvExtendRunTimeCounter();
+		vPortClearInterruptMask( ulSavedMask );
+
+		return ullCount;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 void vPortEnterCritical( void )
 {
 	/* Disable interrupts as per portDISABLE_INTERRUPTS(); 							*/
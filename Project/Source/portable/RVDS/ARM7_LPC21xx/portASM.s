@@ -35,6 +35,8 @@
 	EXPORT	vPortStartFirstTask
 	EXPORT	vPreemptiveTick
 	EXPORT	vPortYield
+	EXPORT	ulPortSetInterruptMask
+	EXPORT	vPortClearInterruptMask
 
 
 VICVECTADDR	EQU	0xFFFFF030
@@ -121,5 +123,32 @@ SkipContextSwitch
 
 	portRESTORE_CONTEXT					; Restore the context of the highest
 										; priority task that is ready to run.
+
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+; Interrupt masking that can be used from a task or from an ISR, as it does
+; not touch the critical nesting count.  ulPortSetInterruptMask() disables IRQ
+; and returns the I bit as it was, vPortClearInterruptMask() puts it back.
+;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
+
+ulPortSetInterruptMask
+
+	PRESERVE8
+
+	MRS R0, CPSR						; Read the current status.
+	ORR R1, R0, #0x80					; Set the I bit.
+	MSR CPSR_c, R1
+	AND R0, R0, #0x80					; Return the I bit as it was.
+	BX LR
+
+vPortClearInterruptMask
+
+	PRESERVE8
+
+	MRS R1, CPSR
+	BIC R1, R1, #0x80					; Clear the I bit, then set it again
+	ORR R1, R1, R0						; if it was set when the mask was taken.
+	MSR CPSR_c, R1
+	BX LR
+
 	END
 
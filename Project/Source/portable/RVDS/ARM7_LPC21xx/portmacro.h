@@ -129,6 +129,35 @@ extern void vPortExitCritical( void );
 
 #define portENTER_CRITICAL()		vPortEnterCritical();
 #define portEXIT_CRITICAL()			vPortExitCritical();
+
+/* Masking for code that can run in a task or an ISR, such as the trace
+recorder.  A critical section cannot be used from an ISR, as leaving it would
+enable IRQ inside the ISR.  Both functions are in portASM.s, as they must run
+in ARM state to write the CPSR. */
+extern unsigned long ulPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( unsigned long ulMask );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		ulPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )	vPortClearInterruptMask( x )
+/*-----------------------------------------------------------*/
+
+/* Run time stats.  Timer1 runs freely at configRUN_TIME_COUNTER_HZ, which
+defaults to configCPU_CLOCK_HZ, and is extended to 64 bits in software.  Set
+configRUN_TIME_COUNTER_TYPE to uint64_t to keep the upper bits.  An application
+that defines portGET_RUN_TIME_COUNTER_VALUE() itself keeps its own counter. */
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && !defined( portGET_RUN_TIME_COUNTER_VALUE )
+	extern void vPortConfigureRunTimeCounter( void );
+	extern uint64_t ullPortGetRunTimeCounterValue( void );
+	#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortConfigureRunTimeCounter()
+	#define portGET_RUN_TIME_COUNTER_VALUE()			ullPortGetRunTimeCounterValue()
+#endif
+/*-----------------------------------------------------------*/
+
+/* Tickless idle/low power functionality. */
+#if configUSE_TICKLESS_IDLE == 1
+	extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
 /*-----------------------------------------------------------*/
 
 /* Compiler specifics. */
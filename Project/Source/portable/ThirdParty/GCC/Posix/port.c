@@ -57,7 +57,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/time.h>
-#include <sys/times.h>
 #include <time.h>
 
 /* Scheduler includes. */
@@ -111,6 +110,9 @@ static void prvSuspendSelf( Thread_t * thread);
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
 static void vPortStartFirstTask( void );
+#if ( configUSE_TICKLESS_IDLE == 1 )
+static void prvSetTimerCountDown( uint64_t ullCountDownUs );
+#endif
 /*-----------------------------------------------------------*/
 
 static void prvFatalError( const char *pcCall, int iErrno )
@@ -327,6 +329,9 @@ struct timespec t;
 }
 
 static uint64_t prvStartTimeNs;
+
+/* The monotonic time the run time counter counts from. */
+static uint64_t prvRunTimeStartNs;
 /* commented as part of the code below in vPortSystemTickHandler,
  * to adjust timing according to full demo requirements */
 /* static uint64_t prvTickCount; */
@@ -366,6 +371,36 @@ int iRet;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/*
+ * Restart the timer so the next tick signal is ullCountDownUs away, with
+ * normal tick periods from then on.
+ */
+static void prvSetTimerCountDown( uint64_t ullCountDownUs )
+{
+struct itimerval itimer;
+
+    /* A zero count-down would stop the timer. */
+    if( ullCountDownUs == 0 )
+    {
+        ullCountDownUs = 1;
+    }
+
+    itimer.it_value.tv_sec = ( time_t ) ( ullCountDownUs / 1000000ull );
+    itimer.it_value.tv_usec = ( suseconds_t ) ( ullCountDownUs % 1000000ull );
+    itimer.it_interval.tv_sec = 0;
+    itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+
+    if ( setitimer( ITIMER_REAL, &itimer, NULL ) )
+    {
+        prvFatalError( "setitimer", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 static void vPortSystemTickHandler( int sig )
 {
 Thread_t *pxThreadToSuspend;
@@ -403,6 +438,115 @@ Thread_t *pxThreadToResume;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+/*
+ * The interval timer stands in for a one-shot compare: its count-down is
+ * extended to the end of the expected idle time and the idle thread waits
+ * for the timer signal, or for any other signal (simulated interrupt), instead
+ * of handling every tick.
+ */
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+struct itimerval itimer;
+sigset_t xPendingSignals;
+sigset_t xWakeSignals;
+uint64_t ullSleepStartNs;
+uint64_t ullRemainingUs;
+uint64_t ullElapsedUs;
+TickType_t xCompleteTickPeriods;
+TickType_t xModifiableIdleTime;
+int iSignal = 0;
+
+    vPortEnterCritical();
+
+    (void)sigpending( &xPendingSignals );
+
+    /* Abandon the sleep if a task was made ready while the scheduler was
+     * suspended or the tick signal is already waiting to be handled. */
+    if( ( eTaskConfirmSleepModeStatus() == eAbortSleep ) ||
+        ( sigismember( &xPendingSignals, SIGALRM ) == 1 ) )
+    {
+        vPortExitCritical();
+    }
+    else
+    {
+        /* Extend the count-down of the tick period in progress by the rest of
+         * the idle time.  The interval reloads a normal tick period once it
+         * expires. */
+        (void)getitimer( ITIMER_REAL, &itimer );
+        ullRemainingUs = ( uint64_t ) itimer.it_value.tv_sec * 1000000ull + ( uint64_t ) itimer.it_value.tv_usec;
+        prvSetTimerCountDown( ullRemainingUs + ( uint64_t ) ( xExpectedIdleTime - 1 ) * portTICK_RATE_MICROSECONDS );
+        ullSleepStartNs = prvGetTimeNs();
+
+        xModifiableIdleTime = xExpectedIdleTime;
+        configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+        if( xModifiableIdleTime > 0 )
+        {
+            /* Signals are blocked, so the one that ends the sleep is
+             * accepted here rather than by its handler. */
+            xWakeSignals = xAllSignals;
+            sigdelset( &xWakeSignals, SIG_RESUME );
+            (void)sigwait( &xWakeSignals, &iSignal );
+        }
+
+        configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        if( iSignal == SIGALRM )
+        {
+            /* The whole expected idle time has passed.  The tick handler
+             * counts the last tick period when the signal is raised again
+             * below. */
+            vTaskStepTick( xExpectedIdleTime - 1 );
+        }
+        else
+        {
+            /* Something else ended the sleep.  Count the tick periods that
+             * have completed and set the timer to expire at the end of the
+             * one in progress, which the tick handler counts as normal. */
+            ullElapsedUs = ( prvGetTimeNs() - ullSleepStartNs ) / 1000ull;
+
+            if( ullElapsedUs < ullRemainingUs )
+            {
+                xCompleteTickPeriods = 0;
+                ullRemainingUs -= ullElapsedUs;
+            }
+            else
+            {
+                ullElapsedUs -= ullRemainingUs;
+                xCompleteTickPeriods = ( TickType_t ) ( 1 + ullElapsedUs / portTICK_RATE_MICROSECONDS );
+                ullRemainingUs = portTICK_RATE_MICROSECONDS - ( ullElapsedUs % portTICK_RATE_MICROSECONDS );
+            }
+
+            if( xCompleteTickPeriods < xExpectedIdleTime )
+            {
+                prvSetTimerCountDown( ullRemainingUs );
+            }
+            else
+            {
+                /* The timer expired as the sleep ended and its signal is
+                 * pending, so it counts the last tick period. */
+                xCompleteTickPeriods = xExpectedIdleTime - 1;
+            }
+
+            vTaskStepTick( xCompleteTickPeriods );
+        }
+
+        /* Hand the signal that ended the sleep to its handler, which runs as
+         * soon as signals are unblocked. */
+        if( iSignal != 0 )
+        {
+            (void)pthread_kill( pthread_self(), iSignal );
+        }
+
+        vPortExitCritical();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield )
 {
 Thread_t *pxThread = prvGetThreadFromTask( pxTaskToDelete );
@@ -553,12 +697,16 @@ int iRet;
 }
 /*-----------------------------------------------------------*/
 
-unsigned long ulPortGetRunTime( void )
+void vPortConfigureRunTimeCounter( void )
 {
-struct tms xTimes;
-
-    times( &xTimes );
+    prvRunTimeStartNs = prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
 
-    return ( unsigned long ) xTimes.tms_utime;
+unsigned long ulPortGetRunTime( void )
+{
+    /* Wall clock time rather than the CPU time of the process, as the tasks
+     * share the processor with whatever else the host runs. */
+    return ( unsigned long ) ( ( prvGetTimeNs() - prvRunTimeStartNs ) / 1000ull );
 }
 /*-----------------------------------------------------------*/
@@ -124,8 +124,19 @@ extern void vPortCancelThread( void *pxTaskToDelete );
  */
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+/* Tickless idle/low power functionality. */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
+/* The run time counter counts microseconds of CLOCK_MONOTONIC from the start of
+ * the scheduler.  unsigned long is 64 bits on LP64 hosts, set
+ * configRUN_TIME_COUNTER_TYPE to uint64_t to keep all of them. */
+extern void vPortConfigureRunTimeCounter( void );
 extern unsigned long ulPortGetRunTime( void );
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vPortConfigureRunTimeCounter()
 #define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
 
 #ifdef __cplusplus
@@ -0,0 +1,291 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the virtual time
+ * port.
+ *
+ * Every task runs on its own ucontext stack within the one host thread, and a
+ * context switch is a swapcontext() made from vPortYield().  There is no
+ * interrupt: the tick is processed in the running task when the virtual clock
+ * reaches a tick boundary, which only happens inside vPortSimulateExecution(),
+ * vPortSimulateIdle() and vPortSuppressTicksAndSleep().  The order in which the
+ * kernel makes its decisions is therefore fully determined by the task set and
+ * the execution times the application simulates.
+ *----------------------------------------------------------*/
+
+/* Standard includes. */
+#include <stdint.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* The state of a task kept by the port.  It is placed at the top of the stack
+ * of the task, and pxTopOfStack points at it. */
+typedef struct SIM_TASK_CONTEXT
+{
+    ucontext_t xContext;            /*< The saved registers and stack of the task. */
+    UBaseType_t uxCriticalNesting;  /*< The critical nesting depth of the task while it is switched out. */
+    TaskFunction_t pxCode;          /*< The function that implements the task. */
+    void * pvParameters;            /*< The value passed to pxCode. */
+} SimTaskContext_t;
+
+/* The context vPortEndScheduler() returns to. */
+static ucontext_t xSchedulerContext;
+
+/* The critical nesting depth of the running task. */
+static UBaseType_t uxCriticalNesting = 0;
+
+static BaseType_t xSchedulerRunning = pdFALSE;
+
+/* The virtual time now, of the next tick and at which the simulation ends,
+ * all in microseconds. */
+static uint64_t ullTimeNow = 0;
+static uint64_t ullNextTickTime = portTICK_PERIOD_US;
+static uint64_t ullEndTime = UINT64_MAX;
+
+/*
+ * The first function run by each task.
+ */
+static void prvTaskEntry( void );
+
+/*
+ * Process the tick at ullNextTickTime, which must be the current time, and
+ * switch to the task it makes the one to run.
+ */
+static void prvProcessTick( void );
+
+/*
+ * Return to vTaskStartScheduler() if the end of the simulation has been
+ * reached.
+ */
+static void prvCheckForEnd( void );
+
+/*-----------------------------------------------------------*/
+
+static SimTaskContext_t * prvCurrentContext( void )
+{
+    /* pxTopOfStack is the first member of the TCB. */
+    return *( SimTaskContext_t ** ) xTaskGetCurrentTaskHandle();
+}
+/*-----------------------------------------------------------*/
+
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     StackType_t * pxEndOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    SimTaskContext_t * pxTaskContext;
+    uintptr_t uxTop = ( uintptr_t ) ( pxTopOfStack + 1 );
+
+    pxTaskContext = ( SimTaskContext_t * ) ( ( uxTop - sizeof( SimTaskContext_t ) ) & ~( ( uintptr_t ) portBYTE_ALIGNMENT_MASK ) );
+    configASSERT( ( uintptr_t ) pxTaskContext > ( uintptr_t ) pxEndOfStack );
+
+    pxTaskContext->uxCriticalNesting = 0;
+    pxTaskContext->pxCode = pxCode;
+    pxTaskContext->pvParameters = pvParameters;
+
+    ( void ) getcontext( &( pxTaskContext->xContext ) );
+    pxTaskContext->xContext.uc_stack.ss_sp = pxEndOfStack;
+    pxTaskContext->xContext.uc_stack.ss_size = ( size_t ) ( ( uintptr_t ) pxTaskContext - ( uintptr_t ) pxEndOfStack );
+    pxTaskContext->xContext.uc_link = NULL;
+    makecontext( &( pxTaskContext->xContext ), prvTaskEntry, 0 );
+
+    return ( StackType_t * ) pxTaskContext;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+    SimTaskContext_t * pxTaskContext = prvCurrentContext();
+
+    uxCriticalNesting = 0;
+    pxTaskContext->pxCode( pxTaskContext->pvParameters );
+
+    /* A task must not return from its function, delete it as the closest
+     * equivalent to what the target would do. */
+    vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+    ullNextTickTime = ullTimeNow + portTICK_PERIOD_US;
+    uxCriticalNesting = 0;
+    xSchedulerRunning = pdTRUE;
+
+    /* Run the first task, this returns when vPortEndScheduler() is called. */
+    ( void ) swapcontext( &xSchedulerContext, &( prvCurrentContext()->xContext ) );
+
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+    xSchedulerRunning = pdFALSE;
+    ( void ) setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    SimTaskContext_t * pxPrevious, * pxNext;
+
+    /* Once the scheduler has ended only the context of main() remains. */
+    if( xSchedulerRunning == pdFALSE )
+    {
+        return;
+    }
+
+    pxPrevious = prvCurrentContext();
+    pxPrevious->uxCriticalNesting = uxCriticalNesting;
+
+    vTaskSwitchContext();
+    pxNext = prvCurrentContext();
+
+    if( pxNext != pxPrevious )
+    {
+        ( void ) swapcontext( &( pxPrevious->xContext ), &( pxNext->xContext ) );
+    }
+
+    /* Running again, possibly after other tasks changed the depth. */
+    uxCriticalNesting = prvCurrentContext()->uxCriticalNesting;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+    configASSERT( uxCriticalNesting > 0 );
+    uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckForEnd( void )
+{
+    if( ullTimeNow >= ullEndTime )
+    {
+        ullTimeNow = ullEndTime;
+        vTaskEndScheduler();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessTick( void )
+{
+    ullNextTickTime += portTICK_PERIOD_US;
+
+    if( xTaskIncrementTick() != pdFALSE )
+    {
+        vPortYield();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateExecution( uint64_t ullMicroseconds )
+{
+    uint64_t ullSlice;
+
+    /* The tick cannot interrupt a critical section. */
+    configASSERT( uxCriticalNesting == 0 );
+
+    while( ullMicroseconds > 0 )
+    {
+        ullSlice = ullNextTickTime - ullTimeNow;
+
+        if( ullSlice > ullMicroseconds )
+        {
+            ullSlice = ullMicroseconds;
+        }
+
+        if( ullTimeNow + ullSlice > ullEndTime )
+        {
+            ullSlice = ullEndTime - ullTimeNow;
+        }
+
+        ullTimeNow += ullSlice;
+        ullMicroseconds -= ullSlice;
+        prvCheckForEnd();
+
+        if( ullTimeNow == ullNextTickTime )
+        {
+            prvProcessTick();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateIdle( void )
+{
+    configASSERT( uxCriticalNesting == 0 );
+
+    ullTimeNow = ullNextTickTime;
+    prvCheckForEnd();
+    prvProcessTick();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        /* The kernel calls this with the scheduler suspended, so the tick
+         * that ends the sleep is held pending until xTaskResumeAll(), as it
+         * would be on the target with interrupts disabled. */
+        if( eTaskConfirmSleepModeStatus() != eAbortSleep )
+        {
+            ullTimeNow = ullNextTickTime + ( ( uint64_t ) ( xExpectedIdleTime - 1 ) * portTICK_PERIOD_US );
+            prvCheckForEnd();
+
+            vTaskStepTick( xExpectedIdleTime - 1 );
+            ullNextTickTime = ullTimeNow;
+            prvProcessTick();
+        }
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetSimulatedTime( void )
+{
+    return ullTimeNow;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetSimulationEnd( uint64_t ullMicroseconds )
+{
+    ullEndTime = ullMicroseconds;
+}
@@ -101,6 +101,12 @@
 #define tskDELETED_CHAR      ( 'D' )
 #define tskSUSPENDED_CHAR    ( 'S' )
 
+/*
+ * The space uxTaskStreamStats() needs for one record, enough for the name and
+ * six numbers of up to 20 digits with their separators.
+ */
+#define tskSTATS_RECORD_LENGTH    ( configMAX_TASK_NAME_LEN + 96 )
+
 /*
  * Some kernel aware debuggers require the data the debugger needs access to to
  * be global, rather than file scope.
@@ -228,7 +234,240 @@
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 		
 #else
-	#define prvAddTaskToReadyList( pxTCB )			vListInsert( &(xReadyTasksListEDF), &( ( pxTCB )->xStateListItem ) )
+	/* The ready queue is ordered by taskEDF_EARLIER_DEADLINE() rather than by
+	 * the value of the state list item, which cannot order deadlines across a
+	 * wrap of the tick count. */
+	#if ( configEDF_USE_READY_HEAP == 1 )
+		#define prvEDFInsertReadyTask( pxTCB )		prvEDFReadyHeapInsert( pxTCB )
+	#else
+		#define prvEDFInsertReadyTask( pxTCB )		prvEDFInsertByDeadline( &( xReadyTasksListEDF ), ( pxTCB ) )
+	#endif
+
+	/* A job that has overrun its budget is demoted to the background along
+	 * with the idle priority tasks, unless the overrun policy only notifies. */
+	#if ( ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 ) && ( configEDF_OVERRUN_POLICY != tskOVERRUN_NOTIFY ) )
+		#define taskEDF_IN_BACKGROUND( pxTCB ) \
+    ( ( ( pxTCB )->uxPriority == tskIDLE_PRIORITY ) || ( ( pxTCB )->ucBudgetExhausted != pdFALSE ) )
+	#else
+		#define taskEDF_IN_BACKGROUND( pxTCB )		( ( pxTCB )->uxPriority == tskIDLE_PRIORITY )
+	#endif
+
+	#if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+		/* pdTRUE if the Ready tasks of priority uxPriority form an EDF band, and
+		 * so are ordered by deadline rather than run in turn. */
+		#define taskEDF_BAND_IS_EDF( uxPriority ) \
+    ( ( ( ( uint32_t ) ( configEDF_BAND_MASK ) >> ( uxPriority ) ) & 1UL ) != 0UL )
+
+		/* Each priority keeps its own ready list, as without EDF.  The list
+		 * of an EDF band is sorted by deadline, and a job that has overrun
+		 * its budget is demoted to the idle priority.  The idle task never
+		 * leaves its ready list, so the idle priority is always recorded as
+		 * ready and a demoted job does not need to record it. */
+		#define prvAddTaskToReadyList( pxTCB )                                                                 \
+    {                                                                                                      \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+        if( taskEDF_IN_BACKGROUND( pxTCB ) )                                                               \
+        {                                                                                                  \
+            listINSERT_END( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ), &( ( pxTCB )->xStateListItem ) );  \
+        }                                                                                                  \
+        else if( taskEDF_BAND_IS_EDF( ( pxTCB )->uxPriority ) )                                            \
+        {                                                                                                  \
+            taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                            \
+            prvEDFInsertByDeadline( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), ( pxTCB ) );          \
+        }                                                                                                  \
+        else                                                                                               \
+        {                                                                                                  \
+            taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                            \
+            listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                  \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+    }
+	#else
+		/* The idle task, and any other task created at the idle priority, is
+		 * kept out of the EDF ready queue in the idle priority ready list, so it
+		 * only runs when no job is Ready. */
+		#define prvAddTaskToReadyList( pxTCB )                                                                \
+    {                                                                                                     \
+        traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                          \
+        if( taskEDF_IN_BACKGROUND( pxTCB ) )                                                              \
+        {                                                                                                 \
+            listINSERT_END( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                 \
+        else                                                                                              \
+        {                                                                                                 \
+            prvEDFInsertReadyTask( pxTCB );                                                               \
+        }                                                                                                 \
+        tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                     \
+    }
+	#endif /* configUSE_EDF_PRIORITY_BANDS */
+#endif
+
+/*
+ * The deadline a task is scheduled by, which is the deadline of its current
+ * job unless an earlier one was inherited through a mutex it holds.  A task
+ * with neither, such as a task that is not periodic, has no deadline and runs
+ * after every task that has one.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	/* pdTRUE if xDeadline comes before xOtherDeadline.  Deadlines are compared
+	 * by their distance from each other rather than by their value, so the
+	 * order holds when the tick count wraps between them, as long as they are
+	 * less than half the range of the tick count apart. */
+	#define taskEDF_DEADLINE_IS_BEFORE( xDeadline, xOtherDeadline ) \
+    ( ( TickType_t ) ( ( xDeadline ) - ( xOtherDeadline ) ) > ( portMAX_DELAY >> 1 ) )
+
+	#if ( configUSE_MUTEXES == 1 )
+		#define taskEDF_DEADLINE_IS_INHERITED( pxTCB )                                    \
+    ( ( ( pxTCB )->ucInheritsDeadline != pdFALSE ) &&                                     \
+      ( ( ( pxTCB )->ucHasDeadline == pdFALSE ) ||                                        \
+        taskEDF_DEADLINE_IS_BEFORE( ( pxTCB )->xInheritedDeadline, ( pxTCB )->xTaskAbsoluteDeadline ) ) )
+		#define taskEDF_HAS_SCHEDULING_DEADLINE( pxTCB ) \
+    ( ( ( pxTCB )->ucHasDeadline != pdFALSE ) || ( ( pxTCB )->ucInheritsDeadline != pdFALSE ) )
+		#define taskEDF_SCHEDULING_DEADLINE( pxTCB ) \
+    ( taskEDF_DEADLINE_IS_INHERITED( pxTCB ) ? ( pxTCB )->xInheritedDeadline : ( pxTCB )->xTaskAbsoluteDeadline )
+	#else
+		#define taskEDF_HAS_SCHEDULING_DEADLINE( pxTCB )	( ( pxTCB )->ucHasDeadline != pdFALSE )
+		#define taskEDF_SCHEDULING_DEADLINE( pxTCB )		( ( pxTCB )->xTaskAbsoluteDeadline )
+	#endif
+
+	/* pdTRUE if pxTCB is scheduled by an earlier deadline than pxOtherTCB, or
+	 * has a deadline and pxOtherTCB has none. */
+	#define taskEDF_EARLIER_DEADLINE( pxTCB, pxOtherTCB )                                 \
+    ( taskEDF_HAS_SCHEDULING_DEADLINE( pxTCB ) &&                                         \
+      ( !taskEDF_HAS_SCHEDULING_DEADLINE( pxOtherTCB ) ||                                 \
+        taskEDF_DEADLINE_IS_BEFORE( taskEDF_SCHEDULING_DEADLINE( pxTCB ), taskEDF_SCHEDULING_DEADLINE( pxOtherTCB ) ) ) )
+#endif
+
+/*
+ * Remove the task represented by pxTCB from whichever state list it is
+ * referenced from, returning the number of items left in that list.  When the
+ * EDF ready tasks are held in a heap a Ready task must leave the heap too.
+ */
+#if ( configEDF_USE_READY_HEAP == 1 )
+	#define prvRemoveTaskFromStateList( pxTCB )		prvEDFReadyHeapRemove( pxTCB )
+#else
+	#define prvRemoveTaskFromStateList( pxTCB )		uxListRemove( &( ( pxTCB )->xStateListItem ) )
+#endif
+
+/*
+ * Select the Ready task with the earliest deadline.  With the heap backend the
+ * earliest deadline is always at the root, otherwise it is at the head of the
+ * sorted ready list.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+	#if ( configEDF_USE_READY_HEAP == 1 )
+		#define taskGET_EARLIEST_DEADLINE_TCB()			pxEDFReadyHeap[ 0 ]
+	#else
+		#define taskGET_EARLIEST_DEADLINE_TCB()			( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xReadyTasksListEDF ) ) )
+	#endif
+
+	/* The heap backend keeps xReadyTasksListEDF too, so either can be tested
+	 * for Ready jobs. */
+	#define taskEDF_READY_QUEUE_IS_EMPTY()			listLIST_IS_EMPTY( &( xReadyTasksListEDF ) )
+#endif
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_PRIORITY_BANDS == 1 ) )
+	/* The band a task is scheduled in, which is its priority unless it has
+	 * been demoted to the background. */
+	#define taskEDF_BAND( pxTCB )		( taskEDF_IN_BACKGROUND( pxTCB ) ? ( UBaseType_t ) tskIDLE_PRIORITY : ( pxTCB )->uxPriority )
+
+	/* pdTRUE if pxTCB is in the ready list of its band, rather than Blocked,
+	 * Suspended or demoted to the background. */
+	#define taskEDF_IS_IN_READY_QUEUE( pxTCB )                                                  \
+    ( ( ( pxTCB )->uxPriority != tskIDLE_PRIORITY ) &&                                          \
+      ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ) != pdFALSE ) )
+
+	/* pdTRUE if pxTCB should run before pxOtherTCB, that is if it is in a
+	 * higher band, or in the same EDF band with an earlier deadline.  Tasks in
+	 * the same fixed priority band do not preempt each other. */
+	#define taskEDF_RUNS_BEFORE( pxTCB, pxOtherTCB )                                                \
+    ( ( taskEDF_BAND( pxTCB ) > taskEDF_BAND( pxOtherTCB ) ) ||                                     \
+      ( ( taskEDF_BAND( pxTCB ) == taskEDF_BAND( pxOtherTCB ) ) &&                                  \
+        taskEDF_BAND_IS_EDF( taskEDF_BAND( pxTCB ) ) &&                                             \
+        taskEDF_EARLIER_DEADLINE( pxTCB, pxOtherTCB ) ) )
+
+	/* Find the highest band with a Ready task, as the fixed priority
+	 * scheduler finds the highest priority. */
+	#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		#define taskEDF_FIND_TOP_BAND( uxTopPriority )                            \
+    {                                                                             \
+        uxTopPriority = uxTopReadyPriority;                                       \
+                                                                                  \
+        while( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopPriority ] ) ) )     \
+        {                                                                         \
+            configASSERT( uxTopPriority );                                        \
+            --uxTopPriority;                                                      \
+        }                                                                         \
+                                                                                  \
+        uxTopReadyPriority = uxTopPriority;                                       \
+    }
+	#else
+		#define taskEDF_FIND_TOP_BAND( uxTopPriority )		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority )
+	#endif
+
+	/* The job with the earliest deadline is at the head of an EDF band, the
+	 * tasks of a fixed priority band take turns as they do without EDF. */
+	#define taskSELECT_EARLIEST_DEADLINE_TASK()                                                          \
+    {                                                                                                    \
+        UBaseType_t uxTopPriority;                                                                       \
+                                                                                                         \
+        taskEDF_FIND_TOP_BAND( uxTopPriority );                                                          \
+                                                                                                         \
+        if( taskEDF_BAND_IS_EDF( uxTopPriority ) )                                                       \
+        {                                                                                                \
+            pxCurrentTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        }                                                                                                \
+        else                                                                                             \
+        {                                                                                                \
+            listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );        \
+        }                                                                                                \
+    }
+#elif ( configUSE_EDF_SCHEDULER == 1 )
+	#define taskEDF_IS_IN_READY_QUEUE( pxTCB )		( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( ( pxTCB )->xStateListItem ) ) != pdFALSE )
+
+	/* pdTRUE if pxTCB should run before pxOtherTCB, that is if pxTCB is in the
+	 * ready queue and pxOtherTCB is either in the background or has a later
+	 * deadline.  Equal deadlines do not preempt each other. */
+	#define taskEDF_RUNS_BEFORE( pxTCB, pxOtherTCB )                                   \
+    ( ( !taskEDF_IN_BACKGROUND( pxTCB ) ) &&                                           \
+      ( taskEDF_IN_BACKGROUND( pxOtherTCB ) ||                                         \
+        taskEDF_EARLIER_DEADLINE( pxTCB, pxOtherTCB ) ) )
+
+	#define taskSELECT_EARLIEST_DEADLINE_TASK()                                                       \
+    {                                                                                                 \
+        if( taskEDF_READY_QUEUE_IS_EMPTY() != pdFALSE )                                               \
+        {                                                                                             \
+            /* The idle priority list always holds at least the idle task. */                         \
+            listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ); \
+        }                                                                                             \
+        else                                                                                          \
+        {                                                                                             \
+            pxCurrentTCB = taskGET_EARLIEST_DEADLINE_TCB();                                           \
+        }                                                                                             \
+    }
+#endif
+
+/*
+ * Select the task that owns the current slot of the time-triggered schedule
+ * if it is Ready.  Otherwise, in an idle slot or once the job of the slot has
+ * completed, the time is given to the other tasks by priority.
+ */
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+	#define taskTT_SLOT_TASK_IS_READY()                                                                          \
+    ( ( pxTTSlotTCB != NULL ) &&                                                                             \
+      ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTTSlotTCB->uxPriority ] ), &( pxTTSlotTCB->xStateListItem ) ) != pdFALSE ) )
+
+	#define taskSELECT_TIME_TRIGGERED_TASK()       \
+    {                                              \
+        if( taskTT_SLOT_TASK_IS_READY() )          \
+        {                                          \
+            pxCurrentTCB = pxTTSlotTCB;            \
+        }                                          \
+        else                                       \
+        {                                          \
+            taskSELECT_HIGHEST_PRIORITY_TASK();    \
+        }                                          \
+    }
 #endif
 	
 		
@@ -274,8 +513,79 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     StackType_t * pxStack;                      /*< Points to the start of the stack. */
     char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 	
-		#if ( configUSE_EDF_SCHEDULER == 1 )
+		#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
 				TickType_t xTaskPeriod;       /*< Stores the period in tick of the task. > */
+				TickType_t xTaskRelativeDeadline; /*< Stores the deadline of each job relative to its release, in ticks. */
+				TickType_t xTaskAbsoluteDeadline; /*< The deadline of the current job, its release time plus the relative deadline.  Unchanged while the job blocks. */
+				TickType_t xTaskNextRelease; /*< The release time of the next job waited for by xTaskWaitForNextPeriod(). */
+				UBaseType_t uxJobsReleased;  /*< The number of jobs released by xTaskWaitForNextPeriod(). */
+				TickType_t xTaskWcet;        /*< Stores the declared worst case execution time of each job, in ticks. */
+				TickType_t xMaxLateness;     /*< The largest number of ticks by which a job completed after its deadline. */
+				UBaseType_t uxDeadlineMisses; /*< The number of jobs that missed their deadline. */
+				uint8_t ucDeadlineMissed;    /*< Set to pdTRUE once the miss of the current job has been counted. */
+				uint8_t ucHasDeadline;       /*< Set to pdTRUE while the task has a job, and so xTaskAbsoluteDeadline is valid. */
+				#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+					UBaseType_t uxAssignedPriority; /*< The priority given to the task from its rank in the periodic task set. */
+					struct tskTaskControlBlock * pxNextPeriodicTCB; /*< Links the periodic tasks in rank order. */
+				#endif
+		#endif
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+				TickType_t xPendingPeriod;   /*< The period the task takes at the end of its current job, 0 if it is not being changed. */
+				TickType_t xPendingRelativeDeadline; /*< The relative deadline the task takes with xPendingPeriod. */
+				#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+					uint32_t ulTaskUtilisation; /*< The utilisation claimed by the task, scaled by tskUTILISATION_SCALE. */
+					uint32_t ulPendingClaim;    /*< Utilisation claimed on top of ulTaskUtilisation until a pending change of the task's timing is made. */
+					struct tskTaskControlBlock * pxNextAdmittedTCB; /*< Links the tasks accepted by the admission test. */
+				#endif
+				#if ( configUSE_EDF_CBS == 1 )
+					TickType_t xCBSBudget;       /*< Budget left to the constant bandwidth server before its deadline is postponed. */
+					TickType_t xCBSMaxBudget;    /*< Budget of the constant bandwidth server per period, 0 if the task is not a server. */
+					uint8_t ucCBSServerIdle;     /*< Set to pdTRUE while the server has no job to run. */
+				#endif
+				#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+					TickType_t xTaskLastArrival;  /*< The time of the last release request, used to check the minimum inter-arrival time. */
+					TickType_t xPendingArrivals[ configEDF_SPORADIC_QUEUE_LENGTH ]; /*< The times the pending release requests arrived, a ring starting at uxPendingHead. */
+					UBaseType_t uxPendingHead;     /*< The index in xPendingArrivals of the oldest pending request. */
+					UBaseType_t uxPendingReleases; /*< The number of release requests the task has not yet waited for. */
+					UBaseType_t uxSeparationViolations; /*< The number of release requests that came before the minimum inter-arrival time had elapsed. */
+					uint8_t ucTaskSporadic;      /*< Set to pdTRUE if the task was created by xTaskSporadicCreate(). */
+					uint8_t ucWaitingForRelease; /*< Set to pdTRUE while the task is blocked waiting to be released. */
+				#endif
+				#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+					configRUN_TIME_COUNTER_TYPE ulJobExecutionTime; /*< The run time charged to the current job. */
+					configRUN_TIME_COUNTER_TYPE ulJobBudget;        /*< The run time each job may use, 0 if it is not enforced. */
+					UBaseType_t uxBudgetOverruns;                   /*< The number of jobs that exceeded the budget. */
+					uint8_t ucBudgetExhausted;                      /*< Set to pdTRUE once the current job has exceeded the budget. */
+				#endif
+				#if ( configUSE_EDF_JOB_STATISTICS == 1 )
+					TaskJobStatistics_t xJobStatistics; /*< Response time and start delay of the jobs completed so far. */
+					TickType_t xJobStartTime;    /*< The tick at which the current job first ran. */
+					uint8_t ucJobStarted;        /*< Set to pdFALSE from the release of a job until it first runs. */
+				#endif
+				#if ( configUSE_EDF_MODE_CHANGES == 1 )
+					TickType_t xModePeriod;      /*< The period the task takes at the end of its current job, 0 if it is disabled then. */
+					TickType_t xModeRelativeDeadline; /*< The relative deadline the task takes at the end of its current job. */
+					TickType_t xModeWcet;        /*< The worst case execution time the task takes at the end of its current job. */
+					uint8_t ucModeChangePending; /*< Set to pdTRUE from a mode change request until the task has taken the new parameters. */
+					uint8_t ucModeDisabled;      /*< Set to pdTRUE while the current mode does not run the task. */
+					uint8_t ucWaitingForMode;    /*< Set to pdTRUE while the task is blocked until a mode enables it. */
+				#endif
+				#if ( configUSE_MUTEXES == 1 )
+					TickType_t xInheritedDeadline; /*< Earliest deadline of the tasks that blocked on a mutex held by this task. */
+					uint8_t ucInheritsDeadline;    /*< Set to pdTRUE while xInheritedDeadline is valid. */
+				#endif
+				#if ( configEDF_USE_READY_HEAP == 1 )
+					UBaseType_t uxEDFHeapIndex; /*< Position of the task in pxEDFReadyHeap while it is in the Ready state. */
+					UBaseType_t uxEDFHeapSequence; /*< Order in which the task was added to pxEDFReadyHeap, breaks ties between equal deadlines. */
+				#endif
+		#endif
+
+		#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+				UBaseType_t uxSlotOverruns;  /*< The number of jobs still running when the next job of the task was released by the schedule table. */
+				uint8_t ucWaitingForSlot;    /*< Set to pdTRUE while the task is blocked in vTaskWaitForNextSlot(). */
+				uint8_t ucSlotReleasePending; /*< Set to pdTRUE if a job was released while the task was not waiting for it. */
+				uint8_t ucSlotJobActive;     /*< Set to pdTRUE from the release of a job until the task waits for the next one. */
 		#endif
 	
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
@@ -364,6 +674,40 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 
 #if ( configUSE_EDF_SCHEDULER == 1 )
 PRIVILEGED_DATA List_t xReadyTasksListEDF;        /*< Ready tasks orderedby their deadline. */
+PRIVILEGED_DATA static volatile uint32_t ulEDFAvoidedSwitches = 0UL; /*< Number of times a task with a deadline was readied without preempting the running task. */
+#endif
+
+#if ( configEDF_USE_READY_HEAP == 1 )
+/* With the heap backend xReadyTasksListEDF is kept unordered and only records
+ * which tasks are Ready.  The deadline order is held by the binary heap below,
+ * the root of which is the Ready task with the earliest deadline. */
+PRIVILEGED_DATA static TCB_t * pxEDFReadyHeap[ configEDF_READY_HEAP_LENGTH ]; /*< Ready tasks as a binary min-heap keyed by deadline. */
+PRIVILEGED_DATA static UBaseType_t uxEDFReadyHeapLength = ( UBaseType_t ) 0U;  /*< Number of tasks held in pxEDFReadyHeap. */
+PRIVILEGED_DATA static UBaseType_t uxEDFReadyHeapSequence = ( UBaseType_t ) 0U; /*< Counts the insertions into pxEDFReadyHeap. */
+PRIVILEGED_DATA static UBaseType_t uxEDFReadyHeapPlaces = ( UBaseType_t ) 0U;   /*< Number of tasks, other than the idle task, that could be in pxEDFReadyHeap at once. */
+#endif
+
+#if ( configUSE_EDF_MODE_CHANGES == 1 )
+PRIVILEGED_DATA static UBaseType_t uxModeChangesPending = ( UBaseType_t ) 0U; /*< Number of tasks that have not yet taken the parameters of the requested mode. */
+#endif
+
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+PRIVILEGED_DATA static const TimeTriggeredSchedule_t * pxTTSchedule = NULL; /*< The schedule table followed by the dispatcher, NULL until one is set. */
+PRIVILEGED_DATA static TaskHandle_t const * pxTTTasks = NULL;               /*< The tasks named by the slots of the schedule table, by index. */
+PRIVILEGED_DATA static TCB_t * volatile pxTTSlotTCB = NULL;                 /*< The task that owns the current slot, NULL in an idle slot. */
+PRIVILEGED_DATA static UBaseType_t uxTTNextSlot = ( UBaseType_t ) 0U;       /*< Index of the next slot to start. */
+PRIVILEGED_DATA static TickType_t xTTNextSlotTime = ( TickType_t ) 0U;      /*< The tick count at which the next slot starts. */
+#endif
+
+#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+PRIVILEGED_DATA static TCB_t * pxFPPeriodicTasks = NULL; /*< The periodic tasks, highest ranked first. */
+#endif
+
+#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+PRIVILEGED_DATA static TCB_t * pxAdmittedTasks = NULL;                                        /*< Periodic tasks accepted by the admission test that declared an execution time. */
+PRIVILEGED_DATA static uint32_t ulAdmittedUtilisation = 0UL;                                  /*< Sum of the utilisation of the admitted tasks, scaled by tskUTILISATION_SCALE. */
+PRIVILEGED_DATA static UBaseType_t uxAdmittedConstrainedTasks = ( UBaseType_t ) 0U;           /*< Number of admitted tasks whose deadline differs from their period. */
+PRIVILEGED_DATA static UBaseType_t uxTimingChangesPending = ( UBaseType_t ) 0U;               /*< Number of tasks with a change of period or deadline that has not been made yet. */
 #endif
 
 
@@ -553,6 +897,25 @@ static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
     static char * prvWriteNameToBuffer( char * pcBuffer,
                                         const char * pcTaskName ) PRIVILEGED_FUNCTION;
 
+/*
+ * Helper functions used by uxTaskStreamStats().  prvStatsNextTaskInList()
+ * returns whichever of pxNextTCB and the tasks referenced from pxList has the
+ * lowest task number above uxAfter, without moving the index of the list.
+ * prvStatsWriteDecimal() and prvStatsWriteVarint() write a number in ASCII or
+ * as an LEB128 varint and return the new end of the record.
+ */
+    static TCB_t * prvStatsNextTaskInList( List_t * pxList,
+                                           UBaseType_t uxAfter,
+                                           TCB_t * pxNextTCB,
+                                           eTaskState eListState,
+                                           eTaskState * peState ) PRIVILEGED_FUNCTION;
+
+    static uint8_t * prvStatsWriteDecimal( uint8_t * pucRecord,
+                                           uint64_t ullValue ) PRIVILEGED_FUNCTION;
+
+    static uint8_t * prvStatsWriteVarint( uint8_t * pucRecord,
+                                          uint64_t ullValue ) PRIVILEGED_FUNCTION;
+
 #endif
 
 /*
@@ -574,6 +937,309 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Binary heap operations used to hold the EDF ready tasks in deadline order
+ * when configEDF_USE_READY_HEAP is 1.  Insertion and removal are O(log n),
+ * reading the task with the earliest deadline is O(1).  All must be called
+ * with interrupts masked or from the tick interrupt.
+ */
+#if ( configEDF_USE_READY_HEAP == 1 )
+
+    static void prvEDFReadyHeapInsert( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvEDFReadyHeapRemove( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Any task but the idle task can be Ready at the same time as all the others,
+ * so the heap needs a place for each.  prvEDFReserveReadyHeapPlace() takes a
+ * place for a task about to be created with the function pxTaskCode, and
+ * returns pdFALSE if every place is taken, in which case the task must not be
+ * created.  The place is given back when the task is deleted.
+ */
+    static BaseType_t prvEDFReserveReadyHeapPlace( TaskFunction_t pxTaskCode ) PRIVILEGED_FUNCTION;
+
+    #define taskEDF_RESERVE_READY_HEAP_PLACE( pxTaskCode )    prvEDFReserveReadyHeapPlace( pxTaskCode )
+#else
+    #define taskEDF_RESERVE_READY_HEAP_PLACE( pxTaskCode )    pdTRUE
+#endif
+
+/*
+ * Insert pxTCB into pxList behind every task with an earlier or the same
+ * deadline, so tasks with equal deadlines are served first in, first out.
+ * Used for the sorted EDF ready list and for the ready lists of EDF bands.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configEDF_USE_READY_HEAP == 0 ) )
+
+    static void prvEDFInsertByDeadline( List_t * const pxList,
+                                        TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Compare xTimeNow against the absolute deadline of the current job of pxTCB.
+ * The first time a job is found to be late the miss is counted and reported
+ * through traceTASK_DEADLINE_MISSED() and vApplicationDeadlineMissHook().
+ * xJobCompleted is pdTRUE when the job has just finished, in which case the
+ * lateness is recorded and the next job starts with a clean slate.
+ */
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
+
+    static void prvCheckForDeadlineMiss( TCB_t * const pxTCB,
+                                         const TickType_t xTimeNow,
+                                         const BaseType_t xJobCompleted ) PRIVILEGED_FUNCTION;
+
+/*
+ * Run the admission test, if enabled, for the task described by
+ * pxTaskDefinition and create it if it is admitted.  xSporadic is pdTRUE if
+ * xPeriod is the minimum inter-arrival time of a sporadic task.
+ */
+    static BaseType_t prvAdmitPeriodicTask( const PeriodicTaskParameters_t * const pxTaskDefinition,
+                                            const BaseType_t xSporadic,
+                                            TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate, initialise and make ready a task described by pxTaskDefinition.
+ * Called by prvAdmitPeriodicTask() once the task has been admitted.
+ */
+    static BaseType_t prvCreatePeriodicTask( const PeriodicTaskParameters_t * const pxTaskDefinition,
+                                             const BaseType_t xSporadic,
+                                             TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+#endif /* tskPERIODIC_TASKS_SUPPORTED */
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/*
+ * Move pxTCB to the position given by its scheduling deadline if it is in the
+ * ready queue, after its job deadline or inherited deadline has changed.
+ * Must be called from a critical section, the tick interrupt or with the
+ * scheduler suspended while pxTCB is the running task.
+ */
+    static void prvEDFRepositionReadyTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxTCB, which has just been readied, has an earlier
+ * deadline than the running task and so should preempt it.  Otherwise counts
+ * the context switch a comparison of the equal EDF priorities would have made.
+ */
+    static BaseType_t prvEDFPreemptsCurrentTask( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * prvEDFSetJobTiming() runs the admission test, if enabled, for the new period
+ * and relative deadline of pxTCB and holds them pending if it passes.
+ * prvEDFApplyPendingTiming() gives pxTCB the pending timing once its current
+ * job has completed, before the next job is released.  Both must be called
+ * from a critical section, prvEDFApplyPendingTiming() can also be called with
+ * the scheduler suspended.
+ */
+    static BaseType_t prvEDFSetJobTiming( TCB_t * const pxTCB,
+                                          const TickType_t xPeriod,
+                                          const TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+    static void prvEDFApplyPendingTiming( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Deadline inheritance.  Under EDF every task shares the same priority, so a
+ * mutex holder inherits the earliest deadline of the tasks it blocks instead.
+ * prvEDFInheritDeadline() records the deadline of a new waiter, pxWaitingTCB,
+ * and prvEDFDisinheritDeadline() gives the task its own deadline back.
+ * Inheritance is single level, as priority inheritance is: if the holder is
+ * itself blocked on a mutex held by a third task, that task does not inherit
+ * the deadline.
+ */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MUTEXES == 1 ) )
+
+    static BaseType_t prvEDFInheritDeadline( TCB_t * pxTCB,
+                                             const TCB_t * const pxWaitingTCB ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvEDFDisinheritDeadline( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Rate or deadline monotonic priority assignment.  prvFPRegisterTask() and
+ * prvFPUnregisterTask() add pxTCB to, or remove it from, the periodic tasks
+ * held in rank order.  prvFPAssignPriorities() then gives every periodic task
+ * the priority of its rank and returns pdTRUE if any priority changed, in
+ * which case the caller must yield.  All must be called from a critical
+ * section.
+ */
+#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+
+    static void prvFPRegisterTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvFPUnregisterTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvFPAssignPriorities( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the worst case response time of pxTCB, found by response
+ * time analysis over the tasks of the same or a higher assigned priority, is
+ * within its relative deadline.
+ */
+    static BaseType_t prvFPResponseTimeMeetsDeadline( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Sporadic tasks.  prvEDFRequestSporadicRelease() records a release request
+ * and readies the task if it is waiting for one, it must be called from a
+ * critical section or with interrupts masked.  prvEDFWaitForSporadicRelease()
+ * implements xTaskWaitForNextPeriod() for a sporadic task.
+ */
+#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+
+    static BaseType_t prvEDFRequestSporadicRelease( TCB_t * const pxTCB,
+                                                    BaseType_t * const pxYieldRequired ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvEDFWaitForSporadicRelease( PeriodicJob_t * const pxJob ) PRIVILEGED_FUNCTION;
+
+/* The oldest pending job is released when it was requested, or later if that
+ * is needed to keep the minimum inter-arrival time from the previous release,
+ * so it is never released before the event that requested it. */
+    #define taskEDF_OLDEST_ARRIVAL( pxTCB )    ( ( pxTCB )->xPendingArrivals[ ( pxTCB )->uxPendingHead ] )
+    #define taskEDF_SPORADIC_RELEASE_TIME( pxTCB )                                                                             \
+    ( ( ( TickType_t ) ( taskEDF_OLDEST_ARRIVAL( pxTCB ) - ( pxTCB )->xTaskNextRelease ) <= ( portMAX_DELAY >> 1 ) ) ? \
+      taskEDF_OLDEST_ARRIVAL( pxTCB ) : ( pxTCB )->xTaskNextRelease )
+
+#endif
+
+/*
+ * Budget enforcement.  prvEDFStartJobBudget() renews the budget of the calling
+ * task when it starts a new job.  prvEDFJobBudgetExpired() is called from the
+ * tick interrupt and returns pdTRUE if the running job has used up its budget
+ * but has not yet been charged for it.  prvEDFEnforceJobBudget() is called
+ * from vTaskSwitchContext(), after the run time of the task being switched out
+ * has been charged, and applies configEDF_OVERRUN_POLICY if it overran.
+ */
+#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+
+    static void prvEDFStartJobBudget( void ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvEDFJobBudgetExpired( void ) PRIVILEGED_FUNCTION;
+    static void prvEDFEnforceJobBudget( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+    #define taskEDF_START_JOB_BUDGET()    prvEDFStartJobBudget()
+#else
+    #define taskEDF_START_JOB_BUDGET()
+#endif
+
+/*
+ * Job statistics.  taskEDF_RELEASE_JOB_STATISTICS() is used when the calling
+ * task is given a new job.  The job starts when the task is next switched in,
+ * or when the call that released it returns if the task did not have to wait,
+ * at which point prvEDFRecordJobStart() records the start time.
+ * prvEDFRecordJobCompletion() is called by prvCheckForDeadlineMiss() when the
+ * job completes and updates the statistics of the task in constant time.
+ */
+#if ( configUSE_EDF_JOB_STATISTICS == 1 )
+
+    static void prvEDFRecordJobStart( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvEDFRecordJobCompletion( TCB_t * const pxTCB,
+                                           const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+    #define taskEDF_RELEASE_JOB_STATISTICS()    ( pxCurrentTCB->ucJobStarted = pdFALSE )
+    #define taskEDF_RECORD_JOB_START()              \
+    {                                               \
+        taskENTER_CRITICAL();                       \
+        prvEDFRecordJobStart( pxCurrentTCB );       \
+        taskEXIT_CRITICAL();                        \
+    }
+#else
+    #define taskEDF_RELEASE_JOB_STATISTICS()
+    #define taskEDF_RECORD_JOB_START()
+#endif
+
+/*
+ * Mode changes.  prvEDFApplyModeChange() gives pxTCB the parameters of the
+ * requested mode and prvEDFEndModeChange() drops a pending change, as when the
+ * task is deleted.  Both must be called from a critical section, or with the
+ * scheduler suspended as xTaskChangeMode() is not called from interrupts.
+ * prvEDFModeChangeWaitForNextPeriod() implements xTaskWaitForNextPeriod() for a
+ * task that has a change pending or is disabled.
+ */
+#if ( configUSE_EDF_MODE_CHANGES == 1 )
+
+    static void prvEDFApplyModeChange( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvEDFEndModeChange( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvEDFModeChangeWaitForNextPeriod( PeriodicJob_t * const pxJob ) PRIVILEGED_FUNCTION;
+
+/* A periodic task that paces itself with vTaskDelayUntil() or vTaskDelay()
+ * ends its job when it delays, so it takes a requested mode there too.  While
+ * the mode disables it the task keeps running, but without a deadline, so only
+ * when no job is Ready.  Used with the scheduler suspended. */
+    #define taskEDF_DELAY_MODE_CHANGE()                                                                       \
+    {                                                                                                         \
+        if( pxCurrentTCB->ucModeChangePending != pdFALSE )                                                    \
+        {                                                                                                     \
+            prvEDFApplyModeChange( pxCurrentTCB );                                                            \
+        }                                                                                                     \
+        pxCurrentTCB->ucHasDeadline = ( pxCurrentTCB->ucModeDisabled == pdFALSE ) ? pdTRUE : pdFALSE;         \
+    }
+#else
+    #define taskEDF_DELAY_MODE_CHANGE()
+#endif
+
+/*
+ * Start the next slot of the time-triggered schedule, releasing a job of the
+ * task that owns it if the slot is a release slot.  Called from the tick
+ * interrupt when the tick count reaches xTTNextSlotTime, and once by
+ * vTaskStartScheduler() for the first slot.
+ */
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+
+    static void prvTTStartNextSlot( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Constant bandwidth server.  prvCBSJobArrival() applies the CBS rule when an
+ * idle server is unblocked by a new job, prvCBSChargeBudget() charges one tick
+ * of execution to the server that is running.
+ */
+#if ( configUSE_EDF_CBS == 1 )
+
+    static void prvCBSJobArrival( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvCBSChargeBudget( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * EDF admission control.  prvEDFAdmissionTest() returns pdTRUE if the task
+ * set remains schedulable with the task described by pxTaskDefinition added,
+ * prvEDFAdmitTask() then records the created task and the utilisation it
+ * claims, and prvEDFReleaseTask() gives the utilisation back when the task is
+ * deleted.  All must be called with the scheduler suspended or from within a
+ * critical section.
+ */
+#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+
+    static BaseType_t prvEDFAdmissionTest( const PeriodicTaskParameters_t * const pxTaskDefinition ) PRIVILEGED_FUNCTION;
+    static void prvEDFAdmitTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    static void prvEDFReleaseTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Claims the utilisation pxTCB can need on top of its current share until it
+ * takes a new worst case execution time and period at the end of its job.
+ * Must be called from a critical section.
+ */
+#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+
+    static void prvEDFClaimUtilisation( TCB_t * const pxTCB,
+                                        const TickType_t xWcet,
+                                        const TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns pdTRUE if the task set stays schedulable while the uxNumberOfTasks
+ * tasks in pxTasks change to their new parameters one by one.  Must be called
+ * from a critical section.
+ */
+#if ( ( configUSE_EDF_ADMISSION_CONTROL == 1 ) && ( configUSE_EDF_MODE_CHANGES == 1 ) )
+
+    static BaseType_t prvEDFModeChangeTest( const ModeTaskParameters_t * const pxTasks,
+                                            const UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -614,7 +1280,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
         #endif /* configASSERT_DEFINED */
 
-        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) &&
+            ( taskEDF_RESERVE_READY_HEAP_PLACE( pxTaskCode ) != pdFALSE ) )
         {
             /* The memory used for the task's TCB and stack are passed into this
              * function - use them. */
@@ -654,7 +1321,8 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
         configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
         configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
 
-        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
+        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) &&
+            ( taskEDF_RESERVE_READY_HEAP_PLACE( pxTaskDefinition->pvTaskCode ) != pdFALSE ) )
         {
             /* Allocate space for the TCB.  Where the memory comes from depends
              * on the implementation of the port malloc function and whether or
@@ -700,13 +1368,32 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
         configASSERT( pxTaskDefinition->puxStackBuffer );
 
-        if( pxTaskDefinition->puxStackBuffer != NULL )
+        if( ( pxTaskDefinition->puxStackBuffer != NULL ) &&
+            ( taskEDF_RESERVE_READY_HEAP_PLACE( pxTaskDefinition->pvTaskCode ) != pdFALSE ) )
         {
             /* Allocate space for the TCB.  Where the memory comes from depends
              * on the implementation of the port malloc function and whether or
              * not static allocation is being used. */
             pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
 
+            #if ( configEDF_USE_READY_HEAP == 1 )
+                {
+                    if( pxNewTCB == NULL )
+                    {
+                        /* The task is not created after all. */
+                        taskENTER_CRITICAL();
+                        {
+                            uxEDFReadyHeapPlaces--;
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
             if( pxNewTCB != NULL )
             {
                 /* Store the stack location in the TCB. */
@@ -739,18 +1426,114 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #endif /* portUSING_MPU_WRAPPERS */
 /*-----------------------------------------------------------*/
-#if ( configUSE_EDF_SCHEDULER == 1 )
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
 BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
 																const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 																const configSTACK_DEPTH_TYPE usStackDepth,
 																void * const pvParameters,
 																UBaseType_t uxPriority,
 																TaskHandle_t * const pxCreatedTask, 
-																TickType_t period )
+																TickType_t period,
+																TickType_t wcet )
+		{
+				PeriodicTaskParameters_t xTaskDefinition;
+
+				/* A task created through this API has an implicit deadline, equal to its period. */
+				xTaskDefinition.pvTaskCode = pxTaskCode;
+				xTaskDefinition.pcName = pcName;
+				xTaskDefinition.usStackDepth = usStackDepth;
+				xTaskDefinition.pvParameters = pvParameters;
+				xTaskDefinition.uxPriority = uxPriority;
+				xTaskDefinition.xPeriod = period;
+				xTaskDefinition.xRelativeDeadline = period;
+				xTaskDefinition.xWcet = wcet;
+				xTaskDefinition.xReleaseOffset = ( TickType_t ) 0U;
+
+				return xTaskPeriodicCreateExtended( &xTaskDefinition, pxCreatedTask );
+		}
+
+BaseType_t xTaskPeriodicCreateExtended( const PeriodicTaskParameters_t * const pxTaskDefinition,
+																				TaskHandle_t * const pxCreatedTask )
+		{
+				return prvAdmitPeriodicTask( pxTaskDefinition, pdFALSE, pxCreatedTask );
+		}
+
+#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+BaseType_t xTaskSporadicCreate( TaskFunction_t pxTaskCode,
+																const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+																const configSTACK_DEPTH_TYPE usStackDepth,
+																void * const pvParameters,
+																UBaseType_t uxPriority,
+																TaskHandle_t * const pxCreatedTask,
+																TickType_t xMinInterArrival,
+																TickType_t xRelativeDeadline,
+																TickType_t xWcet )
+		{
+				PeriodicTaskParameters_t xTaskDefinition;
+
+				/* The demand of a sporadic task is bounded by that of a periodic
+				 * task whose period is the minimum inter-arrival time, so it is
+				 * admitted and scheduled as one. */
+				xTaskDefinition.pvTaskCode = pxTaskCode;
+				xTaskDefinition.pcName = pcName;
+				xTaskDefinition.usStackDepth = usStackDepth;
+				xTaskDefinition.pvParameters = pvParameters;
+				xTaskDefinition.uxPriority = uxPriority;
+				xTaskDefinition.xPeriod = xMinInterArrival;
+				xTaskDefinition.xRelativeDeadline = xRelativeDeadline;
+				xTaskDefinition.xWcet = xWcet;
+				xTaskDefinition.xReleaseOffset = ( TickType_t ) 0U;
+
+				return prvAdmitPeriodicTask( &xTaskDefinition, pdTRUE, pxCreatedTask );
+		}
+#endif
+
+static BaseType_t prvAdmitPeriodicTask( const PeriodicTaskParameters_t * const pxTaskDefinition,
+																				const BaseType_t xSporadic,
+																				TaskHandle_t * const pxCreatedTask )
+		{
+				BaseType_t xReturn;
+
+				configASSERT( pxTaskDefinition->xPeriod > ( TickType_t ) 0U );
+
+				#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+					{
+						/* Keep the scheduler suspended from the test until the task is
+						 * registered so no other task can be admitted in between. */
+						vTaskSuspendAll();
+						{
+							if( prvEDFAdmissionTest( pxTaskDefinition ) != pdFALSE )
+							{
+								xReturn = prvCreatePeriodicTask( pxTaskDefinition, xSporadic, pxCreatedTask );
+							}
+							else
+							{
+								traceTASK_CREATE_FAILED();
+								xReturn = errTASK_NOT_SCHEDULABLE;
+							}
+						}
+						( void ) xTaskResumeAll();
+					}
+				#else
+					{
+						xReturn = prvCreatePeriodicTask( pxTaskDefinition, xSporadic, pxCreatedTask );
+					}
+				#endif
+
+				return xReturn;
+		}
+
+static BaseType_t prvCreatePeriodicTask( const PeriodicTaskParameters_t * const pxTaskDefinition,
+																				 const BaseType_t xSporadic,
+																				 TaskHandle_t * const pxCreatedTask )
 		{
 				TCB_t * pxNewTCB;
         BaseType_t xReturn;
 				TickType_t currentTick = 0;
+				const configSTACK_DEPTH_TYPE usStackDepth = pxTaskDefinition->usStackDepth;
+				#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+					BaseType_t xPrioritiesChanged;
+				#endif
 
 
         /* If the stack grows down then allocate the stack then the TCB so the stack
@@ -809,6 +1592,18 @@ BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
             }
         #endif /* portSTACK_GROWTH */
 
+        if( ( pxNewTCB != NULL ) && ( taskEDF_RESERVE_READY_HEAP_PLACE( pxTaskDefinition->pvTaskCode ) == pdFALSE ) )
+        {
+            /* Every place in the EDF ready heap is taken. */
+            vPortFreeStack( pxNewTCB->pxStack );
+            vPortFree( pxNewTCB );
+            pxNewTCB = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
         if( pxNewTCB != NULL )
         {
             #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
@@ -818,15 +1613,92 @@ BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
                     pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
                 }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-						
-					
-						pxNewTCB->xTaskPeriod = period;
+
+            prvInitialiseNewTask( pxTaskDefinition->pvTaskCode, pxTaskDefinition->pcName, ( uint32_t ) usStackDepth, pxTaskDefinition->pvParameters, pxTaskDefinition->uxPriority, pxCreatedTask, pxNewTCB, NULL );
+
+						pxNewTCB->xTaskPeriod = pxTaskDefinition->xPeriod;
+						pxNewTCB->xTaskWcet = pxTaskDefinition->xWcet;
+
+						/* A relative deadline of zero means the deadline is implicit. */
+						if( pxTaskDefinition->xRelativeDeadline == ( TickType_t ) 0U )
+						{
+								pxNewTCB->xTaskRelativeDeadline = pxTaskDefinition->xPeriod;
+						}
+						else
+						{
+								pxNewTCB->xTaskRelativeDeadline = pxTaskDefinition->xRelativeDeadline;
+						}
+
+						/* The first job is released once the release offset has
+						 * elapsed. */
 						currentTick = xTaskGetTickCount();
-					
-						listSET_LIST_ITEM_VALUE( &( ( pxNewTCB )->xStateListItem ), ( pxNewTCB)->xTaskPeriod + currentTick);
-					
-            prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+						pxNewTCB->xTaskNextRelease = currentTick + pxTaskDefinition->xReleaseOffset;
+						pxNewTCB->xTaskAbsoluteDeadline = pxNewTCB->xTaskNextRelease + pxNewTCB->xTaskRelativeDeadline;
+						pxNewTCB->ucHasDeadline = pdTRUE;
+
+						#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+							pxNewTCB->ulJobBudget = ( configRUN_TIME_COUNTER_TYPE ) pxNewTCB->xTaskWcet * ( configRUN_TIME_COUNTER_TYPE ) configEDF_RUN_TIME_COUNTS_PER_TICK;
+						#endif
+
+						#if ( configUSE_EDF_JOB_STATISTICS == 1 )
+							/* The first job starts when the task first runs. */
+							pxNewTCB->ucJobStarted = pdFALSE;
+						#endif
+
+						#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+							if( xSporadic != pdFALSE )
+							{
+								/* A sporadic task has no job until it is first released,
+								 * which it can be straight away. */
+								pxNewTCB->ucTaskSporadic = pdTRUE;
+								pxNewTCB->ucHasDeadline = pdFALSE;
+								pxNewTCB->xTaskLastArrival = currentTick - pxNewTCB->xTaskPeriod;
+
+								#if ( configUSE_EDF_JOB_STATISTICS == 1 )
+									pxNewTCB->ucJobStarted = pdTRUE;
+								#endif
+							}
+						#else
+							( void ) xSporadic;
+						#endif
+
+						#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+							{
+								prvEDFAdmitTask( pxNewTCB );
+							}
+						#endif
+
+						#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+							{
+								/* The task takes the priority of its rank before it is
+								 * made ready, which can move the lower ranked periodic
+								 * tasks down. */
+								taskENTER_CRITICAL();
+								{
+									prvFPRegisterTask( pxNewTCB );
+									xPrioritiesChanged = prvFPAssignPriorities();
+								}
+								taskEXIT_CRITICAL();
+							}
+						#endif
+
 						prvAddNewTaskToReadyList( pxNewTCB );
+
+						#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+							{
+								/* The running task may have been one of those moved
+								 * down. */
+								if( ( xPrioritiesChanged != pdFALSE ) && ( xSchedulerRunning != pdFALSE ) )
+								{
+									taskYIELD_IF_USING_PREEMPTION();
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+						#endif
+
             xReturn = pdPASS;
         }
         else
@@ -908,6 +1780,18 @@ BaseType_t xTaskPeriodicCreate( TaskFunction_t pxTaskCode,
             }
         #endif /* portSTACK_GROWTH */
 
+        if( ( pxNewTCB != NULL ) && ( taskEDF_RESERVE_READY_HEAP_PLACE( pxTaskCode ) == pdFALSE ) )
+        {
+            /* Every place in the EDF ready heap is taken. */
+            vPortFreeStack( pxNewTCB->pxStack );
+            vPortFree( pxNewTCB );
+            pxNewTCB = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
         if( pxNewTCB != NULL )
         {
             #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
@@ -1055,31 +1939,135 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
-    /* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
-     * back to  the containing TCB from a generic item in a list. */
-    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
-
-    /* Event lists are always in priority order. */
-    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
-
-    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
-        {
-            pxNewTCB->uxCriticalNesting = ( UBaseType_t ) 0U;
+    #if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
+        {
+            /* A task that is not created as a periodic task has no jobs and
+             * no deadline, so under EDF it runs after every task that has
+             * one. */
+            pxNewTCB->xTaskPeriod = ( TickType_t ) 0U;
+            pxNewTCB->xTaskRelativeDeadline = ( TickType_t ) 0U;
+            pxNewTCB->xTaskAbsoluteDeadline = ( TickType_t ) 0U;
+            pxNewTCB->ucHasDeadline = pdFALSE;
+            pxNewTCB->xTaskWcet = ( TickType_t ) 0U;
+            pxNewTCB->xTaskNextRelease = ( TickType_t ) 0U;
+            pxNewTCB->uxJobsReleased = ( UBaseType_t ) 0U;
+            pxNewTCB->xMaxLateness = ( TickType_t ) 0U;
+            pxNewTCB->uxDeadlineMisses = ( UBaseType_t ) 0U;
+            pxNewTCB->ucDeadlineMissed = pdFALSE;
         }
-    #endif /* portCRITICAL_NESTING_IN_TCB */
+    #endif
 
-    #if ( configUSE_APPLICATION_TASK_TAG == 1 )
+    #if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
         {
-            pxNewTCB->pxTaskTag = NULL;
+            pxNewTCB->uxAssignedPriority = uxPriority;
+            pxNewTCB->pxNextPeriodicTCB = NULL;
         }
-    #endif /* configUSE_APPLICATION_TASK_TAG */
+    #endif
 
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( configUSE_EDF_SCHEDULER == 1 )
         {
-            pxNewTCB->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
-        }
-    #endif /* configGENERATE_RUN_TIME_STATS */
+            pxNewTCB->xPendingPeriod = ( TickType_t ) 0U;
+            pxNewTCB->xPendingRelativeDeadline = ( TickType_t ) 0U;
+
+            #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+                {
+                    pxNewTCB->ulPendingClaim = 0UL;
+                }
+            #endif
+        }
+    #endif
+
+    #if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+        {
+            pxNewTCB->uxPendingHead = ( UBaseType_t ) 0U;
+            pxNewTCB->uxPendingReleases = ( UBaseType_t ) 0U;
+            pxNewTCB->uxSeparationViolations = ( UBaseType_t ) 0U;
+            pxNewTCB->ucTaskSporadic = pdFALSE;
+            pxNewTCB->ucWaitingForRelease = pdFALSE;
+        }
+    #endif
+
+    #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+        {
+            pxNewTCB->ulJobExecutionTime = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+            pxNewTCB->ulJobBudget = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+            pxNewTCB->uxBudgetOverruns = ( UBaseType_t ) 0U;
+            pxNewTCB->ucBudgetExhausted = pdFALSE;
+        }
+    #endif
+
+    #if ( configUSE_EDF_MODE_CHANGES == 1 )
+        {
+            pxNewTCB->xModePeriod = ( TickType_t ) 0U;
+            pxNewTCB->xModeRelativeDeadline = ( TickType_t ) 0U;
+            pxNewTCB->xModeWcet = ( TickType_t ) 0U;
+            pxNewTCB->ucModeChangePending = pdFALSE;
+            pxNewTCB->ucModeDisabled = pdFALSE;
+            pxNewTCB->ucWaitingForMode = pdFALSE;
+        }
+    #endif
+
+    #if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+        {
+            pxNewTCB->uxSlotOverruns = ( UBaseType_t ) 0U;
+            pxNewTCB->ucWaitingForSlot = pdFALSE;
+            pxNewTCB->ucSlotReleasePending = pdFALSE;
+            pxNewTCB->ucSlotJobActive = pdFALSE;
+        }
+    #endif
+
+    #if ( configUSE_EDF_JOB_STATISTICS == 1 )
+        {
+            /* A task only has jobs once it is made periodic, until then there
+             * is no job start to record. */
+            ( void ) memset( ( void * ) &( pxNewTCB->xJobStatistics ), 0x00, sizeof( TaskJobStatistics_t ) );
+            pxNewTCB->xJobStatistics.xMinResponseTime = portMAX_DELAY;
+            pxNewTCB->xJobStatistics.xMinStartDelay = portMAX_DELAY;
+            pxNewTCB->xJobStartTime = ( TickType_t ) 0U;
+            pxNewTCB->ucJobStarted = pdTRUE;
+        }
+    #endif
+
+    #if ( configUSE_EDF_CBS == 1 )
+        {
+            pxNewTCB->xCBSBudget = ( TickType_t ) 0U;
+            pxNewTCB->xCBSMaxBudget = ( TickType_t ) 0U;
+            pxNewTCB->ucCBSServerIdle = pdFALSE;
+        }
+    #endif
+
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MUTEXES == 1 ) )
+        {
+            pxNewTCB->xInheritedDeadline = ( TickType_t ) 0U;
+            pxNewTCB->ucInheritsDeadline = pdFALSE;
+        }
+    #endif
+
+    /* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
+     * back to  the containing TCB from a generic item in a list. */
+    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
+
+    /* Event lists are always in priority order. */
+    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
+
+    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+        {
+            pxNewTCB->uxCriticalNesting = ( UBaseType_t ) 0U;
+        }
+    #endif /* portCRITICAL_NESTING_IN_TCB */
+
+    #if ( configUSE_APPLICATION_TASK_TAG == 1 )
+        {
+            pxNewTCB->pxTaskTag = NULL;
+        }
+    #endif /* configUSE_APPLICATION_TASK_TAG */
+
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            pxNewTCB->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+    #endif /* configGENERATE_RUN_TIME_STATS */
 
     #if ( portUSING_MPU_WRAPPERS == 1 )
         {
@@ -1218,7 +2206,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * so far. */
             if( xSchedulerRunning == pdFALSE )
             {
-                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    if( taskEDF_RUNS_BEFORE( pxNewTCB, pxCurrentTCB ) )
+                #else
+                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                #endif
                 {
                     pxCurrentTCB = pxNewTCB;
                 }
@@ -1253,7 +2245,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         /* If the created task is of a higher priority than the current task
          * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            if( prvEDFPreemptsCurrentTask( pxNewTCB ) != pdFALSE )
+        #else
+            if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        #endif
         {
             taskYIELD_IF_USING_PREEMPTION();
         }
@@ -1275,6 +2271,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         TCB_t * pxTCB;
 
+        #if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+            BaseType_t xPrioritiesChanged;
+        #endif
+
         taskENTER_CRITICAL();
         {
             /* If null is passed in here then it is the calling task that is
@@ -1282,7 +2282,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
             /* Remove task from the ready/delayed list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            if( prvRemoveTaskFromStateList( pxTCB ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
             }
@@ -1301,6 +2301,57 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configEDF_USE_READY_HEAP == 1 )
+                {
+                    /* The task's place in the ready heap is free for a new
+                     * task. */
+                    uxEDFReadyHeapPlaces--;
+                }
+            #endif
+
+            #if ( configUSE_EDF_MODE_CHANGES == 1 )
+                {
+                    /* A deleted task cannot hold up the end of a mode
+                     * change. */
+                    if( pxTCB->ucModeChangePending != pdFALSE )
+                    {
+                        prvEDFEndModeChange( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
+            #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+                {
+                    /* The processor time claimed by the task is free for
+                     * other tasks to be admitted. */
+                    ulAdmittedUtilisation -= pxTCB->ulPendingClaim;
+                    pxTCB->ulPendingClaim = 0UL;
+                    prvEDFReleaseTask( pxTCB );
+
+                    if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
+                    {
+                        uxTimingChangesPending--;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
+            #if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+                {
+                    /* The lower ranked periodic tasks can move up into the
+                     * rank the task leaves. */
+                    prvFPUnregisterTask( pxTCB );
+                    xPrioritiesChanged = prvFPAssignPriorities();
+                }
+            #endif
+
             /* Increment the uxTaskNumber also so kernel aware debuggers can
              * detect that the task lists need re-generating.  This is done before
              * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
@@ -1361,6 +2412,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 configASSERT( uxSchedulerSuspended == 0 );
                 portYIELD_WITHIN_API();
             }
+
+            #if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+                else if( xPrioritiesChanged != pdFALSE )
+                {
+                    /* A task moved up may now be above the running task. */
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+            #endif
             else
             {
                 mtCOVERAGE_TEST_MARKER();
@@ -1389,6 +2448,15 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * block. */
             const TickType_t xConstTickCount = xTickCount;
 
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* Calling this function marks the end of the current job,
+                     * so check it against its deadline before the deadline
+                     * held in the state list item is overwritten. */
+                    prvCheckForDeadlineMiss( pxCurrentTCB, xConstTickCount, pdTRUE );
+                }
+            #endif
+
             /* Generate the tick time at which the task wants to wake. */
             xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
 
@@ -1426,6 +2494,35 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             /* Update the wake time ready for the next call. */
             *pxPreviousWakeTime = xTimeToWake;
 
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* The next job is released at the wake time whether or not
+                     * the task has to wait for it, so a release serviced late
+                     * keeps its deadline. */
+                    if( pxCurrentTCB->xTaskPeriod > ( TickType_t ) 0U )
+                    {
+                        taskEDF_DELAY_MODE_CHANGE();
+                        prvEDFApplyPendingTiming( pxCurrentTCB );
+                        pxCurrentTCB->xTaskAbsoluteDeadline = xTimeToWake + pxCurrentTCB->xTaskRelativeDeadline;
+                        taskEDF_START_JOB_BUDGET();
+                        taskEDF_RELEASE_JOB_STATISTICS();
+
+                        if( xShouldDelay == pdFALSE )
+                        {
+                            prvEDFRepositionReadyTask( pxCurrentTCB );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
             if( xShouldDelay != pdFALSE )
             {
                 traceTASK_DELAY_UNTIL( xTimeToWake );
@@ -1452,182 +2549,453 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        /* A job released without the task having to wait starts now. */
+        taskEDF_RECORD_JOB_START();
+
         return xShouldDelay;
     }
 
 #endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelay == 1 )
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
 
-    void vTaskDelay( const TickType_t xTicksToDelay )
+    BaseType_t xTaskWaitForNextPeriod( PeriodicJob_t * const pxJob )
     {
-        BaseType_t xAlreadyYielded = pdFALSE;
+        TickType_t xReleaseTime, xTimeToWait;
+        UBaseType_t uxJobIndex;
+        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
 
-        /* A delay time of zero just forces a reschedule. */
-        if( xTicksToDelay > ( TickType_t ) 0U )
+        configASSERT( uxSchedulerSuspended == 0 );
+
+        /* Only a task created as a periodic task has a period to wait for. */
+        configASSERT( pxCurrentTCB->xTaskPeriod > ( TickType_t ) 0U );
+
+        #if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+            {
+                if( pxCurrentTCB->ucTaskSporadic != pdFALSE )
+                {
+                    return prvEDFWaitForSporadicRelease( pxJob );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif
+
+        #if ( configUSE_EDF_MODE_CHANGES == 1 )
+            {
+                /* A change requested after this test is made at the end of
+                 * the next job instead. */
+                if( ( pxCurrentTCB->ucModeChangePending != pdFALSE ) || ( pxCurrentTCB->ucModeDisabled != pdFALSE ) )
+                {
+                    return prvEDFModeChangeWaitForNextPeriod( pxJob );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif
+
+        vTaskSuspendAll();
         {
-            configASSERT( uxSchedulerSuspended == 0 );
-            vTaskSuspendAll();
+            /* Minor optimisation.  The tick count cannot change in this
+             * block. */
+            const TickType_t xConstTickCount = xTickCount;
+
+            /* Every call but the first completes the job released by the
+             * previous call. */
+            if( pxCurrentTCB->uxJobsReleased > ( UBaseType_t ) 0U )
             {
-                traceTASK_DELAY();
+                prvCheckForDeadlineMiss( pxCurrentTCB, xConstTickCount, pdTRUE );
+            }
+            else
+            {
+                pxCurrentTCB->ucDeadlineMissed = pdFALSE;
+            }
 
-                /* A task that is removed from the event list while the
-                 * scheduler is suspended will not get placed in the ready
-                 * list or removed from the blocked list until the scheduler
-                 * is resumed.
-                 *
-                 * This task cannot be in an event list as it is the currently
-                 * executing task. */
-                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    prvEDFApplyPendingTiming( pxCurrentTCB );
+                }
+            #endif
+
+            /* Release the next job, its deadline is known before the task
+             * waits for it. */
+            xReleaseTime = pxCurrentTCB->xTaskNextRelease;
+            uxJobIndex = pxCurrentTCB->uxJobsReleased;
+            pxCurrentTCB->xTaskNextRelease = xReleaseTime + pxCurrentTCB->xTaskPeriod;
+            pxCurrentTCB->xTaskAbsoluteDeadline = xReleaseTime + pxCurrentTCB->xTaskRelativeDeadline;
+            pxCurrentTCB->ucHasDeadline = pdTRUE;
+            ( pxCurrentTCB->uxJobsReleased )++;
+            taskEDF_START_JOB_BUDGET();
+            taskEDF_RELEASE_JOB_STATISTICS();
+
+            /* The release time is in the future if it is less than half the
+             * range of the tick count ahead, which allows for the tick count
+             * overflowing in between. */
+            xTimeToWait = xReleaseTime - xConstTickCount;
+
+            if( ( xTimeToWait > ( TickType_t ) 0U ) && ( xTimeToWait <= ( portMAX_DELAY >> 1 ) ) )
+            {
+                traceTASK_DELAY_UNTIL( xReleaseTime );
+                prvAddCurrentTaskToDelayedList( xTimeToWait, pdFALSE );
+                xShouldDelay = pdTRUE;
             }
-            xAlreadyYielded = xTaskResumeAll();
+            else
+            {
+                /* The job is already released, it runs straight away with
+                 * its new deadline.  Under fixed priorities it keeps its
+                 * place as the deadline does not order the ready lists. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        prvEDFRepositionReadyTask( pxCurrentTCB );
+                    }
+                #else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                #endif
+            }
+        }
+        xAlreadyYielded = xTaskResumeAll();
+
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep or moved behind another task. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
+        /* A job released without the task having to wait starts now. */
+        taskEDF_RECORD_JOB_START();
+
+        if( pxJob != NULL )
         {
-            portYIELD_WITHIN_API();
+            pxJob->uxJobIndex = uxJobIndex;
+            pxJob->xReleaseTime = xReleaseTime;
+            pxJob->xDeadline = xReleaseTime + pxCurrentTCB->xTaskRelativeDeadline;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return xShouldDelay;
     }
 
-#endif /* INCLUDE_vTaskDelay */
+#endif /* tskPERIODIC_TASKS_SUPPORTED */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-    eTaskState eTaskGetState( TaskHandle_t xTask )
+    BaseType_t xTaskSetPeriod( TaskHandle_t xTask,
+                               TickType_t xNewPeriod )
     {
-        eTaskState eReturn;
-        List_t const * pxStateList, * pxDelayedList, * pxOverflowedDelayedList;
-        const TCB_t * const pxTCB = xTask;
-
-        configASSERT( pxTCB );
+        TCB_t * pxTCB;
+        TickType_t xPeriod, xRelativeDeadline;
+        BaseType_t xReturn;
 
-        if( pxTCB == pxCurrentTCB )
-        {
-            /* The task calling this function is querying its own state. */
-            eReturn = eRunning;
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            taskENTER_CRITICAL();
+            /* If null is passed in here then it is the period of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* Start from the timing the task will have after any change that
+             * is still to be made. */
+            if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
             {
-                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                xPeriod = pxTCB->xPendingPeriod;
+                xRelativeDeadline = pxTCB->xPendingRelativeDeadline;
+            }
+            else
+            {
+                xPeriod = pxTCB->xTaskPeriod;
+                xRelativeDeadline = pxTCB->xTaskRelativeDeadline;
             }
-            taskEXIT_CRITICAL();
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            /* An implicit deadline stays equal to the period. */
+            if( xRelativeDeadline == xPeriod )
             {
-                /* The task being queried is referenced from one of the Blocked
-                 * lists. */
-                eReturn = eBlocked;
+                xRelativeDeadline = xNewPeriod;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
-                else if( pxStateList == &xSuspendedTaskList )
-                {
-                    /* The task being queried is referenced from the suspended
-                     * list.  Is it genuinely suspended or is it blocked
-                     * indefinitely? */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
-                    {
-                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-                            {
-                                BaseType_t x;
+            xReturn = prvEDFSetJobTiming( pxTCB, xNewPeriod, xRelativeDeadline );
+        }
+        taskEXIT_CRITICAL();
 
-                                /* The task does not appear on the event list item of
-                                 * and of the RTOS objects, but could still be in the
-                                 * blocked state if it is waiting on its notification
-                                 * rather than waiting on an object.  If not, is
-                                 * suspended. */
-                                eReturn = eSuspended;
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
 
-                                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
-                                {
-                                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                                    {
-                                        eReturn = eBlocked;
-                                        break;
-                                    }
-                                }
-                            }
-                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                            {
-                                eReturn = eSuspended;
-                            }
-                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                    }
-                    else
-                    {
-                        eReturn = eBlocked;
-                    }
-                }
-            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
+    BaseType_t xTaskSetRelativeDeadline( TaskHandle_t xTask,
+                                         TickType_t xNewRelativeDeadline )
+    {
+        TCB_t * pxTCB;
+        TickType_t xPeriod;
+        BaseType_t xReturn;
 
-            #if ( INCLUDE_vTaskDelete == 1 )
-                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
-                {
-                    /* The task being queried is referenced from the deleted
-                     * tasks list, or it is not referenced from any lists at
-                     * all. */
-                    eReturn = eDeleted;
-                }
-            #endif
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the deadline of the
+             * calling task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
 
-            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+            if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
             {
-                /* If the task is not in any other state, it must be in the
-                 * Ready (including pending ready) state. */
-                eReturn = eReady;
+                xPeriod = pxTCB->xPendingPeriod;
+            }
+            else
+            {
+                xPeriod = pxTCB->xTaskPeriod;
             }
+
+            /* A relative deadline of zero means the deadline is implicit. */
+            if( xNewRelativeDeadline == ( TickType_t ) 0U )
+            {
+                xNewRelativeDeadline = xPeriod;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = prvEDFSetJobTiming( pxTCB, xPeriod, xNewRelativeDeadline );
         }
+        taskEXIT_CRITICAL();
 
-        return eReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+        return xReturn;
+    }
 
-#endif /* INCLUDE_eTaskGetState */
+#endif /* configUSE_EDF_SCHEDULER */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+#if ( configUSE_EDF_SPORADIC_TASKS == 1 )
 
-    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+    static BaseType_t prvEDFRequestSporadicRelease( TCB_t * const pxTCB,
+                                                    BaseType_t * const pxYieldRequired )
     {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn;
+        const TickType_t xArrival = xTickCount;
+        BaseType_t xReturn = pdPASS;
+
+        configASSERT( pxTCB->ucTaskSporadic != pdFALSE );
+
+        /* A request that comes too soon after the last one is still served,
+         * but its release is deferred until the minimum inter-arrival time
+         * has elapsed, so a burst of requests cannot take more than the
+         * processor share the task was admitted with. */
+        if( ( TickType_t ) ( xArrival - pxTCB->xTaskLastArrival ) < pxTCB->xTaskPeriod )
+        {
+            ( pxTCB->uxSeparationViolations )++;
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->xTaskLastArrival = xArrival;
+
+        /* Each pending request keeps the time it arrived, so a job queued
+         * behind others is not released, and given its deadline, before the
+         * event that requested it. */
+        if( pxTCB->uxPendingReleases < ( UBaseType_t ) configEDF_SPORADIC_QUEUE_LENGTH )
+        {
+            pxTCB->xPendingArrivals[ ( pxTCB->uxPendingHead + pxTCB->uxPendingReleases ) % ( UBaseType_t ) configEDF_SPORADIC_QUEUE_LENGTH ] = xArrival;
+            ( pxTCB->uxPendingReleases )++;
+        }
+        else
+        {
+            /* The queue is full, so the request is dropped.  It is counted as
+             * a violation unless it already was one. */
+            if( xReturn == pdPASS )
+            {
+                ( pxTCB->uxSeparationViolations )++;
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( pxTCB->ucWaitingForRelease != pdFALSE )
+        {
+            /* The task is ordered by the deadline of the job it is about to
+             * be released for. */
+            pxTCB->ucWaitingForRelease = pdFALSE;
+            pxTCB->xTaskAbsoluteDeadline = taskEDF_SPORADIC_RELEASE_TIME( pxTCB ) + pxTCB->xTaskRelativeDeadline;
+            pxTCB->ucHasDeadline = pdTRUE;
+
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            {
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else
+            {
+                /* The delayed and ready lists cannot be accessed, so hold
+                 * this task pending until the scheduler is resumed. */
+                listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+            }
+
+            if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+            {
+                *pxYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    static BaseType_t prvEDFWaitForSporadicRelease( PeriodicJob_t * const pxJob )
+    {
+        TickType_t xReleaseTime, xTimeToWait;
+        UBaseType_t uxJobIndex;
+        BaseType_t xShouldDelay = pdFALSE;
 
         taskENTER_CRITICAL();
         {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
+            /* Every call but the first completes the job released by the
+             * previous call. */
+            if( pxCurrentTCB->uxJobsReleased > ( UBaseType_t ) 0U )
+            {
+                prvCheckForDeadlineMiss( pxCurrentTCB, xTickCount, pdTRUE );
+            }
+            else
+            {
+                pxCurrentTCB->ucDeadlineMissed = pdFALSE;
+            }
+
+            prvEDFApplyPendingTiming( pxCurrentTCB );
+
+            /* Until the task is released it has no job, so it is not
+             * ordered by the deadline of the job it has just completed. */
+            pxCurrentTCB->ucHasDeadline = pdFALSE;
+
+            while( pxCurrentTCB->uxPendingReleases == ( UBaseType_t ) 0U )
+            {
+                /* Wait for a release request.  The request readies the task,
+                 * the loop only repeats if something else did. */
+                pxCurrentTCB->ucWaitingForRelease = pdTRUE;
+                prvAddCurrentTaskToDelayedList( portMAX_DELAY, pdTRUE );
+                xShouldDelay = pdTRUE;
+
+                /* All ports are written to allow a yield in a critical
+                 * section (some will yield immediately, others wait until the
+                 * critical section exits) - but it is not something that
+                 * application code should ever do. */
+                portYIELD_WITHIN_API();
+                taskEXIT_CRITICAL();
+                taskENTER_CRITICAL();
+            }
+
+            pxCurrentTCB->ucWaitingForRelease = pdFALSE;
+
+            /* Release the oldest pending job.  Any later pending job is
+             * released no earlier than the minimum inter-arrival time after
+             * this one. */
+            xReleaseTime = taskEDF_SPORADIC_RELEASE_TIME( pxCurrentTCB );
+            uxJobIndex = pxCurrentTCB->uxJobsReleased;
+            ( pxCurrentTCB->uxPendingReleases )--;
+            pxCurrentTCB->uxPendingHead = ( pxCurrentTCB->uxPendingHead + ( UBaseType_t ) 1U ) % ( UBaseType_t ) configEDF_SPORADIC_QUEUE_LENGTH;
+            pxCurrentTCB->xTaskNextRelease = xReleaseTime + pxCurrentTCB->xTaskPeriod;
+            pxCurrentTCB->xTaskAbsoluteDeadline = xReleaseTime + pxCurrentTCB->xTaskRelativeDeadline;
+            pxCurrentTCB->ucHasDeadline = pdTRUE;
+            ( pxCurrentTCB->uxJobsReleased )++;
+            taskEDF_START_JOB_BUDGET();
+            taskEDF_RELEASE_JOB_STATISTICS();
+
+            xTimeToWait = xReleaseTime - xTickCount;
+
+            if( ( xTimeToWait > ( TickType_t ) 0U ) && ( xTimeToWait <= ( portMAX_DELAY >> 1 ) ) )
+            {
+                /* The release was deferred to keep the minimum separation. */
+                traceTASK_DELAY_UNTIL( xReleaseTime );
+                prvAddCurrentTaskToDelayedList( xTimeToWait, pdFALSE );
+                portYIELD_WITHIN_API();
+                xShouldDelay = pdTRUE;
+            }
+            else
+            {
+                prvEDFRepositionReadyTask( pxCurrentTCB );
+                portYIELD_WITHIN_API();
+            }
         }
         taskEXIT_CRITICAL();
 
-        return uxReturn;
+        /* A job released without the task having to wait starts now. */
+        taskEDF_RECORD_JOB_START();
+
+        if( pxJob != NULL )
+        {
+            pxJob->uxJobIndex = uxJobIndex;
+            pxJob->xReleaseTime = xReleaseTime;
+            pxJob->xDeadline = xReleaseTime + pxCurrentTCB->xTaskRelativeDeadline;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xShouldDelay;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_uxTaskPriorityGet */
-/*-----------------------------------------------------------*/
+    BaseType_t xTaskReleaseSporadic( TaskHandle_t xTaskToRelease )
+    {
+        TCB_t * const pxTCB = xTaskToRelease;
+        BaseType_t xReturn, xYieldRequired = pdFALSE;
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+        configASSERT( pxTCB );
 
-    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
+        taskENTER_CRITICAL();
+        {
+            xReturn = prvEDFRequestSporadicRelease( pxTCB, &xYieldRequired );
+
+            if( xYieldRequired != pdFALSE )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    BaseType_t xTaskReleaseSporadicFromISR( TaskHandle_t xTaskToRelease,
+                                            BaseType_t * pxHigherPriorityTaskWoken )
     {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn, uxSavedInterruptState;
+        TCB_t * const pxTCB = xTaskToRelease;
+        BaseType_t xReturn, xYieldRequired = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxTCB );
 
         /* RTOS ports that support interrupt nesting have the concept of a
          * maximum  system call (or maximum API call) interrupt priority.
@@ -1647,1037 +3015,2061 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
          * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
         portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
         {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
+            xReturn = prvEDFRequestSporadicRelease( pxTCB, &xYieldRequired );
+
+            if( xYieldRequired != pdFALSE )
+            {
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+
+                /* Mark that a yield is pending in case the user is not
+                 * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                 * safe FreeRTOS function. */
+                xYieldPending = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-        return uxReturn;
+        return xReturn;
     }
 
-#endif /* INCLUDE_uxTaskPriorityGet */
+#endif /* configUSE_EDF_SPORADIC_TASKS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskPrioritySet == 1 )
+#if ( configUSE_EDF_MODE_CHANGES == 1 )
 
-    void vTaskPrioritySet( TaskHandle_t xTask,
-                           UBaseType_t uxNewPriority )
+    static void prvEDFEndModeChange( TCB_t * const pxTCB )
     {
-        TCB_t * pxTCB;
-        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
-        BaseType_t xYieldRequired = pdFALSE;
+        pxTCB->ucModeChangePending = pdFALSE;
+        uxModeChangesPending--;
 
-        configASSERT( uxNewPriority < configMAX_PRIORITIES );
+        #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+            {
+                /* The claim only covered the overlap of the old and new
+                 * jobs. */
+                ulAdmittedUtilisation -= pxTCB->ulPendingClaim;
+                pxTCB->ulPendingClaim = 0UL;
+            }
+        #endif
+    }
+    /*-----------------------------------------------------------*/
 
-        /* Ensure the new priority is valid. */
-        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+    static void prvEDFApplyModeChange( TCB_t * const pxTCB )
+    {
+        prvEDFEndModeChange( pxTCB );
+
+        #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+            {
+                prvEDFReleaseTask( pxTCB );
+            }
+        #endif
+
+        if( pxTCB->xModePeriod == ( TickType_t ) 0U )
         {
-            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+            /* The old parameters are kept for when the task is enabled by a
+             * mode that does not list it, but claim nothing meanwhile. */
+            pxTCB->ucModeDisabled = pdTRUE;
+
+            #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+                {
+                    pxTCB->ulTaskUtilisation = 0UL;
+                }
+            #endif
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        taskENTER_CRITICAL();
-        {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being changed. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-
-            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
+            pxTCB->ucModeDisabled = pdFALSE;
+            pxTCB->xTaskPeriod = pxTCB->xModePeriod;
+            pxTCB->xTaskRelativeDeadline = pxTCB->xModeRelativeDeadline;
+            pxTCB->xTaskWcet = pxTCB->xModeWcet;
 
-            #if ( configUSE_MUTEXES == 1 )
+            #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
                 {
-                    uxCurrentBasePriority = pxTCB->uxBasePriority;
+                    pxTCB->ulJobBudget = ( configRUN_TIME_COUNTER_TYPE ) pxTCB->xTaskWcet * ( configRUN_TIME_COUNTER_TYPE ) configEDF_RUN_TIME_COUNTS_PER_TICK;
                 }
-            #else
+            #endif
+
+            #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
                 {
-                    uxCurrentBasePriority = pxTCB->uxPriority;
+                    prvEDFAdmitTask( pxTCB );
                 }
             #endif
+        }
+    }
+    /*-----------------------------------------------------------*/
 
-            if( uxCurrentBasePriority != uxNewPriority )
+    static BaseType_t prvEDFModeChangeWaitForNextPeriod( PeriodicJob_t * const pxJob )
+    {
+        TickType_t xReleaseTime, xTimeToWait;
+        UBaseType_t uxJobIndex;
+        BaseType_t xShouldDelay = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            /* The job released by the previous call is completed with the
+             * parameters it was released with. */
+            if( ( pxCurrentTCB->uxJobsReleased > ( UBaseType_t ) 0U ) && ( pxCurrentTCB->ucModeDisabled == pdFALSE ) )
             {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
-                {
-                    if( pxTCB != pxCurrentTCB )
+                prvCheckForDeadlineMiss( pxCurrentTCB, xTickCount, pdTRUE );
+            }
+            else
+            {
+                pxCurrentTCB->ucDeadlineMissed = pdFALSE;
+            }
+
+            if( pxCurrentTCB->ucModeChangePending != pdFALSE )
+            {
+                prvEDFApplyModeChange( pxCurrentTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            while( pxCurrentTCB->ucModeDisabled != pdFALSE )
+            {
+                /* Wait for a mode that enables the task.  The mode change
+                 * readies the task, the loop only repeats if something else
+                 * did.  Until then the task has no job, so it is not ordered
+                 * by the deadline of the job it has just completed. */
+                pxCurrentTCB->ucHasDeadline = pdFALSE;
+                pxCurrentTCB->ucWaitingForMode = pdTRUE;
+                prvAddCurrentTaskToDelayedList( portMAX_DELAY, pdTRUE );
+                xShouldDelay = pdTRUE;
+
+                /* All ports are written to allow a yield in a critical
+                 * section (some will yield immediately, others wait until the
+                 * critical section exits) - but it is not something that
+                 * application code should ever do. */
+                portYIELD_WITHIN_API();
+                taskEXIT_CRITICAL();
+                taskENTER_CRITICAL();
+            }
+
+            pxCurrentTCB->ucWaitingForMode = pdFALSE;
+
+            /* Release the next job with the new parameters.  After a change
+             * it is released at the end of the old period, after the task was
+             * enabled it is released at the tick it was enabled. */
+            xReleaseTime = pxCurrentTCB->xTaskNextRelease;
+            uxJobIndex = pxCurrentTCB->uxJobsReleased;
+            pxCurrentTCB->xTaskNextRelease = xReleaseTime + pxCurrentTCB->xTaskPeriod;
+            pxCurrentTCB->xTaskAbsoluteDeadline = xReleaseTime + pxCurrentTCB->xTaskRelativeDeadline;
+            pxCurrentTCB->ucHasDeadline = pdTRUE;
+            ( pxCurrentTCB->uxJobsReleased )++;
+            taskEDF_START_JOB_BUDGET();
+            taskEDF_RELEASE_JOB_STATISTICS();
+
+            xTimeToWait = xReleaseTime - xTickCount;
+
+            if( ( xTimeToWait > ( TickType_t ) 0U ) && ( xTimeToWait <= ( portMAX_DELAY >> 1 ) ) )
+            {
+                traceTASK_DELAY_UNTIL( xReleaseTime );
+                prvAddCurrentTaskToDelayedList( xTimeToWait, pdFALSE );
+                portYIELD_WITHIN_API();
+                xShouldDelay = pdTRUE;
+            }
+            else
+            {
+                prvEDFRepositionReadyTask( pxCurrentTCB );
+                portYIELD_WITHIN_API();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* A job released without the task having to wait starts now. */
+        taskEDF_RECORD_JOB_START();
+
+        if( pxJob != NULL )
+        {
+            pxJob->uxJobIndex = uxJobIndex;
+            pxJob->xReleaseTime = xReleaseTime;
+            pxJob->xDeadline = xReleaseTime + pxCurrentTCB->xTaskRelativeDeadline;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xShouldDelay;
+    }
+    /*-----------------------------------------------------------*/
+
+    BaseType_t xTaskChangeMode( const ModeTaskParameters_t * const pxTasks,
+                                const UBaseType_t uxNumberOfTasks )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxIndex;
+        BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+
+        configASSERT( ( pxTasks != NULL ) || ( uxNumberOfTasks == ( UBaseType_t ) 0U ) );
+
+        taskENTER_CRITICAL();
+        {
+            if( uxModeChangesPending > ( UBaseType_t ) 0U )
+            {
+                /* Tasks still in the mode before the last one would have to
+                 * be allowed for by the admission test, and could be changed
+                 * twice before completing a job. */
+                xReturn = pdFAIL;
+            }
+
+            #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+                else if( prvEDFModeChangeTest( pxTasks, uxNumberOfTasks ) == pdFALSE )
+                {
+                    xReturn = pdFAIL;
+                }
+            #endif
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            for( uxIndex = ( UBaseType_t ) 0U; ( xReturn == pdPASS ) && ( uxIndex < uxNumberOfTasks ); uxIndex++ )
+            {
+                pxTCB = pxTasks[ uxIndex ].xTask;
+
+                /* Only a periodic task that is listed once can be changed. */
+                configASSERT( pxTCB != NULL );
+                configASSERT( pxTCB->xTaskPeriod > ( TickType_t ) 0U );
+                configASSERT( pxTCB->ucModeChangePending == pdFALSE );
+
+                #if ( configUSE_EDF_SPORADIC_TASKS == 1 )
+                    configASSERT( pxTCB->ucTaskSporadic == pdFALSE );
+                #endif
+
+                /* The mode replaces a change of period or deadline that is
+                 * still to be made. */
+                #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
                     {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
                         {
-                            xYieldRequired = pdTRUE;
+                            uxTimingChangesPending--;
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
-                    else
-                    {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
-                    }
-                }
-                else if( pxTCB == pxCurrentTCB )
+                #endif
+
+                pxTCB->xPendingPeriod = ( TickType_t ) 0U;
+                pxTCB->xPendingRelativeDeadline = ( TickType_t ) 0U;
+                pxTCB->xModePeriod = pxTasks[ uxIndex ].xPeriod;
+                pxTCB->xModeWcet = pxTasks[ uxIndex ].xWcet;
+
+                /* A relative deadline of zero means the deadline is implicit. */
+                if( pxTasks[ uxIndex ].xRelativeDeadline == ( TickType_t ) 0U )
                 {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
+                    pxTCB->xModeRelativeDeadline = pxTasks[ uxIndex ].xPeriod;
                 }
                 else
                 {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
+                    pxTCB->xModeRelativeDeadline = pxTasks[ uxIndex ].xRelativeDeadline;
                 }
 
-                /* Remember the ready list the task might be referenced from
-                 * before its uxPriority member is changed so the
-                 * taskRESET_READY_PRIORITY() macro can function correctly. */
-                uxPriorityUsedOnEntry = pxTCB->uxPriority;
+                #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+                    {
+                        prvEDFClaimUtilisation( pxTCB, pxTCB->xModeWcet, pxTCB->xModePeriod );
+                    }
+                #endif
 
-                #if ( configUSE_MUTEXES == 1 )
+                pxTCB->ucModeChangePending = pdTRUE;
+                uxModeChangesPending++;
+
+                if( pxTCB->ucWaitingForMode != pdFALSE )
+                {
+                    /* A disabled task has no job to complete first. */
+                    prvEDFApplyModeChange( pxTCB );
+
+                    if( pxTCB->ucModeDisabled == pdFALSE )
                     {
-                        /* Only change the priority being used if the task is not
-                         * currently using an inherited priority. */
-                        if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+                        /* Its first job is released now, and it is ordered by
+                         * the deadline of that job. */
+                        pxTCB->ucWaitingForMode = pdFALSE;
+                        pxTCB->xTaskNextRelease = xTickCount;
+                        pxTCB->xTaskAbsoluteDeadline = xTickCount + pxTCB->xTaskRelativeDeadline;
+                        pxTCB->ucHasDeadline = pdTRUE;
+
+                        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                         {
-                            pxTCB->uxPriority = uxNewPriority;
+                            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                            prvAddTaskToReadyList( pxTCB );
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            /* The delayed and ready lists cannot be accessed,
+                             * so hold this task pending until the scheduler is
+                             * resumed. */
+                            listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                         }
 
-                        /* The base priority gets set whatever. */
-                        pxTCB->uxBasePriority = uxNewPriority;
-                    }
-                #else /* if ( configUSE_MUTEXES == 1 ) */
-                    {
-                        pxTCB->uxPriority = uxNewPriority;
-                    }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
-
-                /* Only reset the event list item value if the value is not
-                 * being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* If the task is in the blocked or suspended list we need do
-                 * nothing more than change its priority variable. However, if
-                 * the task is in a ready list it needs to be removed and placed
-                 * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    /* The task is currently in its ready list - remove before
-                     * adding it to its new ready list.  As we are in a critical
-                     * section we can do this even if the scheduler is suspended. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+                        if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                if( xYieldRequired != pdFALSE )
-                {
-                    taskYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+            }
 
-                /* Remove compiler warning about unused variables when the port
-                 * optimised task selection is not being used. */
-                ( void ) uxPriorityUsedOnEntry;
+            if( xYieldRequired != pdFALSE )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         taskEXIT_CRITICAL();
+
+        return xReturn;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_vTaskPrioritySet */
+    UBaseType_t uxTaskGetPendingModeChanges( void )
+    {
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            uxReturn = uxModeChangesPending;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_EDF_MODE_CHANGES */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
 
-    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    static void prvEDFStartJobBudget( void )
     {
-        TCB_t * pxTCB;
+        configRUN_TIME_COUNTER_TYPE ulTimeNow;
 
-        taskENTER_CRITICAL();
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+        #else
+            ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* The time the task has run since it was switched in belongs to the
+         * job that has just completed, so account for it here rather than
+         * charge it to the new job at the next context switch. */
+        if( ulTimeNow > ulTaskSwitchedInTime )
         {
-            /* If null is passed in here then it is the running task that is
-             * being suspended. */
-            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+            pxCurrentTCB->ulRunTimeCounter += ( ulTimeNow - ulTaskSwitchedInTime );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            traceTASK_SUSPEND( pxTCB );
+        ulTaskSwitchedInTime = ulTimeNow;
 
-            /* Remove task from the ready/delayed list and place in the
-             * suspended list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-            {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        /* The caller repositions or blocks the task, which takes a demoted
+         * task out of the background. */
+        pxCurrentTCB->ulJobExecutionTime = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+        pxCurrentTCB->ucBudgetExhausted = pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
 
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+    static BaseType_t prvEDFJobBudgetExpired( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTimeNow;
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( pxCurrentTCB->ulJobBudget > ( configRUN_TIME_COUNTER_TYPE ) 0U ) && ( pxCurrentTCB->ucBudgetExhausted == pdFALSE ) )
+        {
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTimeNow );
+            #else
+                ulTimeNow = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            if( ( ulTimeNow > ulTaskSwitchedInTime ) &&
+                ( ( pxCurrentTCB->ulJobExecutionTime + ( ulTimeNow - ulTaskSwitchedInTime ) ) > pxCurrentTCB->ulJobBudget ) )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                xReturn = pdTRUE;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
 
-            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    static void prvEDFEnforceJobBudget( TCB_t * const pxTCB )
+    {
+        #if ( configEDF_OVERRUN_POLICY == tskOVERRUN_THROTTLE )
+            TickType_t xTimeToWait;
+        #endif
+
+        if( ( pxTCB->ulJobBudget > ( configRUN_TIME_COUNTER_TYPE ) 0U ) &&
+            ( pxTCB->ucBudgetExhausted == pdFALSE ) &&
+            ( pxTCB->ulJobExecutionTime > pxTCB->ulJobBudget ) )
+        {
+            pxTCB->ucBudgetExhausted = pdTRUE;
+            ( pxTCB->uxBudgetOverruns )++;
+
+            traceTASK_BUDGET_OVERRUN( pxTCB, pxTCB->ulJobExecutionTime );
+
+            #if ( configUSE_BUDGET_OVERRUN_HOOK == 1 )
                 {
-                    BaseType_t x;
+                    vApplicationBudgetOverrunHook( ( TaskHandle_t ) pxTCB, pxTCB->ulJobExecutionTime );
+                }
+            #endif
 
-                    for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+            #if ( configEDF_OVERRUN_POLICY == tskOVERRUN_THROTTLE )
+                {
+                    /* The next release is a period after the release of the
+                     * current job, which for a sporadic task is the earliest
+                     * it can next be released. */
+                    xTimeToWait = ( pxTCB->xTaskAbsoluteDeadline - pxTCB->xTaskRelativeDeadline + pxTCB->xTaskPeriod ) - xTickCount;
+
+                    /* Only a Ready job can be delayed, a Blocked one is demoted
+                     * instead, as is a job that has already run into the
+                     * period of the next one. */
+                    if( taskEDF_IS_IN_READY_QUEUE( pxTCB ) &&
+                        ( xTimeToWait > ( TickType_t ) 0U ) &&
+                        ( xTimeToWait <= ( portMAX_DELAY >> 1 ) ) )
                     {
-                        if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                        {
-                            /* The task was blocked to wait for a notification, but is
-                             * now suspended, so no notification was received. */
-                            pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
-                        }
+                        /* The job continues with a new budget when the task
+                         * wakes. */
+                        pxTCB->ulJobExecutionTime = ( configRUN_TIME_COUNTER_TYPE ) 0U;
+                        pxTCB->ucBudgetExhausted = pdFALSE;
+                        prvAddCurrentTaskToDelayedList( xTimeToWait, pdFALSE );
+                    }
+                    else
+                    {
+                        prvEDFRepositionReadyTask( pxTCB );
                     }
                 }
-            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+            #elif ( configEDF_OVERRUN_POLICY == tskOVERRUN_DEMOTE )
+                {
+                    /* Move the job into the background if it is Ready,
+                     * otherwise it is placed there when it is next readied. */
+                    prvEDFRepositionReadyTask( pxTCB );
+                }
+            #endif /* configEDF_OVERRUN_POLICY */
         }
-        taskEXIT_CRITICAL();
-
-        if( xSchedulerRunning != pdFALSE )
+        else
         {
-            /* Reset the next expected unblock time in case it referred to the
-             * task that is now in the Suspended state. */
-            taskENTER_CRITICAL();
-            {
-                prvResetNextTaskUnblockTime();
-            }
-            taskEXIT_CRITICAL();
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    void vTaskSetJobBudget( TaskHandle_t xTask,
+                            configRUN_TIME_COUNTER_TYPE ulBudget )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* Only a periodic or sporadic task starts new jobs, which is
+             * when the budget is renewed. */
+            configASSERT( ( ulBudget == ( configRUN_TIME_COUNTER_TYPE ) 0U ) || ( pxTCB->xTaskPeriod > ( TickType_t ) 0U ) );
+
+            pxTCB->ulJobBudget = ulBudget;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_EDF_BUDGET_ENFORCEMENT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_JOB_STATISTICS == 1 )
+
+    static void prvEDFRecordJobStart( TCB_t * const pxTCB )
+    {
+        if( pxTCB->ucJobStarted == pdFALSE )
+        {
+            pxTCB->xJobStartTime = xTickCount;
+            pxTCB->ucJobStarted = pdTRUE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+    }
+    /*-----------------------------------------------------------*/
 
-        if( pxTCB == pxCurrentTCB )
+    static void prvEDFRecordJobCompletion( TCB_t * const pxTCB,
+                                           const TickType_t xTimeNow )
+    {
+        TaskJobStatistics_t * const pxStats = &( pxTCB->xJobStatistics );
+        const TickType_t xRelease = pxTCB->xTaskAbsoluteDeadline - pxTCB->xTaskRelativeDeadline;
+        TickType_t xResponseTime, xStartDelay;
+
+        if( pxTCB->ucJobStarted == pdFALSE )
         {
-            if( xSchedulerRunning != pdFALSE )
-            {
-                /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
-            {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
-                {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
-                }
-                else
-                {
-                    vTaskSwitchContext();
-                }
-            }
+            pxTCB->xJobStartTime = xTimeNow;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The first job of a task that does not wait for its release can run
+         * before it, count it as started on release. */
+        xStartDelay = pxTCB->xJobStartTime - xRelease;
+
+        if( xStartDelay > ( portMAX_DELAY >> 1 ) )
+        {
+            pxTCB->xJobStartTime = xRelease;
+            xStartDelay = ( TickType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xResponseTime = xTimeNow - xRelease;
+
+        if( xResponseTime > ( portMAX_DELAY >> 1 ) )
+        {
+            xResponseTime = ( TickType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStats->xLastRelease = xRelease;
+        pxStats->xLastStart = pxTCB->xJobStartTime;
+        pxStats->xLastCompletion = xTimeNow;
+        pxStats->xLastDeadline = pxTCB->xTaskAbsoluteDeadline;
+
+        if( xResponseTime < pxStats->xMinResponseTime )
+        {
+            pxStats->xMinResponseTime = xResponseTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xResponseTime > pxStats->xMaxResponseTime )
+        {
+            pxStats->xMaxResponseTime = xResponseTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xStartDelay < pxStats->xMinStartDelay )
+        {
+            pxStats->xMinStartDelay = xStartDelay;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xStartDelay > pxStats->xMaxStartDelay )
+        {
+            pxStats->xMaxStartDelay = xStartDelay;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        pxStats->ulTotalResponseTime += ( uint32_t ) xResponseTime;
+        ( pxStats->uxJobsCompleted )++;
     }
 
-#endif /* INCLUDE_vTaskSuspend */
+#endif /* configUSE_EDF_JOB_STATISTICS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
 
-    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+    BaseType_t xTaskSetTimeTriggeredSchedule( const TimeTriggeredSchedule_t * const pxSchedule,
+                                              TaskHandle_t const * const pxTasks,
+                                              const UBaseType_t uxNumberOfTasks )
     {
-        BaseType_t xReturn = pdFALSE;
-        const TCB_t * const pxTCB = xTask;
+        const TimeTriggeredSlot_t * pxSlot;
+        UBaseType_t uxSlot;
+        BaseType_t xReturn = pdPASS;
 
-        /* Accesses xPendingReadyList so must be called from a critical
-         * section. */
+        configASSERT( pxSchedule );
+        configASSERT( pxTasks );
 
-        /* It does not make sense to check if the calling task is suspended. */
-        configASSERT( xTask );
+        /* The dispatcher follows the table from the tick interrupt without
+         * checking it, so the table cannot be changed once it is in use. */
+        configASSERT( xSchedulerRunning == pdFALSE );
 
-        /* Is the task being resumed actually in the suspended list? */
-        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        /* The first slot starts the hyperperiod, and every slot must start
+         * after the one before it and name a task that exists. */
+        if( ( pxSchedule->uxNumberOfSlots == ( UBaseType_t ) 0U ) || ( pxSchedule->pxSlots[ 0 ].xStartTime != ( TickType_t ) 0U ) )
         {
-            /* Has the task already been resumed from within an ISR? */
-            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( uxSlot = ( UBaseType_t ) 0U; ( uxSlot < pxSchedule->uxNumberOfSlots ) && ( xReturn != pdFAIL ); uxSlot++ )
+        {
+            pxSlot = &( pxSchedule->pxSlots[ uxSlot ] );
+
+            if( pxSlot->xStartTime >= pxSchedule->xHyperperiod )
             {
-                /* Is it in the suspended list because it is in the Suspended
-                 * state, or because is is blocked with no timeout? */
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
-                {
-                    xReturn = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                xReturn = pdFAIL;
+            }
+            else if( ( uxSlot > ( UBaseType_t ) 0U ) && ( pxSlot->xStartTime <= pxSchedule->pxSlots[ uxSlot - ( UBaseType_t ) 1U ].xStartTime ) )
+            {
+                xReturn = pdFAIL;
+            }
+            else if( ( pxSlot->ucTask != tskTT_IDLE_SLOT ) &&
+                     ( ( ( UBaseType_t ) pxSlot->ucTask >= uxNumberOfTasks ) || ( pxTasks[ pxSlot->ucTask ] == NULL ) ) )
+            {
+                xReturn = pdFAIL;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+
+        if( xReturn != pdFAIL )
+        {
+            pxTTSchedule = pxSchedule;
+            pxTTTasks = pxTasks;
+        }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
         return xReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+    }
+    /*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_vTaskSuspend */
-/*-----------------------------------------------------------*/
+    void vTaskWaitForNextSlot( void )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* Calling this function completes the job that was running. */
+            pxCurrentTCB->ucSlotJobActive = pdFALSE;
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+            if( pxCurrentTCB->ucSlotReleasePending == pdFALSE )
+            {
+                /* Wait for the next release slot of the task.  The slot
+                 * readies the task, the loop only repeats if something else
+                 * did. */
+                pxCurrentTCB->ucWaitingForSlot = pdTRUE;
 
-    void vTaskResume( TaskHandle_t xTaskToResume )
-    {
-        TCB_t * const pxTCB = xTaskToResume;
+                do
+                {
+                    prvAddCurrentTaskToDelayedList( portMAX_DELAY, pdTRUE );
 
-        /* It does not make sense to resume the calling task. */
-        configASSERT( xTaskToResume );
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until
+                     * the critical section exits) - but it is not something
+                     * that application code should ever do. */
+                    portYIELD_WITHIN_API();
+                    taskEXIT_CRITICAL();
+                    taskENTER_CRITICAL();
+                } while( pxCurrentTCB->ucWaitingForSlot != pdFALSE );
+            }
+            else
+            {
+                /* The next job was released before the task got here, it
+                 * starts straight away. */
+                pxCurrentTCB->ucSlotReleasePending = pdFALSE;
+            }
 
-        /* The parameter cannot be NULL as it is impossible to resume the
-         * currently executing task. */
-        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
+            pxCurrentTCB->ucSlotJobActive = pdTRUE;
+        }
+        taskEXIT_CRITICAL();
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvTTStartNextSlot( void )
+    {
+        const TimeTriggeredSlot_t * const pxSlot = &( pxTTSchedule->pxSlots[ uxTTNextSlot ] );
+        TCB_t * pxTCB = NULL;
+
+        if( pxSlot->ucTask != tskTT_IDLE_SLOT )
         {
-            taskENTER_CRITICAL();
+            pxTCB = pxTTTasks[ pxSlot->ucTask ];
+
+            if( pxSlot->ucRelease != pdFALSE )
             {
-                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                if( pxTCB->ucWaitingForSlot != pdFALSE )
                 {
-                    traceTASK_RESUME( pxTCB );
-
-                    /* The ready list can be accessed even if the scheduler is
-                     * suspended because this is inside a critical section. */
+                    pxTCB->ucWaitingForSlot = pdFALSE;
                     ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
                     prvAddTaskToReadyList( pxTCB );
-
-                    /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                }
+                else
+                {
+                    /* The job is held until the task waits for it.  If the
+                     * previous job is still running it has overrun the slots
+                     * the table gave it. */
+                    if( pxTCB->ucSlotJobActive != pdFALSE )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        ( pxTCB->uxSlotOverruns )++;
+                        traceTASK_SLOT_OVERRUN( pxTCB );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+
+                    pxTCB->ucSlotReleasePending = pdTRUE;
                 }
             }
-            taskEXIT_CRITICAL();
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
 
-#endif /* INCLUDE_vTaskSuspend */
+        pxTTSlotTCB = pxTCB;
 
-/*-----------------------------------------------------------*/
+        /* Slot start times are offsets into the hyperperiod, which repeats
+         * from the first slot. */
+        uxTTNextSlot++;
 
-#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+        if( uxTTNextSlot < pxTTSchedule->uxNumberOfSlots )
+        {
+            xTTNextSlotTime += pxTTSchedule->pxSlots[ uxTTNextSlot ].xStartTime - pxSlot->xStartTime;
+        }
+        else
+        {
+            uxTTNextSlot = ( UBaseType_t ) 0U;
+            xTTNextSlotTime += pxTTSchedule->xHyperperiod - pxSlot->xStartTime;
+        }
+    }
 
-    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
-    {
-        BaseType_t xYieldRequired = pdFALSE;
-        TCB_t * const pxTCB = xTaskToResume;
-        UBaseType_t uxSavedInterruptStatus;
+#endif /* configUSE_TIME_TRIGGERED_SCHEDULER */
+/*-----------------------------------------------------------*/
 
-        configASSERT( xTaskToResume );
+#if ( INCLUDE_vTaskDelay == 1 )
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    void vTaskDelay( const TickType_t xTicksToDelay )
+    {
+        BaseType_t xAlreadyYielded = pdFALSE;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        /* A delay time of zero just forces a reschedule. */
+        if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            configASSERT( uxSchedulerSuspended == 0 );
+            vTaskSuspendAll();
             {
-                traceTASK_RESUME_FROM_ISR( pxTCB );
-
-                /* Check the ready lists can be accessed. */
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-                {
-                    /* Ready lists can be accessed so move the task from the
-                     * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        xYieldRequired = pdTRUE;
+                traceTASK_DELAY();
 
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
+                /* A task that is removed from the event list while the
+                 * scheduler is suspended will not get placed in the ready
+                 * list or removed from the blocked list until the scheduler
+                 * is resumed.
+                 *
+                 * This task cannot be in an event list as it is the currently
+                 * executing task. */
+                #if ( configUSE_EDF_SCHEDULER == 1 )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* A periodic task that delays itself has completed its
+                         * job, the next one is released when the task wakes. */
+                        if( pxCurrentTCB->xTaskPeriod > ( TickType_t ) 0U )
+                        {
+                            prvCheckForDeadlineMiss( pxCurrentTCB, xTickCount, pdTRUE );
+                            taskEDF_DELAY_MODE_CHANGE();
+                            prvEDFApplyPendingTiming( pxCurrentTCB );
+                            pxCurrentTCB->xTaskAbsoluteDeadline = xTickCount + xTicksToDelay + pxCurrentTCB->xTaskRelativeDeadline;
+                            taskEDF_START_JOB_BUDGET();
+                            taskEDF_RELEASE_JOB_STATISTICS();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
+                #endif
 
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    /* The delayed or ready lists cannot be accessed so the task
-                     * is held in the pending ready list until the scheduler is
-                     * unsuspended. */
-                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
             }
+            xAlreadyYielded = xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-        return xYieldRequired;
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+#endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
-{
-    BaseType_t xReturn;
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
-    /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-        {
-            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-            StackType_t * pxIdleTaskStackBuffer = NULL;
-            uint32_t ulIdleTaskStackSize;
+    eTaskState eTaskGetState( TaskHandle_t xTask )
+    {
+        eTaskState eReturn;
+        List_t const * pxStateList, * pxDelayedList, * pxOverflowedDelayedList;
+        const TCB_t * const pxTCB = xTask;
 
-            /* The Idle task is created using user provided RAM - obtain the
-             * address of the RAM then create the idle task. */
-            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                                 configIDLE_TASK_NAME,
-                                                 ulIdleTaskStackSize,
-                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                                 pxIdleTaskStackBuffer,
-                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        configASSERT( pxTCB );
 
-            if( xIdleTaskHandle != NULL )
-            {
-                xReturn = pdPASS;
-            }
-            else
-            {
-                xReturn = pdFAIL;
-            }
-        }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+        if( pxTCB == pxCurrentTCB )
         {
-            /* The Idle task is being created using dynamically allocated RAM. */
-					
-					#if (configUSE_EDF_SCHEDULER == 1)
-						TickType_t initIDLEPeriod = 1000;
-						xReturn = xTaskPeriodicCreate( 	prvIdleTask,
-																						configIDLE_TASK_NAME, 
-																						configMINIMAL_STACK_SIZE, 
-																						( void * ) NULL,
-																						( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
-																						&xIdleTaskHandle,
-																						initIDLEPeriod );
-				}
-					#else
-            xReturn = xTaskCreate( prvIdleTask,
-                                   configIDLE_TASK_NAME,
-                                   configMINIMAL_STACK_SIZE,S
-                                   ( void * ) NULL,
-                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+            /* The task calling this function is querying its own state. */
+            eReturn = eRunning;
         }
-				#endif
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
-
-    #if ( configUSE_TIMERS == 1 )
+        else
         {
-            if( xReturn == pdPASS )
-            {
-                xReturn = xTimerCreateTimerTask();
-            }
-            else
+            taskENTER_CRITICAL();
             {
-                mtCOVERAGE_TEST_MARKER();
+                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+                pxDelayedList = pxDelayedTaskList;
+                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
             }
-        }
-    #endif /* configUSE_TIMERS */
+            taskEXIT_CRITICAL();
 
-    if( xReturn == pdPASS )
-    {
-        /* freertos_tasks_c_additions_init() should only be called if the user
-         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
-         * the only macro called by the function. */
-        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
             {
-                freertos_tasks_c_additions_init();
+                /* The task being queried is referenced from one of the Blocked
+                 * lists. */
+                eReturn = eBlocked;
             }
-        #endif
 
-        /* Interrupts are turned off here, to ensure a tick does not occur
-         * before or during the call to xPortStartScheduler().  The stacks of
-         * the created tasks contain a status word with interrupts switched on
-         * so interrupts will automatically get re-enabled when the first task
-         * starts to run. */
-        portDISABLE_INTERRUPTS();
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                else if( pxStateList == &xSuspendedTaskList )
+                {
+                    /* The task being queried is referenced from the suspended
+                     * list.  Is it genuinely suspended or is it blocked
+                     * indefinitely? */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
+                    {
+                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                            {
+                                BaseType_t x;
 
-        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+                                /* The task does not appear on the event list item of
+                                 * and of the RTOS objects, but could still be in the
+                                 * blocked state if it is waiting on its notification
+                                 * rather than waiting on an object.  If not, is
+                                 * suspended. */
+                                eReturn = eSuspended;
+
+                                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                                {
+                                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                                    {
+                                        eReturn = eBlocked;
+                                        break;
+                                    }
+                                }
+                            }
+                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                            {
+                                eReturn = eSuspended;
+                            }
+                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                    }
+                    else
+                    {
+                        eReturn = eBlocked;
+                    }
+                }
+            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
+                {
+                    /* The task being queried is referenced from the deleted
+                     * tasks list, or it is not referenced from any lists at
+                     * all. */
+                    eReturn = eDeleted;
+                }
+            #endif
+
+            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
             {
-                /* Switch Newlib's _impure_ptr variable to point to the _reent
-                 * structure specific to the task that will run first.
-                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-                 * for additional information. */
-                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+                /* If the task is not in any other state, it must be in the
+                 * Ready (including pending ready) state. */
+                eReturn = eReady;
             }
-        #endif /* configUSE_NEWLIB_REENTRANT */
+        }
 
-        xNextTaskUnblockTime = portMAX_DELAY;
-        xSchedulerRunning = pdTRUE;
-        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+        return eReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
 
-        /* If configGENERATE_RUN_TIME_STATS is defined then the following
-         * macro must be defined to configure the timer/counter used to generate
-         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
-         * is set to 0 and the following line fails to build then ensure you do not
-         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
-         * FreeRTOSConfig.h file. */
-        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+#endif /* INCLUDE_eTaskGetState */
+/*-----------------------------------------------------------*/
 
-        traceTASK_SWITCHED_IN();
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
 
-        /* Setting up the timer tick is hardware specific and thus in the
-         * portable interface. */
-        if( xPortStartScheduler() != pdFALSE )
-        {
-            /* Should not reach here as if the scheduler is running the
-             * function will not return. */
-        }
-        else
+    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
         {
-            /* Should only reach here if a task calls xTaskEndScheduler(). */
+            /* If null is passed in here then it is the priority of the task
+             * that called uxTaskPriorityGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
         }
-    }
-    else
-    {
-        /* This line will only be reached if the kernel could not be started,
-         * because there was not enough FreeRTOS heap to create the idle task
-         * or the timer task. */
-        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
-    }
+        taskEXIT_CRITICAL();
 
-    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
-     * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
+        return uxReturn;
+    }
 
-    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
-     * from getting optimized out as it is no longer used by the kernel. */
-    ( void ) uxTopUsedPriority;
-}
+#endif /* INCLUDE_uxTaskPriorityGet */
 /*-----------------------------------------------------------*/
 
-void vTaskEndScheduler( void )
-{
-    /* Stop the scheduler interrupts and call the portable scheduler end
-     * routine so the original ISRs can be restored if necessary.  The port
-     * layer must ensure interrupts enable  bit is left in the correct state. */
-    portDISABLE_INTERRUPTS();
-    xSchedulerRunning = pdFALSE;
-    vPortEndScheduler();
-}
-/*----------------------------------------------------------*/
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
 
-void vTaskSuspendAll( void )
-{
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
+    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn, uxSavedInterruptState;
 
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
+        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
 
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
-}
-/*----------------------------------------------------------*/
+        return uxReturn;
+    }
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
 
-    static TickType_t prvGetExpectedIdleTime( void )
-    {
-        TickType_t xReturn;
-        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+#if ( INCLUDE_vTaskPrioritySet == 1 )
 
-        /* uxHigherPriorityReadyTasks takes care of the case where
-         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-         * task that are in the Ready state, even though the idle task is
-         * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
-            {
-                if( uxTopReadyPriority > tskIDLE_PRIORITY )
-                {
-                    uxHigherPriorityReadyTasks = pdTRUE;
-                }
-            }
-        #else
-            {
-                const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+    void vTaskPrioritySet( TaskHandle_t xTask,
+                           UBaseType_t uxNewPriority )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
+        BaseType_t xYieldRequired = pdFALSE;
 
-                /* When port optimised task selection is used the uxTopReadyPriority
-                 * variable is used as a bit map.  If bits other than the least
-                 * significant bit are set then there are tasks that have a priority
-                 * above the idle priority that are in the Ready state.  This takes
-                 * care of the case where the co-operative scheduler is in use. */
-                if( uxTopReadyPriority > uxLeastSignificantBit )
-                {
-                    uxHigherPriorityReadyTasks = pdTRUE;
-                }
-            }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+        configASSERT( uxNewPriority < configMAX_PRIORITIES );
 
-        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
-        {
-            xReturn = 0;
-        }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
-        {
-            /* There are other idle priority tasks in the ready state.  If
-             * time slicing is used then the very next tick interrupt must be
-             * processed. */
-            xReturn = 0;
-        }
-        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        /* Ensure the new priority is valid. */
+        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
         {
-            /* There are tasks in the Ready state that have a priority above the
-             * idle priority.  This path can only be reached if
-             * configUSE_PREEMPTION is 0. */
-            xReturn = 0;
+            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
         }
         else
         {
-            xReturn = xNextTaskUnblockTime - xTickCount;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return xReturn;
-    }
-
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskResumeAll( void )
-{
-    TCB_t * pxTCB = NULL;
-    BaseType_t xAlreadyYielded = pdFALSE;
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
 
-    /* If uxSchedulerSuspended is zero then this function does not match a
-     * previous call to vTaskSuspendAll(). */
-    configASSERT( uxSchedulerSuspended );
+            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
 
-    /* It is possible that an ISR caused a task to be removed from an event
-     * list while the scheduler was suspended.  If this was the case then the
-     * removed task will have been added to the xPendingReadyList.  Once the
-     * scheduler has been resumed it is safe to move all the pending ready
-     * tasks from this list into their appropriate ready list. */
-    taskENTER_CRITICAL();
-    {
-        --uxSchedulerSuspended;
+            #if ( configUSE_MUTEXES == 1 )
+                {
+                    uxCurrentBasePriority = pxTCB->uxBasePriority;
+                }
+            #else
+                {
+                    uxCurrentBasePriority = pxTCB->uxPriority;
+                }
+            #endif
 
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-        {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            if( uxCurrentBasePriority != uxNewPriority )
             {
-                /* Move any readied tasks from the pending list into the
-                 * appropriate ready list. */
-                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                /* The priority change may have readied a task of higher
+                 * priority than the calling task. */
+                if( uxNewPriority > uxCurrentBasePriority )
                 {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    portMEMORY_BARRIER();
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    if( pxTCB != pxCurrentTCB )
                     {
-                        xYieldPending = pdTRUE;
+                        /* The priority of a task other than the currently
+                         * running task is being raised.  Is the priority being
+                         * raised above that of the running task? */
+                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The priority of the running task is being raised,
+                         * but the running task must already be the highest
+                         * priority task able to run so no yield is required. */
                     }
                 }
-
-                if( pxTCB != NULL )
+                else if( pxTCB == pxCurrentTCB )
                 {
-                    /* A task was unblocked while the scheduler was suspended,
-                     * which may have prevented the next unblock time from being
-                     * re-calculated, in which case re-calculate it now.  Mainly
-                     * important for low power tickless implementations, where
-                     * this can prevent an unnecessary exit from low power
-                     * state. */
-                    prvResetNextTaskUnblockTime();
+                    /* Setting the priority of the running task down means
+                     * there may now be another task of higher priority that
+                     * is ready to execute. */
+                    xYieldRequired = pdTRUE;
                 }
-
-                /* If any ticks occurred while the scheduler was suspended then
-                 * they should be processed now.  This ensures the tick count does
-                 * not  slip, and that any delayed tasks are resumed at the correct
-                 * time. */
+                else
                 {
-                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+                    /* Setting the priority of any other task down does not
+                     * require a yield as the running task must be above the
+                     * new priority of the task being modified. */
+                }
 
-                    if( xPendedCounts > ( TickType_t ) 0U )
+                /* Remember the ready list the task might be referenced from
+                 * before its uxPriority member is changed so the
+                 * taskRESET_READY_PRIORITY() macro can function correctly. */
+                uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+                #if ( configUSE_MUTEXES == 1 )
                     {
-                        do
+                        /* Only change the priority being used if the task is not
+                         * currently using an inherited priority. */
+                        if( pxTCB->uxBasePriority == pxTCB->uxPriority )
                         {
-                            if( xTaskIncrementTick() != pdFALSE )
-                            {
-                                xYieldPending = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
+                            pxTCB->uxPriority = uxNewPriority;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
 
-                        xPendedTicks = 0;
+                        /* The base priority gets set whatever. */
+                        pxTCB->uxBasePriority = uxNewPriority;
                     }
-                    else
+                #else /* if ( configUSE_MUTEXES == 1 ) */
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        pxTCB->uxPriority = uxNewPriority;
                     }
-                }
+                #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-                if( xYieldPending != pdFALSE )
+                /* Only reset the event list item value if the value is not
+                 * being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                 {
-                    #if ( configUSE_PREEMPTION != 0 )
-                        {
-                            xAlreadyYielded = pdTRUE;
-                        }
-                    #endif
-                    taskYIELD_IF_USING_PREEMPTION();
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    taskEXIT_CRITICAL();
-
-    return xAlreadyYielded;
-}
-/*-----------------------------------------------------------*/
-
-TickType_t xTaskGetTickCount( void )
-{
-    TickType_t xTicks;
-
-    /* Critical section required if running on a 16 bit processor. */
-    portTICK_TYPE_ENTER_CRITICAL();
-    {
-        xTicks = xTickCount;
-    }
-    portTICK_TYPE_EXIT_CRITICAL();
-
-    return xTicks;
-}
-/*-----------------------------------------------------------*/
-
-TickType_t xTaskGetTickCountFromISR( void )
-{
-    TickType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
-    {
-        xReturn = xTickCount;
-    }
-    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxTaskGetNumberOfTasks( void )
-{
-    /* A critical section is not required because the variables are of type
-     * BaseType_t. */
-    return uxCurrentNumberOfTasks;
-}
-/*-----------------------------------------------------------*/
-
-char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-{
-    TCB_t * pxTCB;
-
-    /* If null is passed in here then the name of the calling task is being
-     * queried. */
-    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-    configASSERT( pxTCB );
-    return &( pxTCB->pcTaskName[ 0 ] );
-}
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_xTaskGetHandle == 1 )
-
-    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
-                                                     const char pcNameToQuery[] )
-    {
-        TCB_t * pxNextTCB, * pxFirstTCB, * pxReturn = NULL;
-        UBaseType_t x;
-        char cNextChar;
-        BaseType_t xBreakLoop;
-
-        /* This function is called with the scheduler suspended. */
-
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
-        {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-            do
-            {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-                /* Check each character in the name looking for a match or
-                 * mismatch. */
-                xBreakLoop = pdFALSE;
 
-                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                /* If the task is in the blocked or suspended list we need do
+                 * nothing more than change its priority variable. However, if
+                 * the task is in a ready list it needs to be removed and placed
+                 * in the list appropriate to its new priority. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                 {
-                    cNextChar = pxNextTCB->pcTaskName[ x ];
-
-                    if( cNextChar != pcNameToQuery[ x ] )
-                    {
-                        /* Characters didn't match. */
-                        xBreakLoop = pdTRUE;
-                    }
-                    else if( cNextChar == ( char ) 0x00 )
+                    /* The task is currently in its ready list - remove before
+                     * adding it to its new ready list.  As we are in a critical
+                     * section we can do this even if the scheduler is suspended. */
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
-                        /* Both strings terminated, a match must have been
-                         * found. */
-                        pxReturn = pxNextTCB;
-                        xBreakLoop = pdTRUE;
+                        /* It is known that the task is in its ready list so
+                         * there is no need to check again and the port level
+                         * reset macro can be called directly. */
+                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    if( xBreakLoop != pdFALSE )
-                    {
-                        break;
-                    }
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
 
-                if( pxReturn != NULL )
+                if( xYieldRequired != pdFALSE )
                 {
-                    /* The handle has been found. */
-                    break;
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-            } while( pxNextTCB != pxFirstTCB );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
 
-        return pxReturn;
+                /* Remove compiler warning about unused variables when the port
+                 * optimised task selection is not being used. */
+                ( void ) uxPriorityUsedOnEntry;
+            }
+        }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* INCLUDE_xTaskGetHandle */
+#endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( INCLUDE_vTaskSuspend == 1 )
 
-    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
         TCB_t * pxTCB;
 
-        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
-        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
-
-        vTaskSuspendAll();
+        taskENTER_CRITICAL();
         {
-            /* Search the ready lists. */
-            do
-            {
-                uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+            /* If null is passed in here then it is the running task that is
+             * being suspended. */
+            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
 
-                if( pxTCB != NULL )
-                {
-                    /* Found the handle. */
-                    break;
-                }
-            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            traceTASK_SUSPEND( pxTCB );
 
-            /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            /* Remove task from the ready/delayed list and place in the
+             * suspended list. */
+            if( prvRemoveTaskFromStateList( pxTCB ) == ( UBaseType_t ) 0 )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            if( pxTCB == NULL )
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
-                {
-                    if( pxTCB == NULL )
-                    {
-                        /* Search the suspended list. */
-                        pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
-                    }
-                }
-            #endif
+            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
 
-            #if ( INCLUDE_vTaskDelete == 1 )
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
                 {
-                    if( pxTCB == NULL )
+                    BaseType_t x;
+
+                    for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
                     {
-                        /* Search the deleted list. */
-                        pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                        if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                        {
+                            /* The task was blocked to wait for a notification, but is
+                             * now suspended, so no notification was received. */
+                            pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                        }
                     }
                 }
-            #endif
+            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
         }
-        ( void ) xTaskResumeAll();
-
-        return pxTCB;
-    }
-
-#endif /* INCLUDE_xTaskGetHandle */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
+        taskEXIT_CRITICAL();
 
-    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
-                                      const UBaseType_t uxArraySize,
-                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
-    {	
-				#if configUSE_EDF_SCHEDULER == 0
-					UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
-				#else
-					UBaseType_t uxTask = 0;
-				#endif
-			
-        vTaskSuspendAll();
+        if( xSchedulerRunning != pdFALSE )
         {
-            /* Is there a space in the array for each task in the system? */
-            if( uxArraySize >= uxCurrentNumberOfTasks )
-            {
+            /* Reset the next expected unblock time in case it referred to the
+             * task that is now in the Suspended state. */
+            taskENTER_CRITICAL();
+            {
+                prvResetNextTaskUnblockTime();
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxTCB == pxCurrentTCB )
+        {
+            if( xSchedulerRunning != pdFALSE )
+            {
+                /* The current task has just been suspended. */
+                configASSERT( uxSchedulerSuspended == 0 );
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                /* The scheduler is not running, but the task that was pointed
+                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
+                 * must be adjusted to point to a different task. */
+                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                {
+                    /* No other tasks are ready, so set pxCurrentTCB back to
+                     * NULL so when the next task is created pxCurrentTCB will
+                     * be set to point to it no matter what its relative priority
+                     * is. */
+                    pxCurrentTCB = NULL;
+                }
+                else
+                {
+                    vTaskSwitchContext();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+    {
+        BaseType_t xReturn = pdFALSE;
+        const TCB_t * const pxTCB = xTask;
+
+        /* Accesses xPendingReadyList so must be called from a critical
+         * section. */
+
+        /* It does not make sense to check if the calling task is suspended. */
+        configASSERT( xTask );
+
+        /* Is the task being resumed actually in the suspended list? */
+        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            /* Has the task already been resumed from within an ISR? */
+            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            {
+                /* Is it in the suspended list because it is in the Suspended
+                 * state, or because is is blocked with no timeout? */
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskResume( TaskHandle_t xTaskToResume )
+    {
+        TCB_t * const pxTCB = xTaskToResume;
+
+        /* It does not make sense to resume the calling task. */
+        configASSERT( xTaskToResume );
+
+        /* The parameter cannot be NULL as it is impossible to resume the
+         * currently executing task. */
+        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                {
+                    traceTASK_RESUME( pxTCB );
+
+                    /* The ready list can be accessed even if the scheduler is
+                     * suspended because this is inside a critical section. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* A higher priority task may have just been resumed. */
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                    #else
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #endif
+                    {
+                        /* This yield may not cause the task just resumed to run,
+                         * but will leave the lists in the correct state for the
+                         * next yield. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+        TCB_t * const pxTCB = xTaskToResume;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToResume );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            {
+                traceTASK_RESUME_FROM_ISR( pxTCB );
+
+                /* Check the ready lists can be accessed. */
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    /* Ready lists can be accessed so move the task from the
+                     * suspended list to the ready list directly. */
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                    #else
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #endif
+                    {
+                        xYieldRequired = pdTRUE;
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the return value to initiate a context switch
+                         * from the ISR using portYIELD_FROM_ISR. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed or ready lists cannot be accessed so the task
+                     * is held in the pending ready list until the scheduler is
+                     * unsuspended. */
+                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xYieldRequired;
+    }
+
+#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
+    BaseType_t xReturn;
+
+    /* Add the idle task at the lowest priority. */
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+            StackType_t * pxIdleTaskStackBuffer = NULL;
+            uint32_t ulIdleTaskStackSize;
+
+            /* The Idle task is created using user provided RAM - obtain the
+             * address of the RAM then create the idle task. */
+            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                                 configIDLE_TASK_NAME,
+                                                 ulIdleTaskStackSize,
+                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                 pxIdleTaskStackBuffer,
+                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+            if( xIdleTaskHandle != NULL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+        {
+            /* The Idle task is being created using dynamically allocated RAM.
+             * With the EDF scheduler it has no deadline and is kept out of the
+             * EDF ready queue, see prvAddTaskToReadyList(). */
+            xReturn = xTaskCreate( prvIdleTask,
+                                   configIDLE_TASK_NAME,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+    #if ( configUSE_TIMERS == 1 )
+        {
+            if( xReturn == pdPASS )
+            {
+                xReturn = xTimerCreateTimerTask();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif /* configUSE_TIMERS */
+
+    if( xReturn == pdPASS )
+    {
+        /* freertos_tasks_c_additions_init() should only be called if the user
+         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
+         * the only macro called by the function. */
+        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+            {
+                freertos_tasks_c_additions_init();
+            }
+        #endif
+
+        /* Interrupts are turned off here, to ensure a tick does not occur
+         * before or during the call to xPortStartScheduler().  The stacks of
+         * the created tasks contain a status word with interrupts switched on
+         * so interrupts will automatically get re-enabled when the first task
+         * starts to run. */
+        portDISABLE_INTERRUPTS();
+
+        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+            {
+                /* Switch Newlib's _impure_ptr variable to point to the _reent
+                 * structure specific to the task that will run first.
+                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+                 * for additional information. */
+                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+            }
+        #endif /* configUSE_NEWLIB_REENTRANT */
+
+        xNextTaskUnblockTime = portMAX_DELAY;
+        xSchedulerRunning = pdTRUE;
+        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+
+        #if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+            {
+                /* The hyperperiod starts with the scheduler, the first slot
+                 * decides which task runs first. */
+                if( pxTTSchedule != NULL )
+                {
+                    uxTTNextSlot = ( UBaseType_t ) 0U;
+                    xTTNextSlotTime = xTickCount;
+                    prvTTStartNextSlot();
+                    taskSELECT_TIME_TRIGGERED_TASK();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif
+
+        /* If configGENERATE_RUN_TIME_STATS is defined then the following
+         * macro must be defined to configure the timer/counter used to generate
+         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
+         * is set to 0 and the following line fails to build then ensure you do not
+         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
+         * FreeRTOSConfig.h file. */
+        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+        traceTASK_SWITCHED_IN();
+
+        /* Setting up the timer tick is hardware specific and thus in the
+         * portable interface. */
+        if( xPortStartScheduler() != pdFALSE )
+        {
+            /* Should not reach here as if the scheduler is running the
+             * function will not return. */
+        }
+        else
+        {
+            /* Should only reach here if a task calls xTaskEndScheduler(). */
+        }
+    }
+    else
+    {
+        /* This line will only be reached if the kernel could not be started,
+         * because there was not enough FreeRTOS heap to create the idle task
+         * or the timer task. */
+        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
+    }
+
+    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
+     * meaning xIdleTaskHandle is not used anywhere else. */
+    ( void ) xIdleTaskHandle;
+
+    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
+     * from getting optimized out as it is no longer used by the kernel. */
+    ( void ) uxTopUsedPriority;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskEndScheduler( void )
+{
+    /* Stop the scheduler interrupts and call the portable scheduler end
+     * routine so the original ISRs can be restored if necessary.  The port
+     * layer must ensure interrupts enable  bit is left in the correct state. */
+    portDISABLE_INTERRUPTS();
+    xSchedulerRunning = pdFALSE;
+    vPortEndScheduler();
+}
+/*----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+    /* A critical section is not required as the variable is of type
+     * BaseType_t.  Please read Richard Barry's reply in the following link to a
+     * post in the FreeRTOS support forum before reporting this as a bug! -
+     * https://goo.gl/wu4acr */
+
+    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+     * do not otherwise exhibit real time behaviour. */
+    portSOFTWARE_BARRIER();
+
+    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+     * is used to allow calls to vTaskSuspendAll() to nest. */
+    ++uxSchedulerSuspended;
+
+    /* Enforces ordering for ports and optimised compilers that may otherwise place
+     * the above increment elsewhere. */
+    portMEMORY_BARRIER();
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    static TickType_t prvGetExpectedIdleTime( void )
+    {
+        TickType_t xReturn;
+        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+
+        /* uxHigherPriorityReadyTasks takes care of the case where
+         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
+         * task that are in the Ready state, even though the idle task is
+         * running. */
+        #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_EDF_PRIORITY_BANDS == 0 ) )
+            {
+                /* Jobs are Ready in the EDF ready queue, not the priority
+                 * ready lists.  While none is Ready no deadline or budget can
+                 * expire either, as both are only checked for Ready and
+                 * Running jobs, so the next event is the next task to unblock,
+                 * which includes the timer task at the next timer expiry. */
+                if( taskEDF_READY_QUEUE_IS_EMPTY() == pdFALSE )
+                {
+                    uxHigherPriorityReadyTasks = pdTRUE;
+                }
+            }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+            {
+                if( uxTopReadyPriority > tskIDLE_PRIORITY )
+                {
+                    uxHigherPriorityReadyTasks = pdTRUE;
+                }
+            }
+        #else
+            {
+                const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+
+                /* When port optimised task selection is used the uxTopReadyPriority
+                 * variable is used as a bit map.  If bits other than the least
+                 * significant bit are set then there are tasks that have a priority
+                 * above the idle priority that are in the Ready state.  This takes
+                 * care of the case where the co-operative scheduler is in use. */
+                if( uxTopReadyPriority > uxLeastSignificantBit )
+                {
+                    uxHigherPriorityReadyTasks = pdTRUE;
+                }
+            }
+        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+
+        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+        {
+            xReturn = 0;
+        }
+        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
+        {
+            /* There are other idle priority tasks in the ready state.  If
+             * time slicing is used then the very next tick interrupt must be
+             * processed. */
+            xReturn = 0;
+        }
+        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        {
+            /* There are tasks in the Ready state that have a priority above the
+             * idle priority.  This path can only be reached if
+             * configUSE_PREEMPTION is 0. */
+            xReturn = 0;
+        }
+        else
+        {
+            xReturn = xNextTaskUnblockTime - xTickCount;
+
+            #if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+                {
+                    /* The tick that starts the next slot must be processed. */
+                    if( ( pxTTSchedule != NULL ) && ( ( TickType_t ) ( xTTNextSlotTime - xTickCount ) < xReturn ) )
+                    {
+                        xReturn = xTTNextSlotTime - xTickCount;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    TCB_t * pxTCB = NULL;
+    BaseType_t xAlreadyYielded = pdFALSE;
+
+    /* If uxSchedulerSuspended is zero then this function does not match a
+     * previous call to vTaskSuspendAll(). */
+    configASSERT( uxSchedulerSuspended );
+
+    /* It is possible that an ISR caused a task to be removed from an event
+     * list while the scheduler was suspended.  If this was the case then the
+     * removed task will have been added to the xPendingReadyList.  Once the
+     * scheduler has been resumed it is safe to move all the pending ready
+     * tasks from this list into their appropriate ready list. */
+    taskENTER_CRITICAL();
+    {
+        --uxSchedulerSuspended;
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            {
+                /* Move any readied tasks from the pending list into the
+                 * appropriate ready list. */
+                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    portMEMORY_BARRIER();
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* If the moved task has a priority higher than or equal to
+                     * the current task then a yield must be performed. */
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                    #else
+                        if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    #endif
+                    {
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( pxTCB != NULL )
+                {
+                    /* A task was unblocked while the scheduler was suspended,
+                     * which may have prevented the next unblock time from being
+                     * re-calculated, in which case re-calculate it now.  Mainly
+                     * important for low power tickless implementations, where
+                     * this can prevent an unnecessary exit from low power
+                     * state. */
+                    prvResetNextTaskUnblockTime();
+                }
+
+                /* If any ticks occurred while the scheduler was suspended then
+                 * they should be processed now.  This ensures the tick count does
+                 * not  slip, and that any delayed tasks are resumed at the correct
+                 * time. */
+                {
+                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+                    if( xPendedCounts > ( TickType_t ) 0U )
+                    {
+                        do
+                        {
+                            if( xTaskIncrementTick() != pdFALSE )
+                            {
+                                xYieldPending = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            --xPendedCounts;
+                        } while( xPendedCounts > ( TickType_t ) 0U );
+
+                        xPendedTicks = 0;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xYieldPending != pdFALSE )
+                {
+                    #if ( configUSE_PREEMPTION != 0 )
+                        {
+                            xAlreadyYielded = pdTRUE;
+                        }
+                    #endif
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xAlreadyYielded;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCount( void )
+{
+    TickType_t xTicks;
+
+    /* Critical section required if running on a 16 bit processor. */
+    portTICK_TYPE_ENTER_CRITICAL();
+    {
+        xTicks = xTickCount;
+    }
+    portTICK_TYPE_EXIT_CRITICAL();
+
+    return xTicks;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCountFromISR( void )
+{
+    TickType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = xTickCount;
+    }
+    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+    /* A critical section is not required because the variables are of type
+     * BaseType_t. */
+    return uxCurrentNumberOfTasks;
+}
+/*-----------------------------------------------------------*/
+
+char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+    TCB_t * pxTCB;
+
+    /* If null is passed in here then the name of the calling task is being
+     * queried. */
+    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+    configASSERT( pxTCB );
+    return &( pxTCB->pcTaskName[ 0 ] );
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
+                                                     const char pcNameToQuery[] )
+    {
+        TCB_t * pxNextTCB, * pxFirstTCB, * pxReturn = NULL;
+        UBaseType_t x;
+        char cNextChar;
+        BaseType_t xBreakLoop;
+
+        /* This function is called with the scheduler suspended. */
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                /* Check each character in the name looking for a match or
+                 * mismatch. */
+                xBreakLoop = pdFALSE;
+
+                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                {
+                    cNextChar = pxNextTCB->pcTaskName[ x ];
+
+                    if( cNextChar != pcNameToQuery[ x ] )
+                    {
+                        /* Characters didn't match. */
+                        xBreakLoop = pdTRUE;
+                    }
+                    else if( cNextChar == ( char ) 0x00 )
+                    {
+                        /* Both strings terminated, a match must have been
+                         * found. */
+                        pxReturn = pxNextTCB;
+                        xBreakLoop = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xBreakLoop != pdFALSE )
+                    {
+                        break;
+                    }
+                }
+
+                if( pxReturn != NULL )
+                {
+                    /* The handle has been found. */
+                    break;
+                }
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        TCB_t * pxTCB;
+
+        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
+        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+
+        vTaskSuspendAll();
+        {
+            /* Search the ready lists. */
+            do
+            {
+                uxQueue--;
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+
+                if( pxTCB != NULL )
+                {
+                    /* Found the handle. */
+                    break;
+                }
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            /* Search the delayed lists. */
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+            }
+
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+            }
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    if( pxTCB == NULL )
+                    {
+                        /* Search the suspended list. */
+                        pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                    }
+                }
+            #endif
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    if( pxTCB == NULL )
+                    {
+                        /* Search the deleted list. */
+                        pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                    }
+                }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+
+        return pxTCB;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {	
+				#if ( configUSE_EDF_SCHEDULER == 0 ) || ( configUSE_EDF_PRIORITY_BANDS == 1 )
+					UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+				#else
+					UBaseType_t uxTask = 0;
+				#endif
+			
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
                 /* Fill in an TaskStatus_t structure with information on each
                  * task in the Ready state. */
-								#if configUSE_EDF_SCHEDULER == 0
+								#if ( configUSE_EDF_SCHEDULER == 0 ) || ( configUSE_EDF_PRIORITY_BANDS == 1 )
 									do
 									{
 											uxQueue--;
@@ -2686,6 +5078,7 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 									} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 								#else
 									uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xReadyTasksListEDF ), eReady );
+									uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ), eReady );
 								#endif
 							
                 /* Fill in an TaskStatus_t structure with information on each
@@ -2693,1066 +5086,2772 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
                 uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
-                #if ( INCLUDE_vTaskDelete == 1 )
+                #if ( INCLUDE_vTaskDelete == 1 )
+                    {
+                        /* Fill in an TaskStatus_t structure with information on
+                         * each task that has been deleted but not yet cleaned up. */
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+                    }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                    {
+                        /* Fill in an TaskStatus_t structure with information on
+                         * each task in the Suspended state. */
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+                    }
+                #endif
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                    {
+                        if( pulTotalRunTime != NULL )
+                        {
+                            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                                portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                            #else
+                                *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                            #endif
+                        }
+                    }
+                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                    {
+                        if( pulTotalRunTime != NULL )
+                        {
+                            *pulTotalRunTime = 0;
+                        }
+                    }
+                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    {
+        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+         * started, then xIdleTaskHandle will be NULL. */
+        configASSERT( ( xIdleTaskHandle != NULL ) );
+        return xIdleTaskHandle;
+    }
+
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
+/* This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure vTaskStepTick() is available when user defined low power mode
+ * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+ * 1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    void vTaskStepTick( const TickType_t xTicksToJump )
+    {
+        /* Correct the tick count value after a period during which the tick
+         * was suppressed.  Note this does *not* call the tick hook function for
+         * each stepped tick. */
+        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+        xTickCount += xTicksToJump;
+        traceINCREASE_TICK_COUNT( xTicksToJump );
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
+{
+    BaseType_t xYieldOccurred;
+
+    /* Must not be called with the scheduler suspended as the implementation
+     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+    configASSERT( uxSchedulerSuspended == 0 );
+
+    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+    vTaskSuspendAll();
+    xPendedTicks += xTicksToCatchUp;
+    xYieldOccurred = xTaskResumeAll();
+
+    return xYieldOccurred;
+}
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB = xTask;
+        BaseType_t xReturn;
+
+        configASSERT( pxTCB );
+
+        vTaskSuspendAll();
+        {
+            /* A task can only be prematurely removed from the Blocked state if
+             * it is actually in the Blocked state. */
+            if( eTaskGetState( xTask ) == eBlocked )
+            {
+                xReturn = pdPASS;
+
+                /* Remove the reference to the task from the blocked list.  An
+                 * interrupt won't touch the xStateListItem because the
+                 * scheduler is suspended. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list too.  Interrupts can touch the event list item,
+                 * even though the scheduler is suspended, so a critical section
+                 * is used. */
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+                        /* This lets the task know it was forcibly removed from the
+                         * blocked state so it should not re-evaluate its block time and
+                         * then block again. */
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* Preemption is on, but a context switch should only be
+                         * performed if the unblocked task has a priority that is
+                         * higher than the currently executing task. */
+                        #if ( configUSE_EDF_SCHEDULER == 1 )
+                            if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                        #else
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        #endif
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                #endif /* configUSE_PREEMPTION */
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+    TCB_t * pxTCB;
+    TickType_t xItemValue;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    /* Called by the portable layer each time a tick interrupt occurs.
+     * Increments the tick then checks to see if the new tick value will cause any
+     * tasks to be unblocked. */
+    traceTASK_INCREMENT_TICK( xTickCount );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+        /* Increment the RTOS tick, switching the delayed and overflowed
+         * delayed lists if it wraps to 0. */
+        xTickCount = xConstTickCount;
+
+        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+        {
+            taskSWITCH_DELAYED_LISTS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* See if this tick has made a timeout expire.  Tasks are stored in
+         * the  queue in the order of their wake time - meaning once one task
+         * has been found whose block time has not expired there is no need to
+         * look any further down the list. */
+        if( xConstTickCount >= xNextTaskUnblockTime )
+        {
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                {
+                    /* The delayed list is empty.  Set xNextTaskUnblockTime
+                     * to the maximum possible value so it is extremely
+                     * unlikely that the
+                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                     * next time through. */
+                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    break;
+                }
+                else
+                {
+                    /* The delayed list is not empty, get the value of the
+                     * item at the head of the delayed list.  This is the time
+                     * at which the task at the head of the delayed list must
+                     * be removed from the Blocked state. */
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                    if( xConstTickCount < xItemValue )
+                    {
+                        /* It is not time to unblock this item yet, but the
+                         * item value is the time at which the task at the head
+                         * of the blocked list must be removed from the Blocked
+                         * state -  so record the item value in
+                         * xNextTaskUnblockTime. */
+                        xNextTaskUnblockTime = xItemValue;
+                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* It is time to remove the item from the Blocked state. */
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+                    /* Is the task waiting on an event also?  If so remove
+                     * it from the event list. */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Place the unblocked task into the appropriate ready
+                     * list.  Under EDF the job keeps the deadline it was
+                     * released with, a job that timed out waiting for an
+                     * event has not been released again. */
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* A task being unblocked cannot cause an immediate
+                     * context switch if preemption is turned off. */
+                    #if ( configUSE_PREEMPTION == 1 )
+                        {
+                            /* Preemption is on, but a context switch should
+                             * only be performed if the unblocked task has a
+                             * priority that is equal to or higher than the
+                             * currently executing task, or under EDF an earlier
+                             * deadline. */
+                            #if ( configUSE_EDF_SCHEDULER == 1 )
+                                if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                            #else
+                                if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                            #endif
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    #endif /* configUSE_PREEMPTION */
+                }
+            }
+        }
+
+        #if ( configUSE_EDF_CBS == 1 )
+            {
+                /* The running task executed for the tick that has just ended,
+                 * if it is a server a new deadline might be needed. */
+                if( pxCurrentTCB->xCBSMaxBudget > ( TickType_t ) 0U )
+                {
+                    if( prvCBSChargeBudget( pxCurrentTCB ) != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_EDF_CBS */
+
+        #if ( configEDF_CHECK_DEADLINES_ON_TICK == 1 )
+            {
+                /* Only the Ready job with the earliest deadline can be the
+                 * first to expire, later ones are checked when they reach the
+                 * head of the ready queue or when they complete. */
+                #if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+                    {
+                        UBaseType_t uxBand;
+
+                        /* Each EDF band has its own earliest deadline. */
+                        for( uxBand = ( UBaseType_t ) ( configMAX_PRIORITIES - 1 ); uxBand > ( UBaseType_t ) tskIDLE_PRIORITY; uxBand-- )
+                        {
+                            if( taskEDF_BAND_IS_EDF( uxBand ) && ( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxBand ] ) ) == pdFALSE ) )
+                            {
+                                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ uxBand ] ) );
+                                prvCheckForDeadlineMiss( pxTCB, xConstTickCount, pdFALSE );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+                #else
+                    if( taskEDF_READY_QUEUE_IS_EMPTY() == pdFALSE )
+                    {
+                        pxTCB = taskGET_EARLIEST_DEADLINE_TCB();
+                        prvCheckForDeadlineMiss( pxTCB, xConstTickCount, pdFALSE );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                #endif /* configUSE_EDF_PRIORITY_BANDS */
+            }
+        #endif /* configEDF_CHECK_DEADLINES_ON_TICK */
+
+        #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+            {
+                /* A job that keeps the earliest deadline is never switched out,
+                 * so request a context switch for its overrun to be charged
+                 * and handled. */
+                if( prvEDFJobBudgetExpired() != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_EDF_BUDGET_ENFORCEMENT */
+
+        #if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+            {
+                if( pxTTSchedule != NULL )
+                {
+                    if( xConstTickCount == xTTNextSlotTime )
+                    {
+                        /* Every slot boundary is a dispatch point. */
+                        prvTTStartNextSlot();
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else if( ( pxTTSlotTCB != pxCurrentTCB ) && taskTT_SLOT_TASK_IS_READY() )
+                    {
+                        /* The task of the slot was readied by an event that
+                         * did not preempt the running task by priority. */
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_TIME_TRIGGERED_SCHEDULER */
+
+        /* Tasks of equal priority to the currently running task will share
+         * processing time (time slice) if preemption is on, and the application
+         * writer has not explicitly turned time slicing off. */
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+            {
+                #if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+                    /* The tasks of an EDF band run in deadline order, not in
+                     * turn. */
+                    if( ( !taskEDF_BAND_IS_EDF( pxCurrentTCB->uxPriority ) ) &&
+                        ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) )
+                #else
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                #endif
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+        #if ( configUSE_TICK_HOOK == 1 )
+            {
+                /* Guard against the tick hook being called when the pended tick
+                 * count is being unwound (when the scheduler is being unlocked). */
+                if( xPendedTicks == ( TickType_t ) 0 )
+                {
+                    vApplicationTickHook();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_TICK_HOOK */
+
+        #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( xYieldPending != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_PREEMPTION */
+    }
+    else
+    {
+        ++xPendedTicks;
+
+        /* The tick hook gets called at regular intervals, even if the
+         * scheduler is locked. */
+        #if ( configUSE_TICK_HOOK == 1 )
+            {
+                vApplicationTickHook();
+            }
+        #endif
+    }
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
+                                     TaskHookFunction_t pxHookFunction )
+    {
+        TCB_t * xTCB;
+
+        /* If xTask is NULL then it is the task hook of the calling task that is
+         * getting set. */
+        if( xTask == NULL )
+        {
+            xTCB = ( TCB_t * ) pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xTCB->pxTaskTag = pxHookFunction;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
+                                             void * pvParameter )
+    {
+        TCB_t * xTCB;
+        BaseType_t xReturn;
+
+        /* If xTask is NULL then we are calling our own task hook. */
+        if( xTask == NULL )
+        {
+            xTCB = pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+    {
+        /* The scheduler is currently suspended - do not allow a context
+         * switch. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xYieldPending = pdFALSE;
+        traceTASK_SWITCHED_OUT();
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                #else
+                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* Add the amount of time the task has been running to the
+                 * accumulated time so far.  The time the task started running was
+                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+                 * protection here so count values are only valid until the timer
+                 * overflows.  The guard against negative values is to protect
+                 * against suspect run time stat counter implementations - which
+                 * are provided by the application, not the kernel. */
+                if( ulTotalRunTime > ulTaskSwitchedInTime )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+
+                    #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+                        {
+                            pxCurrentTCB->ulJobExecutionTime += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                        }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime = ulTotalRunTime;
+            }
+        #endif /* configGENERATE_RUN_TIME_STATS */
+
+        #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
+            {
+                prvEDFEnforceJobBudget( pxCurrentTCB );
+            }
+        #endif
+
+        /* Check for stack overflow, if configured. */
+        taskCHECK_FOR_STACK_OVERFLOW();
+
+        /* Before the currently running task is switched out, save its errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            }
+        #endif
+
+        /* Select a new task to run using either the generic C or port
+         * optimised asm code. */
+				 
+				#if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+				{
+						taskSELECT_TIME_TRIGGERED_TASK();
+				}
+				#elif (configUSE_EDF_SCHEDULER == 0)
+				{
+						taskSELECT_HIGHEST_PRIORITY_TASK();
+				}
+				#else
+				{
+						taskSELECT_EARLIEST_DEADLINE_TASK();
+				}
+				#endif
+
+        #if ( configUSE_EDF_JOB_STATISTICS == 1 )
+            {
+                /* The first time a job is switched in is its start time. */
+                prvEDFRecordJobStart( pxCurrentTCB );
+            }
+        #endif
+
+        traceTASK_SWITCHED_IN();
+
+        /* After the new task is switched in, update the global errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            }
+        #endif
+
+        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+            {
+                /* Switch Newlib's _impure_ptr variable to point to the _reent
+                 * structure specific to this task.
+                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+                 * for additional information. */
+                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
+            }
+        #endif /* configUSE_NEWLIB_REENTRANT */
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event groups implementation. */
+    configASSERT( uxSchedulerSuspended != 0 );
+
+    /* Store the item value in the event list item.  It is safe to access the
+     * event list item here as interrupts won't access the event list item of a
+     * task that is not in the Blocked state. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  It is safe to access the event list here because it is part of an
+     * event group implementation - and interrupts don't access event groups
+     * directly (instead they access them indirectly by pending function calls to
+     * the task level). */
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xWaitIndefinitely )
+    {
+        configASSERT( pxEventList );
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements -
+         * it should be called with the scheduler suspended. */
+
+
+        /* Place the event list item of the TCB in the appropriate event list.
+         * In this case it is assume that this is the only task that is going to
+         * be waiting on this event list, so the faster vListInsertEnd() function
+         * can be used in place of vListInsert. */
+        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+        /* If the task should block indefinitely then set the block time to a
+         * value that will be recognised as an indefinite delay inside the
+         * prvAddCurrentTaskToDelayedList() function. */
+        if( xWaitIndefinitely != pdFALSE )
+        {
+            xTicksToWait = portMAX_DELAY;
+        }
+
+        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR. */
+
+    /* The event list is sorted in priority order, so the first in the list can
+     * be removed as it is known to be the highest priority.  Remove the TCB from
+     * the delayed list, and add it to the ready list.
+     *
+     * If an event is for a queue that is locked then this function will never
+     * get called - the lock count on the queue will get modified instead.  This
+     * means exclusive access to the event list is guaranteed here.
+     *
+     * This function assumes that a check has already been made to ensure that
+     * pxEventList is not empty. */
+    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+
+    #if ( configUSE_EDF_CBS == 1 )
+        {
+            /* An idle server is only ever unblocked by the arrival of a job.
+             * It is not in the ready queue yet, so the deadline can be
+             * changed in place. */
+            if( pxUnblockedTCB->ucCBSServerIdle != pdFALSE )
+            {
+                prvCBSJobArrival( pxUnblockedTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #endif
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+                 * might be set to the blocked task's time out time.  If the task is
+                 * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+                 * normally left unchanged, because it is automatically reset to a new
+                 * value when the tick count equals xNextTaskUnblockTime.  However if
+                 * tickless idling is used it might be more important to enter sleep mode
+                 * at the earliest possible time - so reset xNextTaskUnblockTime here to
+                 * ensure it is updated at the earliest possible time. */
+                prvResetNextTaskUnblockTime();
+            }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed. */
+        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+    }
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        if( prvEDFPreemptsCurrentTask( pxUnblockedTCB ) != pdFALSE )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
+    {
+        /* Return true if the task removed from the event list has a higher
+         * priority than the calling task.  This allows the calling task to know if
+         * it should force a context switch now. */
+        xReturn = pdTRUE;
+
+        /* Mark that a yield is pending in case the user is not using the
+         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
+                                        const TickType_t xItemValue )
+{
+    TCB_t * pxUnblockedTCB;
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event flags implementation. */
+    configASSERT( uxSchedulerSuspended != pdFALSE );
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Remove the event list form the event flag.  Interrupts do not access
+     * event flags. */
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+             * might be set to the blocked task's time out time.  If the task is
+             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+             * normally left unchanged, because it is automatically reset to a new
+             * value when the tick count equals xNextTaskUnblockTime.  However if
+             * tickless idling is used it might be more important to enter sleep mode
+             * at the earliest possible time - so reset xNextTaskUnblockTime here to
+             * ensure it is updated at the earliest possible time. */
+            prvResetNextTaskUnblockTime();
+        }
+    #endif
+
+    /* Remove the task from the delayed list and add it to the ready list.  The
+     * scheduler is suspended so interrupts will not be accessing the ready
+     * lists. */
+    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    prvAddTaskToReadyList( pxUnblockedTCB );
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        if( prvEDFPreemptsCurrentTask( pxUnblockedTCB ) != pdFALSE )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
+    {
+        /* The unblocked task has a priority above that of the calling task, so
+         * a context switch is required.  This function is called with the
+         * scheduler suspended so xYieldPending is set so the context switch
+         * occurs immediately that the scheduler is resumed (unsuspended). */
+        xYieldPending = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = xTickCount;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
+
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
+
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+            {
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = pdFALSE;
+                xReturn = pdTRUE;
+            }
+            else
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
+            }
+            else
+        #endif
+
+        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        {
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
+        }
+        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        {
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+    xYieldPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    {
+        UBaseType_t uxReturn;
+        TCB_t const * pxTCB;
+
+        if( xTask != NULL )
+        {
+            pxTCB = xTask;
+            uxReturn = pxTCB->uxTaskNumber;
+        }
+        else
+        {
+            uxReturn = 0U;
+        }
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vTaskSetTaskNumber( TaskHandle_t xTask,
+                             const UBaseType_t uxHandle )
+    {
+        TCB_t * pxTCB;
+
+        if( xTask != NULL )
+        {
+            pxTCB = xTask;
+            pxTCB->uxTaskNumber = uxHandle;
+        }
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+    /* Stop warnings. */
+    ( void ) pvParameters;
+
+
+    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+     * SCHEDULER IS STARTED. **/
+
+    /* In case a task that has a secure context deletes itself, in which case
+     * the idle task is responsible for deleting the task's secure context, if
+     * any. */
+    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+		
+
+    for( ; ; )
+    {
+        /* See if any tasks have deleted themselves - if so then the idle task
+         * is responsible for freeing the deleted task's TCB and stack. */
+        prvCheckTasksWaitingTermination();
+				
+        #if ( configUSE_PREEMPTION == 0 )
+            {
+                /* If we are not using preemption we keep forcing a task switch to
+                 * see if any other task has become available.  If we are using
+                 * preemption we don't need to do this as any task becoming available
+                 * will automatically get the processor anyway. */
+                taskYIELD();
+            }
+        #endif /* configUSE_PREEMPTION */
+
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+            {
+                /* When using preemption tasks of equal priority will be
+                 * timesliced.  If a task that is sharing the idle priority is ready
+                 * to run then the idle task should yield before the end of the
+                 * timeslice.
+                 *
+                 * A critical region is not required here as we are just reading from
+                 * the list, and an occasional incorrect value will not matter.  If
+                 * the ready list at the idle priority contains more than one task
+                 * then a task other than the idle task is ready to execute. */
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+        #if ( configUSE_IDLE_HOOK == 1 )
+            {
+                extern void vApplicationIdleHook( void );
+
+                /* Call the user defined function from within the idle task.  This
+                 * allows the application designer to add background functionality
+                 * without the overhead of a separate task.
+                 * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+                 * CALL A FUNCTION THAT MIGHT BLOCK. */
+                vApplicationIdleHook();
+            }
+        #endif /* configUSE_IDLE_HOOK */
+
+        /* This conditional compilation should use inequality to 0, not equality
+         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+         * user defined low power mode  implementations require
+         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                TickType_t xExpectedIdleTime;
+
+                /* It is not desirable to suspend then resume the scheduler on
+                 * each iteration of the idle task.  Therefore, a preliminary
+                 * test of the expected idle time is performed without the
+                 * scheduler suspended.  The result here is not necessarily
+                 * valid. */
+                xExpectedIdleTime = prvGetExpectedIdleTime();
+
+                if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                {
+                    vTaskSuspendAll();
+                    {
+                        /* Now the scheduler is suspended, the expected idle
+                         * time can be sampled again, and this time its value can
+                         * be used. */
+                        configASSERT( xNextTaskUnblockTime >= xTickCount );
+                        xExpectedIdleTime = prvGetExpectedIdleTime();
+
+                        /* Define the following macro to set xExpectedIdleTime to 0
+                         * if the application does not want
+                         * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+                        configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+                        if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                        {
+                            traceLOW_POWER_IDLE_BEGIN();
+                            portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                            traceLOW_POWER_IDLE_END();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    ( void ) xTaskResumeAll();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_TICKLESS_IDLE */
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    {
+        /* The idle task exists in addition to the application tasks. */
+        const UBaseType_t uxNonApplicationTasks = 1;
+        eSleepModeStatus eReturn = eStandardSleep;
+
+        /* This function must be called from a critical section. */
+
+        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        {
+            /* A task was made ready while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xYieldPending != pdFALSE )
+        {
+            /* A yield was pended while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xPendedTicks != 0 )
+        {
+            /* A tick interrupt has already occurred but was held pending
+             * because the scheduler is suspended. */
+            eReturn = eAbortSleep;
+        }
+        else
+        {
+            /* If all the tasks are in the suspended list (which might mean they
+             * have an infinite block time rather than actually being suspended)
+             * then it is safe to turn all clocks off and just wait for external
+             * interrupts. */
+            if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            {
+                eReturn = eNoTasksWaitingTimeout;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return eReturn;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
+                                            BaseType_t xIndex,
+                                            void * pvValue )
+    {
+        TCB_t * pxTCB;
+
+        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToSet );
+            configASSERT( pxTCB != NULL );
+            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+        }
+    }
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
+                                               BaseType_t xIndex )
+    {
+        void * pvReturn = NULL;
+        TCB_t * pxTCB;
+
+        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+        }
+        else
+        {
+            pvReturn = NULL;
+        }
+
+        return pvReturn;
+    }
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
+                                  const MemoryRegion_t * const xRegions )
+    {
+        TCB_t * pxTCB;
+
+        /* If null is passed in here then we are modifying the MPU settings of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+    }
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTaskLists( void )
+{
+    UBaseType_t uxPriority;
+
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    {
+        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+    }
+
+    vListInitialise( &xDelayedTaskList1 );
+    vListInitialise( &xDelayedTaskList2 );
+    vListInitialise( &xPendingReadyList );
+
+		#if ( configUSE_EDF_SCHEDULER == 1 )
+				vListInitialise( &xReadyTasksListEDF );
+		#endif
+		
+    #if ( INCLUDE_vTaskDelete == 1 )
+        {
+            vListInitialise( &xTasksWaitingTermination );
+        }
+    #endif /* INCLUDE_vTaskDelete */
+
+    #if ( INCLUDE_vTaskSuspend == 1 )
+        {
+            vListInitialise( &xSuspendedTaskList );
+        }
+    #endif /* INCLUDE_vTaskSuspend */
+
+    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+     * using list2. */
+    pxDelayedTaskList = &xDelayedTaskList1;
+    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTasksWaitingTermination( void )
+{
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+        {
+            TCB_t * pxTCB;
+
+            /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+             * being called too often in the idle task. */
+            while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+                taskEXIT_CRITICAL();
+
+                prvDeleteTCB( pxTCB );
+            }
+        }
+    #endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vTaskGetInfo( TaskHandle_t xTask,
+                       TaskStatus_t * pxTaskStatus,
+                       BaseType_t xGetFreeStackSpace,
+                       eTaskState eState )
+    {
+        TCB_t * pxTCB;
+
+        /* xTask is NULL then get the state of the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+        pxTaskStatus->pxStackBase = pxTCB->pxStack;
+        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+
+        #if ( configUSE_MUTEXES == 1 )
+            {
+                pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+            }
+        #else
+            {
+                pxTaskStatus->uxBasePriority = 0;
+            }
+        #endif
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+            }
+        #else
+            {
+                pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            }
+        #endif
+
+        #if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
+            {
+                pxTaskStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
+                pxTaskStatus->xMaxLateness = pxTCB->xMaxLateness;
+
+                #if ( configUSE_EDF_SPORADIC_TASKS == 1 )
                     {
-                        /* Fill in an TaskStatus_t structure with information on
-                         * each task that has been deleted but not yet cleaned up. */
-                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+                        pxTaskStatus->uxSeparationViolations = pxTCB->uxSeparationViolations;
+                    }
+                #else
+                    {
+                        pxTaskStatus->uxSeparationViolations = ( UBaseType_t ) 0U;
                     }
                 #endif
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
+                #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
                     {
-                        /* Fill in an TaskStatus_t structure with information on
-                         * each task in the Suspended state. */
-                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+                        pxTaskStatus->uxBudgetOverruns = pxTCB->uxBudgetOverruns;
+                    }
+                #else
+                    {
+                        pxTaskStatus->uxBudgetOverruns = ( UBaseType_t ) 0U;
                     }
                 #endif
 
-                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                #if ( configUSE_EDF_JOB_STATISTICS == 1 )
                     {
-                        if( pulTotalRunTime != NULL )
-                        {
-                            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                                portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-                            #else
-                                *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-                            #endif
-                        }
+                        pxTaskStatus->xJobStatistics = pxTCB->xJobStatistics;
                     }
-                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                #else
                     {
-                        if( pulTotalRunTime != NULL )
+                        ( void ) memset( ( void * ) &( pxTaskStatus->xJobStatistics ), 0x00, sizeof( TaskJobStatistics_t ) );
+                    }
+                #endif
+            }
+        #else
+            {
+                pxTaskStatus->uxDeadlineMisses = ( UBaseType_t ) 0U;
+                pxTaskStatus->xMaxLateness = ( TickType_t ) 0U;
+                pxTaskStatus->uxSeparationViolations = ( UBaseType_t ) 0U;
+                pxTaskStatus->uxBudgetOverruns = ( UBaseType_t ) 0U;
+                ( void ) memset( ( void * ) &( pxTaskStatus->xJobStatistics ), 0x00, sizeof( TaskJobStatistics_t ) );
+            }
+        #endif
+
+        #if ( configUSE_TIME_TRIGGERED_SCHEDULER == 1 )
+            {
+                pxTaskStatus->uxSlotOverruns = pxTCB->uxSlotOverruns;
+            }
+        #else
+            {
+                pxTaskStatus->uxSlotOverruns = ( UBaseType_t ) 0U;
+            }
+        #endif
+
+        /* Obtaining the task state is a little fiddly, so is only done if the
+         * value of eState passed into this function is eInvalid - otherwise the
+         * state is just set to whatever is passed in. */
+        if( eState != eInvalid )
+        {
+            if( pxTCB == pxCurrentTCB )
+            {
+                pxTaskStatus->eCurrentState = eRunning;
+            }
+            else
+            {
+                pxTaskStatus->eCurrentState = eState;
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                    {
+                        /* If the task is in the suspended list then there is a
+                         *  chance it is actually just blocked indefinitely - so really
+                         *  it should be reported as being in the Blocked state. */
+                        if( eState == eSuspended )
                         {
-                            *pulTotalRunTime = 0;
+                            vTaskSuspendAll();
+                            {
+                                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                                {
+                                    pxTaskStatus->eCurrentState = eBlocked;
+                                }
+                            }
+                            ( void ) xTaskResumeAll();
                         }
                     }
-                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                #endif /* INCLUDE_vTaskSuspend */
             }
-            else
+        }
+        else
+        {
+            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+        }
+
+        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+         * parameter is provided to allow it to be skipped. */
+        if( xGetFreeStackSpace != pdFALSE )
+        {
+            #if ( portSTACK_GROWTH > 0 )
+                {
+                    pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+                }
+            #else
+                {
+                    pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+                }
+            #endif
+        }
+        else
+        {
+            pxTaskStatus->usStackHighWaterMark = 0;
+        }
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB, * pxFirstTCB;
+        UBaseType_t uxTask = 0;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member. */
+            do
             {
-                mtCOVERAGE_TEST_MARKER();
-            }
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        ( void ) xTaskResumeAll();
 
         return uxTask;
     }
 
 #endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
     {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
+        uint32_t ulCount = 0U;
+
+        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        {
+            pucStackByte -= portSTACK_GROWTH;
+            ulCount++;
+        }
+
+        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+        return ( configSTACK_DEPTH_TYPE ) ulCount;
     }
 
-#endif /* INCLUDE_xTaskGetIdleTaskHandle */
-/*----------------------------------------------------------*/
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure vTaskStepTick() is available when user defined low power mode
- * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
- * 1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
 
-    void vTaskStepTick( const TickType_t xTicksToJump )
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
     {
-        /* Correct the tick count value after a period during which the tick
-         * was suppressed.  Note this does *not* call the tick hook function for
-         * each stepped tick. */
-        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
-        xTickCount += xTicksToJump;
-        traceINCREASE_TICK_COUNT( xTicksToJump );
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            }
+        #else
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            }
+        #endif
+
+        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
 
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-    BaseType_t xYieldOccurred;
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
 
-    /* Must not be called with the scheduler suspended as the implementation
-     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
 
-    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-    vTaskSuspendAll();
-    xPendedTicks += xTicksToCatchUp;
-    xYieldOccurred = xTaskResumeAll();
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-    return xYieldOccurred;
+        #if portSTACK_GROWTH < 0
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            }
+        #else
+            {
+                pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            }
+        #endif
+
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvDeleteTCB( TCB_t * pxTCB )
+    {
+        /* This call is required specifically for the TriCore port.  It must be
+         * above the vPortFree() calls.  The call is also used by ports/demos that
+         * want to allocate and clean RAM statically. */
+        portCLEAN_UP_TCB( pxTCB );
+
+        /* Free up the memory allocated by the scheduler for the task.  It is up
+         * to the task to free any memory allocated at the application level.
+         * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
+         * for additional information. */
+        #if ( configUSE_NEWLIB_REENTRANT == 1 )
+            {
+                _reclaim_reent( &( pxTCB->xNewLib_reent ) );
+            }
+        #endif /* configUSE_NEWLIB_REENTRANT */
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+            {
+                /* The task can only have been allocated dynamically - free both
+                 * the stack and TCB. */
+                vPortFreeStack( pxTCB->pxStack );
+                vPortFree( pxTCB );
+            }
+        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+            {
+                /* The task could have been allocated statically or dynamically, so
+                 * check what was statically allocated before trying to free the
+                 * memory. */
+                if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+                {
+                    /* Both the stack and TCB were allocated dynamically, so both
+                     * must be freed. */
+                    vPortFreeStack( pxTCB->pxStack );
+                    vPortFree( pxTCB );
+                }
+                else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+                {
+                    /* Only the stack was statically allocated, so the TCB is the
+                     * only memory that must be freed. */
+                    vPortFree( pxTCB );
+                }
+                else
+                {
+                    /* Neither the stack nor the TCB were allocated dynamically, so
+                     * nothing needs to be freed. */
+                    configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+    {
+        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+         * the maximum possible value so it is  extremely unlikely that the
+         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+         * there is an item in the delayed list. */
+        xNextTaskUnblockTime = portMAX_DELAY;
+    }
+    else
+    {
+        /* The new current delayed list is not empty, get the value of
+         * the item at the head of the delayed list.  This is the time at
+         * which the task at the head of the delayed list should be removed
+         * from the Blocked state. */
+        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+    }
 }
-/*----------------------------------------------------------*/
-
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+/*-----------------------------------------------------------*/
 
-    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+#if ( configEDF_USE_READY_HEAP == 1 )
+
+/* The heap is ordered by taskEDF_EARLIER_DEADLINE(), as the sorted ready list
+ * is.  Tasks with equal deadlines are ordered by when they were inserted, as
+ * prvEDFInsertByDeadline() places a task behind those with the same deadline,
+ * so both backends serve them first in, first out.  The sequence numbers of
+ * Ready tasks are close together, so comparing their difference still holds
+ * when the count wraps. */
+    #define prvEDFHeapBefore( pxTCB, pxOtherTCB )                                                                           \
+    ( taskEDF_EARLIER_DEADLINE( pxTCB, pxOtherTCB ) ||                                                                     \
+      ( ( !taskEDF_EARLIER_DEADLINE( pxOtherTCB, pxTCB ) ) &&                                                              \
+        ( ( UBaseType_t ) ( ( pxOtherTCB )->uxEDFHeapSequence - ( pxTCB )->uxEDFHeapSequence - ( UBaseType_t ) 1U ) < ( ( ( UBaseType_t ) ~( UBaseType_t ) 0U ) >> 1 ) ) ) )
+
+    static void prvEDFReadyHeapSiftUp( TCB_t * pxTCB,
+                                       UBaseType_t uxIndex )
     {
-        TCB_t * pxTCB = xTask;
-        BaseType_t xReturn;
+        UBaseType_t uxParent;
 
-        configASSERT( pxTCB );
-
-        vTaskSuspendAll();
+        while( uxIndex > ( UBaseType_t ) 0U )
         {
-            /* A task can only be prematurely removed from the Blocked state if
-             * it is actually in the Blocked state. */
-            if( eTaskGetState( xTask ) == eBlocked )
+            uxParent = ( uxIndex - ( UBaseType_t ) 1U ) >> 1;
+
+            if( !prvEDFHeapBefore( pxTCB, pxEDFReadyHeap[ uxParent ] ) )
             {
-                xReturn = pdPASS;
+                break;
+            }
 
-                /* Remove the reference to the task from the blocked list.  An
-                 * interrupt won't touch the xStateListItem because the
-                 * scheduler is suspended. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            pxEDFReadyHeap[ uxIndex ] = pxEDFReadyHeap[ uxParent ];
+            pxEDFReadyHeap[ uxIndex ]->uxEDFHeapIndex = uxIndex;
+            uxIndex = uxParent;
+        }
 
-                /* Is the task waiting on an event also?  If so remove it from
-                 * the event list too.  Interrupts can touch the event list item,
-                 * even though the scheduler is suspended, so a critical section
-                 * is used. */
-                taskENTER_CRITICAL();
-                {
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+        pxEDFReadyHeap[ uxIndex ] = pxTCB;
+        pxTCB->uxEDFHeapIndex = uxIndex;
+    }
+    /*-----------------------------------------------------------*/
 
-                        /* This lets the task know it was forcibly removed from the
-                         * blocked state so it should not re-evaluate its block time and
-                         * then block again. */
-                        pxTCB->ucDelayAborted = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                taskEXIT_CRITICAL();
+    static void prvEDFReadyHeapSiftDown( TCB_t * pxTCB,
+                                         UBaseType_t uxIndex )
+    {
+        UBaseType_t uxChild;
 
-                /* Place the unblocked task into the appropriate ready list. */
-                prvAddTaskToReadyList( pxTCB );
+        for( ; ; )
+        {
+            uxChild = ( uxIndex << 1 ) + ( UBaseType_t ) 1U;
 
-                /* A task being unblocked cannot cause an immediate context
-                 * switch if preemption is turned off. */
-                #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should only be
-                         * performed if the unblocked task has a priority that is
-                         * higher than the currently executing task. */
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                        {
-                            /* Pend the yield to be performed when the scheduler
-                             * is unsuspended. */
-                            xYieldPending = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                #endif /* configUSE_PREEMPTION */
+            if( uxChild >= uxEDFReadyHeapLength )
+            {
+                break;
             }
-            else
+
+            /* Pick the child that runs first. */
+            if( ( ( uxChild + ( UBaseType_t ) 1U ) < uxEDFReadyHeapLength ) &&
+                prvEDFHeapBefore( pxEDFReadyHeap[ uxChild + ( UBaseType_t ) 1U ], pxEDFReadyHeap[ uxChild ] ) )
             {
-                xReturn = pdFAIL;
+                uxChild++;
+            }
+
+            if( !prvEDFHeapBefore( pxEDFReadyHeap[ uxChild ], pxTCB ) )
+            {
+                break;
             }
+
+            pxEDFReadyHeap[ uxIndex ] = pxEDFReadyHeap[ uxChild ];
+            pxEDFReadyHeap[ uxIndex ]->uxEDFHeapIndex = uxIndex;
+            uxIndex = uxChild;
         }
-        ( void ) xTaskResumeAll();
 
-        return xReturn;
+        pxEDFReadyHeap[ uxIndex ] = pxTCB;
+        pxTCB->uxEDFHeapIndex = uxIndex;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
+    static void prvEDFReadyHeapInsert( TCB_t * pxTCB )
+    {
+        /* Task creation keeps a place for every task that can be Ready. */
+        configASSERT( uxEDFReadyHeapLength < ( UBaseType_t ) configEDF_READY_HEAP_LENGTH );
 
-BaseType_t xTaskIncrementTick( void )
-{
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
-    BaseType_t xSwitchRequired = pdFALSE;
+        /* The ready list is only used to record the task is Ready, so the
+         * task goes on the end of it rather than being sorted into it. */
+        listINSERT_END( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) );
 
-    /* Called by the portable layer each time a tick interrupt occurs.
-     * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
-    traceTASK_INCREMENT_TICK( xTickCount );
+        pxTCB->uxEDFHeapSequence = uxEDFReadyHeapSequence;
+        uxEDFReadyHeapSequence++;
+        uxEDFReadyHeapLength++;
+        prvEDFReadyHeapSiftUp( pxTCB, uxEDFReadyHeapLength - ( UBaseType_t ) 1U );
+    }
+    /*-----------------------------------------------------------*/
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    static UBaseType_t prvEDFReadyHeapRemove( TCB_t * pxTCB )
     {
-        /* Minor optimisation.  The tick count cannot change in this
-         * block. */
-        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
-
-        /* Increment the RTOS tick, switching the delayed and overflowed
-         * delayed lists if it wraps to 0. */
-        xTickCount = xConstTickCount;
-
-        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
-        {
-            taskSWITCH_DELAYED_LISTS();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        TCB_t * pxLastTCB;
+        UBaseType_t uxIndex;
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+        if( listIS_CONTAINED_WITHIN( &( xReadyTasksListEDF ), &( pxTCB->xStateListItem ) ) != pdFALSE )
         {
-            for( ; ; )
-            {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-                {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
-                }
-                else
-                {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-                    if( xConstTickCount < xItemValue )
-                    {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-										listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB)->xTaskPeriod + xTaskGetTickCount()	);
-										
-										
-                    prvAddTaskToReadyList( pxTCB );
+            uxIndex = pxTCB->uxEDFHeapIndex;
+            configASSERT( pxEDFReadyHeap[ uxIndex ] == pxTCB );
 
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                        {
-                            /* Preemption is on, but a context switch should
-                             * only be performed if the unblocked task has a
-                             * priority that is equal to or higher than the
-                             * currently executing task. */
-                            if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                            {
-                                xSwitchRequired = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                    #endif /* configUSE_PREEMPTION */
-                }
-            }
-        }
+            /* Fill the hole left by the task with the last entry in the heap,
+             * then move that entry up or down to restore the heap order. */
+            uxEDFReadyHeapLength--;
+            pxLastTCB = pxEDFReadyHeap[ uxEDFReadyHeapLength ];
+            pxEDFReadyHeap[ uxEDFReadyHeapLength ] = NULL;
 
-        /* Tasks of equal priority to the currently running task will share
-         * processing time (time slice) if preemption is on, and the application
-         * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+            if( pxLastTCB != pxTCB )
             {
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+                if( ( uxIndex > ( UBaseType_t ) 0U ) &&
+                    prvEDFHeapBefore( pxLastTCB, pxEDFReadyHeap[ ( uxIndex - ( UBaseType_t ) 1U ) >> 1 ] ) )
                 {
-                    xSwitchRequired = pdTRUE;
+                    prvEDFReadyHeapSiftUp( pxLastTCB, uxIndex );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    prvEDFReadyHeapSiftDown( pxLastTCB, uxIndex );
                 }
             }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
-
-        #if ( configUSE_TICK_HOOK == 1 )
+            else
             {
-                /* Guard against the tick hook being called when the pended tick
-                 * count is being unwound (when the scheduler is being unlocked). */
-                if( xPendedTicks == ( TickType_t ) 0 )
-                {
-                    vApplicationTickHook();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                mtCOVERAGE_TEST_MARKER();
             }
-        #endif /* configUSE_TICK_HOOK */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        #if ( configUSE_PREEMPTION == 1 )
+        return uxListRemove( &( pxTCB->xStateListItem ) );
+    }
+    /*-----------------------------------------------------------*/
+
+    static BaseType_t prvEDFReserveReadyHeapPlace( TaskFunction_t pxTaskCode )
+    {
+        BaseType_t xReturn = pdTRUE;
+
+        /* The idle task is kept in its own ready list, and is never moved
+         * into the heap. */
+        if( pxTaskCode != prvIdleTask )
+        {
+            taskENTER_CRITICAL();
             {
-                if( xYieldPending != pdFALSE )
+                if( uxEDFReadyHeapPlaces < ( UBaseType_t ) configEDF_READY_HEAP_LENGTH )
                 {
-                    xSwitchRequired = pdTRUE;
+                    uxEDFReadyHeapPlaces++;
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    xReturn = pdFALSE;
                 }
-            }
-        #endif /* configUSE_PREEMPTION */
-    }
-    else
-    {
-        ++xPendedTicks;
-
-        /* The tick hook gets called at regular intervals, even if the
-         * scheduler is locked. */
-        #if ( configUSE_TICK_HOOK == 1 )
-            {
-                vApplicationTickHook();
-            }
-        #endif
-    }
-
-    return xSwitchRequired;
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
-                                     TaskHookFunction_t pxHookFunction )
-    {
-        TCB_t * xTCB;
-
-        /* If xTask is NULL then it is the task hook of the calling task that is
-         * getting set. */
-        if( xTask == NULL )
-        {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
+            }
+            taskEXIT_CRITICAL();
         }
         else
         {
-            xTCB = xTask;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
-        {
-            xTCB->pxTaskTag = pxHookFunction;
-        }
-        taskEXIT_CRITICAL();
+        return xReturn;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configEDF_USE_READY_HEAP */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configEDF_USE_READY_HEAP == 0 ) )
 
-    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    static void prvEDFInsertByDeadline( List_t * const pxList,
+                                        TCB_t * const pxTCB )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
+        ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+        ListItem_t * pxIterator;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        listTEST_LIST_INTEGRITY( pxList );
+        listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
+        /* As vListInsert(), but the position is found by comparing deadlines
+         * rather than item values, which cannot order them across a wrap of
+         * the tick count. */
+        for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd );
+             pxIterator->pxNext != ( ListItem_t * ) &( pxList->xListEnd );
+             pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
         {
-            xReturn = pxTCB->pxTaskTag;
+            if( taskEDF_EARLIER_DEADLINE( pxTCB, ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxIterator->pxNext ) ) )
+            {
+                break;
+            }
         }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
+        pxNewListItem->pxNext = pxIterator->pxNext;
+        pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+        pxNewListItem->pxPrevious = pxIterator;
+        pxIterator->pxNext = pxNewListItem;
+        pxNewListItem->pxContainer = pxList;
+
+        ( pxList->uxNumberOfItems )++;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( configEDF_USE_READY_HEAP == 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( tskPERIODIC_TASKS_SUPPORTED == 1 )
 
-    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    static void prvCheckForDeadlineMiss( TCB_t * const pxTCB,
+                                         const TickType_t xTimeNow,
+                                         const BaseType_t xJobCompleted )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
-        UBaseType_t uxSavedInterruptStatus;
+        const TickType_t xDeadline = pxTCB->xTaskAbsoluteDeadline;
+        const TickType_t xLateness = xTimeNow - xDeadline;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        /* The job is late once the tick count has passed its deadline, which
+         * is tested on the difference so it still holds when the tick count
+         * wraps.  A job that completes during the tick on which its deadline
+         * falls has met the deadline, and a task without a job has no
+         * deadline to miss. */
+        if( ( pxTCB->ucHasDeadline != pdFALSE ) && ( xLateness != ( TickType_t ) 0U ) && ( xLateness <= ( portMAX_DELAY >> 1 ) ) )
+        {
+            if( xLateness > pxTCB->xMaxLateness )
+            {
+                pxTCB->xMaxLateness = xLateness;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            /* The miss may already have been reported from the tick
+             * interrupt, only count it once per job. */
+            if( pxTCB->ucDeadlineMissed == pdFALSE )
+            {
+                pxTCB->ucDeadlineMissed = pdTRUE;
+                ( pxTCB->uxDeadlineMisses )++;
+
+                traceTASK_DEADLINE_MISSED( pxTCB, xLateness );
+
+                #if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+                    {
+                        vApplicationDeadlineMissHook( ( TaskHandle_t ) pxTCB, xLateness );
+                    }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
         {
-            xReturn = pxTCB->pxTaskTag;
+            mtCOVERAGE_TEST_MARKER();
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-        return xReturn;
+        if( xJobCompleted != pdFALSE )
+        {
+            pxTCB->ucDeadlineMissed = pdFALSE;
+
+            #if ( configUSE_EDF_JOB_STATISTICS == 1 )
+                {
+                    prvEDFRecordJobCompletion( pxTCB, xTimeNow );
+                }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* tskPERIODIC_TASKS_SUPPORTED */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
-                                             void * pvParameter )
+    static BaseType_t prvEDFPreemptsCurrentTask( const TCB_t * const pxTCB )
     {
-        TCB_t * xTCB;
         BaseType_t xReturn;
 
-        /* If xTask is NULL then we are calling our own task hook. */
-        if( xTask == NULL )
+        if( taskEDF_RUNS_BEFORE( pxTCB, pxCurrentTCB ) )
         {
-            xTCB = pxCurrentTCB;
+            xReturn = pdTRUE;
         }
         else
         {
-            xTCB = xTask;
-        }
+            /* A task readied at the idle priority never preempted a task
+             * with a deadline, so only other tasks count as avoided
+             * switches. */
+            if( !taskEDF_IN_BACKGROUND( pxTCB ) )
+            {
+                ulEDFAvoidedSwitches++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        if( xTCB->pxTaskTag != NULL )
-        {
-            xReturn = xTCB->pxTaskTag( pvParameter );
-        }
-        else
-        {
-            xReturn = pdFAIL;
+            xReturn = pdFALSE;
         }
 
         return xReturn;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+    uint32_t ulTaskGetAvoidedContextSwitches( void )
+    {
+        return ulEDFAvoidedSwitches;
+    }
+    /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+    static void prvEDFRepositionReadyTask( TCB_t * pxTCB )
     {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
+        if( taskEDF_IS_IN_READY_QUEUE( pxTCB ) ||
+            ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            /* The ready queue is ordered by deadline, so the task has to
+             * be reinserted.  This also moves a task between the ready queue
+             * and the background if its budget was exhausted or renewed. */
+            ( void ) prvRemoveTaskFromStateList( pxTCB );
+
+            #if ( configUSE_EDF_PRIORITY_BANDS == 1 )
+                {
+                    /* The band may be left empty if the task is demoted. */
+                    taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                }
+            #endif
+
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            /* The deadline is picked up when the task next becomes Ready. */
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-    else
+    /*-----------------------------------------------------------*/
+
+    static BaseType_t prvEDFSetJobTiming( TCB_t * const pxTCB,
+                                          const TickType_t xPeriod,
+                                          const TickType_t xRelativeDeadline )
     {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+        BaseType_t xReturn = pdPASS;
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-            {
-                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-                #else
-                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-                #endif
+        /* Only a periodic task has a period to change. */
+        configASSERT( pxTCB->xTaskPeriod > ( TickType_t ) 0U );
+        configASSERT( xPeriod > ( TickType_t ) 0U );
+        configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
 
-                /* Add the amount of time the task has been running to the
-                 * accumulated time so far.  The time the task started running was
-                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-                 * protection here so count values are only valid until the timer
-                 * overflows.  The guard against negative values is to protect
-                 * against suspect run time stat counter implementations - which
-                 * are provided by the application, not the kernel. */
-                if( ulTotalRunTime > ulTaskSwitchedInTime )
+        #if ( configUSE_EDF_MODE_CHANGES == 1 )
+            {
+                if( ( pxTCB->ucModeChangePending != pdFALSE ) || ( pxTCB->ucModeDisabled != pdFALSE ) )
                 {
-                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                    /* The task takes its timing from the requested mode. */
+                    xReturn = pdFAIL;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                ulTaskSwitchedInTime = ulTotalRunTime;
             }
-        #endif /* configGENERATE_RUN_TIME_STATS */
-
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+        #endif
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
             {
-                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
-            }
-        #endif
+                PeriodicTaskParameters_t xDefinition;
 
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-				 
-				#if (configUSE_EDF_SCHEDULER == 0)
-				{
-						taskSELECT_HIGHEST_PRIORITY_TASK();
-				}
-				#else
-				{
-						pxCurrentTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyTasksListEDF ) );
-				}
-				#endif
-				 
-        traceTASK_SWITCHED_IN();
+                if( xReturn == pdPASS )
+                {
+                    /* Test the new timing against the other admitted tasks,
+                     * then account for the task with its current timing
+                     * again until the change is made.  An earlier change of
+                     * this task is replaced or kept, so it does not hold up
+                     * the test. */
+                    ulAdmittedUtilisation -= pxTCB->ulPendingClaim;
+                    pxTCB->ulPendingClaim = 0UL;
+                    prvEDFReleaseTask( pxTCB );
+
+                    if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
+                    {
+                        uxTimingChangesPending--;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-            {
-                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
-            }
-        #endif
+                    xDefinition.xPeriod = xPeriod;
+                    xDefinition.xRelativeDeadline = xRelativeDeadline;
+                    xDefinition.xWcet = pxTCB->xTaskWcet;
 
-        #if ( configUSE_NEWLIB_REENTRANT == 1 )
-            {
-                /* Switch Newlib's _impure_ptr variable to point to the _reent
-                 * structure specific to this task.
-                 * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-                 * for additional information. */
-                _impure_ptr = &( pxCurrentTCB->xNewLib_reent );
-            }
-        #endif /* configUSE_NEWLIB_REENTRANT */
-    }
-}
-/*-----------------------------------------------------------*/
+                    if( prvEDFAdmissionTest( &xDefinition ) == pdFALSE )
+                    {
+                        xReturn = errTASK_NOT_SCHEDULABLE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+                    prvEDFAdmitTask( pxTCB );
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+                    if( xReturn == pdPASS )
+                    {
+                        prvEDFClaimUtilisation( pxTCB, pxTCB->xTaskWcet, xPeriod );
+                    }
+                    else if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
+                    {
+                        /* An earlier change is still to be made. */
+                        prvEDFClaimUtilisation( pxTCB, pxTCB->xTaskWcet, pxTCB->xPendingPeriod );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+                    if( ( xReturn == pdPASS ) || ( pxTCB->xPendingPeriod > ( TickType_t ) 0U ) )
+                    {
+                        uxTimingChangesPending++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_EDF_ADMISSION_CONTROL */
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+        if( xReturn == pdPASS )
+        {
+            pxTCB->xPendingPeriod = xPeriod;
+            pxTCB->xPendingRelativeDeadline = xRelativeDeadline;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvEDFApplyPendingTiming( TCB_t * const pxTCB )
+    {
+        if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
+        {
+            #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+                {
+                    ulAdmittedUtilisation -= pxTCB->ulPendingClaim;
+                    pxTCB->ulPendingClaim = 0UL;
+                    prvEDFReleaseTask( pxTCB );
+                    uxTimingChangesPending--;
+                }
+            #endif
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event groups implementation. */
-    configASSERT( uxSchedulerSuspended != 0 );
+            /* The release after the job that has just completed was set a
+             * period after the release of that job, so it follows the new
+             * period too.  The first job keeps its release offset. */
+            if( pxTCB->uxJobsReleased > ( UBaseType_t ) 0U )
+            {
+                pxTCB->xTaskNextRelease = ( pxTCB->xTaskNextRelease - pxTCB->xTaskPeriod ) + pxTCB->xPendingPeriod;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    /* Store the item value in the event list item.  It is safe to access the
-     * event list item here as interrupts won't access the event list item of a
-     * task that is not in the Blocked state. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+            pxTCB->xTaskPeriod = pxTCB->xPendingPeriod;
+            pxTCB->xTaskRelativeDeadline = pxTCB->xPendingRelativeDeadline;
+            pxTCB->xPendingPeriod = ( TickType_t ) 0U;
+            pxTCB->xPendingRelativeDeadline = ( TickType_t ) 0U;
 
-    /* Place the event list item of the TCB at the end of the appropriate event
-     * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
-    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+            #if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+                {
+                    prvEDFAdmitTask( pxTCB );
+                }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
+#endif /* configUSE_EDF_SCHEDULER */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MUTEXES == 1 ) )
 
-    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
-                                          TickType_t xTicksToWait,
-                                          const BaseType_t xWaitIndefinitely )
+    static BaseType_t prvEDFInheritDeadline( TCB_t * pxTCB,
+                                             const TCB_t * const pxWaitingTCB )
     {
-        configASSERT( pxEventList );
-
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements -
-         * it should be called with the scheduler suspended. */
+        /* A waiter without a deadline has nothing to lend. */
+        if( taskEDF_HAS_SCHEDULING_DEADLINE( pxWaitingTCB ) &&
+            ( ( pxTCB->ucInheritsDeadline == pdFALSE ) ||
+              taskEDF_DEADLINE_IS_BEFORE( taskEDF_SCHEDULING_DEADLINE( pxWaitingTCB ), pxTCB->xInheritedDeadline ) ) )
+        {
+            pxTCB->xInheritedDeadline = taskEDF_SCHEDULING_DEADLINE( pxWaitingTCB );
+            pxTCB->ucInheritsDeadline = pdTRUE;
+            prvEDFRepositionReadyTask( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
+        return taskEDF_DEADLINE_IS_INHERITED( pxTCB ) ? pdTRUE : pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
 
-        /* Place the event list item of the TCB in the appropriate event list.
-         * In this case it is assume that this is the only task that is going to
-         * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    static BaseType_t prvEDFDisinheritDeadline( TCB_t * pxTCB )
+    {
+        BaseType_t xReturn = pdFALSE;
 
-        /* If the task should block indefinitely then set the block time to a
-         * value that will be recognised as an indefinite delay inside the
-         * prvAddCurrentTaskToDelayedList() function. */
-        if( xWaitIndefinitely != pdFALSE )
+        if( taskEDF_DEADLINE_IS_INHERITED( pxTCB ) )
         {
-            xTicksToWait = portMAX_DELAY;
+            /* The task now has a later deadline, or none, so a context switch
+             * might be required. */
+            pxTCB->ucInheritsDeadline = pdFALSE;
+            prvEDFRepositionReadyTask( pxTCB );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            pxTCB->ucInheritsDeadline = pdFALSE;
         }
 
-        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+        return xReturn;
     }
 
-#endif /* configUSE_TIMERS */
+#endif /* ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_MUTEXES == 1 ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
-{
-    TCB_t * pxUnblockedTCB;
-    BaseType_t xReturn;
+#if ( configUSE_EDF_ADMISSION_CONTROL == 1 )
+
+/* The utilisation of a task rounded up, so the sum over the task set never
+ * understates the load. */
+    #define prvEDFUtilisation( xWcet, xPeriod ) \
+    ( ( uint32_t ) ( ( ( ( uint64_t ) ( xWcet ) * ( uint64_t ) tskUTILISATION_SCALE ) + ( uint64_t ) ( xPeriod ) - ( uint64_t ) 1U ) / ( uint64_t ) ( xPeriod ) ) )
+
+/* The density of a task, its utilisation over the smaller of its deadline and
+ * its period. */
+    #define prvEDFDensity( xWcet, xPeriod, xDeadline ) \
+    prvEDFUtilisation( ( xWcet ), ( ( ( xDeadline ) < ( xPeriod ) ) ? ( xDeadline ) : ( xPeriod ) ) )
+
+/* The execution time requested by the jobs of a task that are both released
+ * and due within an interval of xInterval ticks starting at a synchronous
+ * release. */
+    #define prvEDFDemand( xInterval, xWcet, xPeriod, xDeadline ) \
+    ( ( ( xInterval ) < ( xDeadline ) ) ? ( TickType_t ) 0U : ( TickType_t ) ( ( ( ( ( xInterval ) - ( xDeadline ) ) / ( xPeriod ) ) + ( TickType_t ) 1U ) * ( xWcet ) ) )
+
+/* The execution time requested by the jobs of a task released within an
+ * interval of xInterval ticks starting at a synchronous release. */
+    #define prvEDFWorkload( xInterval, xWcet, xPeriod ) \
+    ( ( TickType_t ) ( ( ( ( xInterval ) + ( xPeriod ) - ( TickType_t ) 1U ) / ( xPeriod ) ) * ( xWcet ) ) )
+
+/* The latest absolute deadline of a task that falls before xInterval after a
+ * synchronous release, or 0 if there is none. */
+    #define prvEDFLastDeadline( xInterval, xPeriod, xDeadline ) \
+    ( ( ( xInterval ) <= ( xDeadline ) ) ? ( TickType_t ) 0U : ( TickType_t ) ( ( xDeadline ) + ( ( ( ( xInterval ) - ( xDeadline ) - ( TickType_t ) 1U ) / ( xPeriod ) ) * ( xPeriod ) ) ) )
+
+    static TickType_t prvEDFDemandBound( const TickType_t xInterval,
+                                         const TickType_t xWcet,
+                                         const TickType_t xPeriod,
+                                         const TickType_t xDeadline )
+    {
+        TCB_t * pxTCB;
+        TickType_t xDemand;
 
-    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-     * called from a critical section within an ISR. */
+        /* The demand of the candidate task plus that of every admitted task. */
+        xDemand = prvEDFDemand( xInterval, xWcet, xPeriod, xDeadline );
 
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
-     *
-     * If an event is for a queue that is locked then this function will never
-     * get called - the lock count on the queue will get modified instead.  This
-     * means exclusive access to the event list is guaranteed here.
-     *
-     * This function assumes that a check has already been made to ensure that
-     * pxEventList is not empty. */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+        for( pxTCB = pxAdmittedTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextAdmittedTCB )
+        {
+            xDemand += prvEDFDemand( xInterval, pxTCB->xTaskWcet, pxTCB->xTaskPeriod, pxTCB->xTaskRelativeDeadline );
+        }
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        return xDemand;
+    }
+    /*-----------------------------------------------------------*/
+
+    static TickType_t prvEDFDeadlineBefore( const TickType_t xInterval,
+                                            const TickType_t xPeriod,
+                                            const TickType_t xDeadline )
     {
-        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-        prvAddTaskToReadyList( pxUnblockedTCB );
+        TCB_t * pxTCB;
+        TickType_t xLatest, xTaskLatest;
 
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        /* The latest deadline of the candidate task or of any admitted
+         * task. */
+        xLatest = prvEDFLastDeadline( xInterval, xPeriod, xDeadline );
+
+        for( pxTCB = pxAdmittedTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextAdmittedTCB )
+        {
+            xTaskLatest = prvEDFLastDeadline( xInterval, pxTCB->xTaskPeriod, pxTCB->xTaskRelativeDeadline );
+
+            if( xTaskLatest > xLatest )
             {
-                /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-                 * might be set to the blocked task's time out time.  If the task is
-                 * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-                 * normally left unchanged, because it is automatically reset to a new
-                 * value when the tick count equals xNextTaskUnblockTime.  However if
-                 * tickless idling is used it might be more important to enter sleep mode
-                 * at the earliest possible time - so reset xNextTaskUnblockTime here to
-                 * ensure it is updated at the earliest possible time. */
-                prvResetNextTaskUnblockTime();
+                xLatest = xTaskLatest;
             }
-        #endif
-    }
-    else
-    {
-        /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
-        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xLatest;
     }
+    /*-----------------------------------------------------------*/
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    static BaseType_t prvEDFProcessorDemandTest( const TickType_t xWcet,
+                                                 const TickType_t xPeriod,
+                                                 const TickType_t xDeadline )
     {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        TCB_t * pxTCB;
+        TickType_t xInterval = ( TickType_t ) configEDF_MAX_DEMAND_INTERVAL;
+        TickType_t xBusyPeriod, xNextBusyPeriod, xMinimumDeadline, xMaximumDeadline, xDemand;
+        uint32_t ulUtilisation;
+        uint64_t ullLa;
+        BaseType_t xBounded = pdFALSE, xReturn = pdFALSE;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
-    }
+        /* The demand can only exceed the time available at a deadline within
+         * the synchronous busy period and, when the utilisation is below one,
+         * at a deadline no later than La = sum( ( Ti - Di ) Ui ) / ( 1 - U ) or
+         * the latest relative deadline, whichever is later.  Rounding each
+         * utilisation up only makes La longer. */
+        ulUtilisation = prvEDFUtilisation( xWcet, xPeriod );
+        ullLa = ( xDeadline < xPeriod ) ? ( uint64_t ) ( xPeriod - xDeadline ) * ( uint64_t ) ulUtilisation : 0ULL;
+        xMinimumDeadline = xDeadline;
+        xMaximumDeadline = xDeadline;
+        xNextBusyPeriod = xWcet;
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+        for( pxTCB = pxAdmittedTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextAdmittedTCB )
+        {
+            ulUtilisation += pxTCB->ulTaskUtilisation;
+            xNextBusyPeriod += pxTCB->xTaskWcet;
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
-                                        const TickType_t xItemValue )
-{
-    TCB_t * pxUnblockedTCB;
+            if( pxTCB->xTaskRelativeDeadline < pxTCB->xTaskPeriod )
+            {
+                ullLa += ( uint64_t ) ( pxTCB->xTaskPeriod - pxTCB->xTaskRelativeDeadline ) * ( uint64_t ) pxTCB->ulTaskUtilisation;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event flags implementation. */
-    configASSERT( uxSchedulerSuspended != pdFALSE );
+            if( pxTCB->xTaskRelativeDeadline < xMinimumDeadline )
+            {
+                xMinimumDeadline = pxTCB->xTaskRelativeDeadline;
+            }
+            else if( pxTCB->xTaskRelativeDeadline > xMaximumDeadline )
+            {
+                xMaximumDeadline = pxTCB->xTaskRelativeDeadline;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-    /* Store the new item value in the event list. */
-    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+        if( ulUtilisation < tskUTILISATION_SCALE )
+        {
+            ullLa = ( ullLa + ( uint64_t ) ( tskUTILISATION_SCALE - ulUtilisation ) - 1ULL ) / ( uint64_t ) ( tskUTILISATION_SCALE - ulUtilisation );
 
-    /* Remove the event list form the event flag.  Interrupts do not access
-     * event flags. */
-    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( pxEventListItem );
+            if( ullLa < ( uint64_t ) xMaximumDeadline )
+            {
+                ullLa = ( uint64_t ) xMaximumDeadline;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    #if ( configUSE_TICKLESS_IDLE != 0 )
+            if( ullLa <= ( uint64_t ) xInterval )
+            {
+                xInterval = ( TickType_t ) ullLa;
+                xBounded = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
         {
-            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-             * might be set to the blocked task's time out time.  If the task is
-             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-             * normally left unchanged, because it is automatically reset to a new
-             * value when the tick count equals xNextTaskUnblockTime.  However if
-             * tickless idling is used it might be more important to enter sleep mode
-             * at the earliest possible time - so reset xNextTaskUnblockTime here to
-             * ensure it is updated at the earliest possible time. */
-            prvResetNextTaskUnblockTime();
+            mtCOVERAGE_TEST_MARKER();
         }
-    #endif
-
-    /* Remove the task from the delayed list and add it to the ready list.  The
-     * scheduler is suspended so interrupts will not be accessing the ready
-     * lists. */
-    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-    prvAddTaskToReadyList( pxUnblockedTCB );
-
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-    {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
-    }
-}
-/*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
-    {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
-    }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
+        /* Find the length of the busy period, unless it runs past the
+         * interval already found.  At a utilisation of exactly one it is the
+         * hyperperiod, so the test gives up, and refuses the task, rather
+         * than check that many deadlines with the scheduler suspended. */
+        do
+        {
+            xBusyPeriod = xNextBusyPeriod;
+            xNextBusyPeriod = prvEDFWorkload( xBusyPeriod, xWcet, xPeriod );
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
-}
-/*-----------------------------------------------------------*/
+            for( pxTCB = pxAdmittedTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextAdmittedTCB )
+            {
+                xNextBusyPeriod += prvEDFWorkload( xBusyPeriod, pxTCB->xTaskWcet, pxTCB->xTaskPeriod );
+            }
+        } while( ( xNextBusyPeriod != xBusyPeriod ) && ( xNextBusyPeriod <= xInterval ) );
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
+        if( ( xNextBusyPeriod == xBusyPeriod ) && ( xBusyPeriod <= xInterval ) )
+        {
+            xInterval = xBusyPeriod;
+            xBounded = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
+        if( xBounded != pdFALSE )
+        {
+            /* Quick processor demand analysis: from the last deadline within
+             * the interval, step straight back to the demand while it is
+             * below the time available, as no deadline in between can fail,
+             * until the demand drops below the earliest deadline. */
+            xInterval = prvEDFDeadlineBefore( xInterval + ( TickType_t ) 1U, xPeriod, xDeadline );
+            xDemand = prvEDFDemandBound( xInterval, xWcet, xPeriod, xDeadline );
 
-    taskENTER_CRITICAL();
-    {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+            while( ( xDemand <= xInterval ) && ( xDemand > xMinimumDeadline ) )
+            {
+                if( xDemand < xInterval )
+                {
+                    xInterval = xDemand;
+                }
+                else
+                {
+                    xInterval = prvEDFDeadlineBefore( xInterval, xPeriod, xDeadline );
+                }
 
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+                xDemand = prvEDFDemandBound( xInterval, xWcet, xPeriod, xDeadline );
+            }
+
+            if( xDemand <= xInterval )
             {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = pdFALSE;
                 xReturn = pdTRUE;
             }
             else
-        #endif
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    static BaseType_t prvEDFAdmissionTest( const PeriodicTaskParameters_t * const pxTaskDefinition )
+    {
+        TickType_t xDeadline = pxTaskDefinition->xRelativeDeadline;
+        BaseType_t xReturn;
+
+        if( xDeadline == ( TickType_t ) 0U )
+        {
+            xDeadline = pxTaskDefinition->xPeriod;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxTaskDefinition->xWcet == ( TickType_t ) 0U )
+        {
+            /* The task has not declared an execution time so does not claim
+             * any of the processor, as is the case for the idle task. */
+            xReturn = pdTRUE;
+        }
+
+        #if ( configUSE_EDF_MODE_CHANGES == 1 )
+            else if( uxModeChangesPending > ( UBaseType_t ) 0U )
             {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
+                /* The tasks that are changing mode are only accounted for
+                 * by utilisation, which is not enough to test a constrained
+                 * deadline against. */
                 xReturn = pdFALSE;
             }
-            else
         #endif
-
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        else if( uxTimingChangesPending > ( UBaseType_t ) 0U )
         {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
+            /* Likewise a task with a pending change of period or deadline
+             * is only accounted for by utilisation until the change is
+             * made, and the processor demand test would check it against
+             * the deadline it is leaving. */
+            xReturn = pdFALSE;
         }
-        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        else if( prvEDFUtilisation( pxTaskDefinition->xWcet, pxTaskDefinition->xPeriod ) > ( tskUTILISATION_SCALE - ulAdmittedUtilisation ) )
         {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
+            /* A utilisation above one can never be scheduled, whatever the
+             * deadlines. */
             xReturn = pdFALSE;
         }
+        else if( ( xDeadline != pxTaskDefinition->xPeriod ) || ( uxAdmittedConstrainedTasks > ( UBaseType_t ) 0U ) )
+        {
+            /* With implicit deadlines a utilisation of at most one is both
+             * necessary and sufficient, otherwise the deadlines have to be
+             * checked too. */
+            xReturn = prvEDFProcessorDemandTest( pxTaskDefinition->xWcet, pxTaskDefinition->xPeriod, xDeadline );
+        }
         else
         {
-            *pxTicksToWait = ( TickType_t ) 0;
             xReturn = pdTRUE;
         }
-    }
-    taskEXIT_CRITICAL();
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
 
-void vTaskMissedYield( void )
-{
-    xYieldPending = pdTRUE;
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
 
-    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    static void prvEDFAdmitTask( TCB_t * pxTCB )
     {
-        UBaseType_t uxReturn;
-        TCB_t const * pxTCB;
+        pxTCB->pxNextAdmittedTCB = NULL;
 
-        if( xTask != NULL )
+        if( pxTCB->xTaskWcet > ( TickType_t ) 0U )
         {
-            pxTCB = xTask;
-            uxReturn = pxTCB->uxTaskNumber;
+            pxTCB->ulTaskUtilisation = prvEDFUtilisation( pxTCB->xTaskWcet, pxTCB->xTaskPeriod );
+            ulAdmittedUtilisation += pxTCB->ulTaskUtilisation;
+
+            if( pxTCB->xTaskRelativeDeadline != pxTCB->xTaskPeriod )
+            {
+                uxAdmittedConstrainedTasks++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->pxNextAdmittedTCB = pxAdmittedTasks;
+            pxAdmittedTasks = pxTCB;
         }
         else
         {
-            uxReturn = 0U;
+            pxTCB->ulTaskUtilisation = 0UL;
         }
-
-        return uxReturn;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    void vTaskSetTaskNumber( TaskHandle_t xTask,
-                             const UBaseType_t uxHandle )
+    static void prvEDFReleaseTask( TCB_t * pxTCB )
     {
-        TCB_t * pxTCB;
+        TCB_t ** ppxLink;
 
-        if( xTask != NULL )
+        /* The admission fields of pxTCB are only read once it is found
+         * amongst the admitted tasks, so this can be called for tasks that
+         * were not created by xTaskPeriodicCreateExtended(). */
+        for( ppxLink = &pxAdmittedTasks; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextAdmittedTCB ) )
         {
-            pxTCB = xTask;
-            pxTCB->uxTaskNumber = uxHandle;
+            if( *ppxLink == pxTCB )
+            {
+                *ppxLink = pxTCB->pxNextAdmittedTCB;
+                ulAdmittedUtilisation -= pxTCB->ulTaskUtilisation;
+
+                if( pxTCB->xTaskRelativeDeadline != pxTCB->xTaskPeriod )
+                {
+                    uxAdmittedConstrainedTasks--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
-
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-		TickType_t currentTick = 0;
-		TCB_t * pxIdleTCB;
-    /* Stop warnings. */
-    ( void ) pvParameters;
+    uint32_t ulTaskGetRemainingUtilisation( void )
+    {
+        uint32_t ulReturn;
 
+        taskENTER_CRITICAL();
+        {
+            ulReturn = tskUTILISATION_SCALE - ulAdmittedUtilisation;
+        }
+        taskEXIT_CRITICAL();
 
-    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-     * SCHEDULER IS STARTED. **/
+        return ulReturn;
+    }
+    /*-----------------------------------------------------------*/
 
-    /* In case a task that has a secure context deletes itself, in which case
-     * the idle task is responsible for deleting the task's secure context, if
-     * any. */
-    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
-		
+    #if ( configUSE_EDF_MODE_CHANGES == 1 )
 
-    for( ; ; )
-    {
-        /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
-				
-				#if (configUSE_EDF_SCHEDULER == 1 )
-					pxIdleTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyTasksListEDF ) );
-					currentTick = xTaskGetTickCount();
+        static BaseType_t prvEDFModeChangeTest( const ModeTaskParameters_t * const pxTasks,
+                                                const UBaseType_t uxNumberOfTasks )
+        {
+            const TCB_t * pxTCB;
+            uint32_t ulDensity = 0UL, ulOldDensity, ulNewDensity;
+            UBaseType_t uxIndex;
+            BaseType_t xReturn;
 
-					listSET_LIST_ITEM_VALUE( &( ( pxIdleTCB )->xStateListItem ), ( pxIdleTCB)->xTaskPeriod + currentTick);
-				#endif
-			
-        #if ( configUSE_PREEMPTION == 0 )
+            /* A task set is schedulable by EDF if the densities of its tasks,
+             * using the smaller of the deadline and the period, sum to at most
+             * one.  A changing task has either an old or a new job outstanding
+             * at any time, so allowing each for the larger of its old and new
+             * density covers the transition as well as the new mode.  The test
+             * is only sufficient, so it can refuse a change to or from a task
+             * set that the processor demand test accepted. */
+            for( pxTCB = pxAdmittedTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextAdmittedTCB )
             {
-                /* If we are not using preemption we keep forcing a task switch to
-                 * see if any other task has become available.  If we are using
-                 * preemption we don't need to do this as any task becoming available
-                 * will automatically get the processor anyway. */
-                taskYIELD();
-            }
-        #endif /* configUSE_PREEMPTION */
+                ulOldDensity = prvEDFDensity( pxTCB->xTaskWcet, pxTCB->xTaskPeriod, pxTCB->xTaskRelativeDeadline );
 
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
-            {
-                /* When using preemption tasks of equal priority will be
-                 * timesliced.  If a task that is sharing the idle priority is ready
-                 * to run then the idle task should yield before the end of the
-                 * timeslice.
-                 *
-                 * A critical region is not required here as we are just reading from
-                 * the list, and an occasional incorrect value will not matter.  If
-                 * the ready list at the idle priority contains more than one task
-                 * then a task other than the idle task is ready to execute. */
-                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+                /* A pending change of period or deadline is allowed for in
+                 * the same way, even if the mode drops it. */
+                if( pxTCB->xPendingPeriod > ( TickType_t ) 0U )
                 {
-                    taskYIELD();
+                    ulNewDensity = prvEDFDensity( pxTCB->xTaskWcet, pxTCB->xPendingPeriod, pxTCB->xPendingRelativeDeadline );
+
+                    if( ulNewDensity > ulOldDensity )
+                    {
+                        ulOldDensity = ulNewDensity;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-            }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
-
-        #if ( configUSE_IDLE_HOOK == 1 )
-            {
-                extern void vApplicationIdleHook( void );
 
-                /* Call the user defined function from within the idle task.  This
-                 * allows the application designer to add background functionality
-                 * without the overhead of a separate task.
-                 * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-                 * CALL A FUNCTION THAT MIGHT BLOCK. */
-                vApplicationIdleHook();
+                ulDensity += ulOldDensity;
             }
-        #endif /* configUSE_IDLE_HOOK */
 
-        /* This conditional compilation should use inequality to 0, not equality
-         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-         * user defined low power mode  implementations require
-         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+            for( uxIndex = ( UBaseType_t ) 0U; uxIndex < uxNumberOfTasks; uxIndex++ )
             {
-                TickType_t xExpectedIdleTime;
-
-                /* It is not desirable to suspend then resume the scheduler on
-                 * each iteration of the idle task.  Therefore, a preliminary
-                 * test of the expected idle time is performed without the
-                 * scheduler suspended.  The result here is not necessarily
-                 * valid. */
-                xExpectedIdleTime = prvGetExpectedIdleTime();
+                pxTCB = pxTasks[ uxIndex ].xTask;
+                configASSERT( pxTCB != NULL );
 
-                if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                /* A task that is disabled or not accounted for claims
+                 * nothing now. */
+                if( pxTCB->ulTaskUtilisation > 0UL )
                 {
-                    vTaskSuspendAll();
-                    {
-                        /* Now the scheduler is suspended, the expected idle
-                         * time can be sampled again, and this time its value can
-                         * be used. */
-                        configASSERT( xNextTaskUnblockTime >= xTickCount );
-                        xExpectedIdleTime = prvGetExpectedIdleTime();
+                    ulOldDensity = prvEDFDensity( pxTCB->xTaskWcet, pxTCB->xTaskPeriod, pxTCB->xTaskRelativeDeadline );
+                }
+                else
+                {
+                    ulOldDensity = 0UL;
+                }
 
-                        /* Define the following macro to set xExpectedIdleTime to 0
-                         * if the application does not want
-                         * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-                        configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+                if( ( pxTasks[ uxIndex ].xPeriod == ( TickType_t ) 0U ) || ( pxTasks[ uxIndex ].xWcet == ( TickType_t ) 0U ) )
+                {
+                    ulNewDensity = 0UL;
+                }
+                else if( pxTasks[ uxIndex ].xRelativeDeadline == ( TickType_t ) 0U )
+                {
+                    ulNewDensity = prvEDFUtilisation( pxTasks[ uxIndex ].xWcet, pxTasks[ uxIndex ].xPeriod );
+                }
+                else
+                {
+                    ulNewDensity = prvEDFDensity( pxTasks[ uxIndex ].xWcet, pxTasks[ uxIndex ].xPeriod, pxTasks[ uxIndex ].xRelativeDeadline );
+                }
 
-                        if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-                        {
-                            traceLOW_POWER_IDLE_BEGIN();
-                            portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-                            traceLOW_POWER_IDLE_END();
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    ( void ) xTaskResumeAll();
+                if( ulNewDensity > ulOldDensity )
+                {
+                    ulDensity += ulNewDensity - ulOldDensity;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-        #endif /* configUSE_TICKLESS_IDLE */
-    }
-}
-/*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+            if( ulDensity > tskUTILISATION_SCALE )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                xReturn = pdTRUE;
+            }
+
+            return xReturn;
+        }
+        /*-----------------------------------------------------------*/
 
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    #endif /* configUSE_EDF_MODE_CHANGES */
+
+    static void prvEDFClaimUtilisation( TCB_t * const pxTCB,
+                                        const TickType_t xWcet,
+                                        const TickType_t xPeriod )
     {
-        /* The idle task exists in addition to the application tasks. */
-        const UBaseType_t uxNonApplicationTasks = 1;
-        eSleepModeStatus eReturn = eStandardSleep;
+        uint32_t ulNewUtilisation = 0UL;
 
-        /* This function must be called from a critical section. */
+        /* Any earlier claim is replaced. */
+        ulAdmittedUtilisation -= pxTCB->ulPendingClaim;
 
-        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        if( ( xPeriod > ( TickType_t ) 0U ) && ( xWcet > ( TickType_t ) 0U ) )
         {
-            /* A task was made ready while the scheduler was suspended. */
-            eReturn = eAbortSleep;
+            ulNewUtilisation = prvEDFUtilisation( xWcet, xPeriod );
         }
-        else if( xYieldPending != pdFALSE )
+        else
         {
-            /* A yield was pended while the scheduler was suspended. */
-            eReturn = eAbortSleep;
+            mtCOVERAGE_TEST_MARKER();
         }
-        else if( xPendedTicks != 0 )
+
+        /* While the old job and the first new one are both outstanding the
+         * task can need the larger of its old and new share of the
+         * processor. */
+        if( ulNewUtilisation > pxTCB->ulTaskUtilisation )
         {
-            /* A tick interrupt has already occurred but was held pending
-             * because the scheduler is suspended. */
-            eReturn = eAbortSleep;
+            pxTCB->ulPendingClaim = ulNewUtilisation - pxTCB->ulTaskUtilisation;
+            ulAdmittedUtilisation += pxTCB->ulPendingClaim;
         }
         else
         {
-            /* If all the tasks are in the suspended list (which might mean they
-             * have an infinite block time rather than actually being suspended)
-             * then it is safe to turn all clocks off and just wait for external
-             * interrupts. */
-            if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            pxTCB->ulPendingClaim = 0UL;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+#endif /* configUSE_EDF_ADMISSION_CONTROL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_FP_PRIORITY_ASSIGNMENT == 1 )
+
+/* The timing a periodic task is ranked by, the shorter the higher. */
+    #if ( configFP_PRIORITY_POLICY == tskPRIORITY_RATE_MONOTONIC )
+        #define taskFP_RANK_KEY( pxTCB )    ( ( pxTCB )->xTaskPeriod )
+    #else
+        #define taskFP_RANK_KEY( pxTCB )    ( ( pxTCB )->xTaskRelativeDeadline )
+    #endif
+
+/* The utilisation of a task rounded up, so the sum over the task set never
+ * understates the load. */
+    #define taskFP_UTILISATION( xWcet, xPeriod ) \
+    ( ( uint32_t ) ( ( ( ( uint64_t ) ( xWcet ) * ( uint64_t ) tskUTILISATION_SCALE ) + ( uint64_t ) ( xPeriod ) - ( uint64_t ) 1U ) / ( uint64_t ) ( xPeriod ) ) )
+
+/* The Liu and Layland bound n(2^(1/n) - 1) for n tasks, scaled by
+ * tskUTILISATION_SCALE and rounded down.  Beyond the table the bound tends to
+ * ln(2), which is used as it is below every entry. */
+    #define taskFP_BOUND_TABLE_LENGTH    ( 10U )
+    #define taskFP_BOUND_LIMIT           ( ( uint32_t ) 45426UL )
+
+    static const uint32_t ulFPUtilisationBound[ taskFP_BOUND_TABLE_LENGTH ] =
+    {
+        65536UL, 54291UL, 51102UL, 49599UL, 48725UL, 48154UL, 47751UL, 47452UL, 47221UL, 47037UL
+    };
+
+    static void prvFPRegisterTask( TCB_t * pxTCB )
+    {
+        TCB_t ** ppxLink;
+
+        /* Insert the task after those ranked at or above it, so of the tasks
+         * that share a rank the first created stays first. */
+        for( ppxLink = &pxFPPeriodicTasks; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextPeriodicTCB ) )
+        {
+            if( taskFP_RANK_KEY( *ppxLink ) > taskFP_RANK_KEY( pxTCB ) )
             {
-                eReturn = eNoTasksWaitingTimeout;
+                break;
             }
             else
             {
@@ -3760,435 +7859,369 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
             }
         }
 
-        return eReturn;
+        pxTCB->pxNextPeriodicTCB = *ppxLink;
+        *ppxLink = pxTCB;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*-----------------------------------------------------------*/
-
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
-
-    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
-                                            BaseType_t xIndex,
-                                            void * pvValue )
+    static void prvFPUnregisterTask( TCB_t * pxTCB )
     {
-        TCB_t * pxTCB;
+        TCB_t ** ppxLink;
 
-        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
+        /* Tasks not created by xTaskPeriodicCreateExtended() are simply not
+         * found. */
+        for( ppxLink = &pxFPPeriodicTasks; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextPeriodicTCB ) )
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToSet );
-            configASSERT( pxTCB != NULL );
-            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+            if( *ppxLink == pxTCB )
+            {
+                *ppxLink = pxTCB->pxNextPeriodicTCB;
+                pxTCB->pxNextPeriodicTCB = NULL;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
-
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
-
-    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
-                                               BaseType_t xIndex )
+    static BaseType_t prvFPAssignPriorities( void )
     {
-        void * pvReturn = NULL;
         TCB_t * pxTCB;
+        TickType_t xPreviousKey = ( TickType_t ) 0U;
+        UBaseType_t uxPriority = ( UBaseType_t ) configFP_HIGHEST_PERIODIC_PRIORITY;
+        UBaseType_t uxPriorityUsedOnEntry;
+        BaseType_t xReturn = pdFALSE;
 
-        if( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS )
-        {
-            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
-        }
-        else
+        for( pxTCB = pxFPPeriodicTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextPeriodicTCB )
         {
-            pvReturn = NULL;
-        }
-
-        return pvReturn;
-    }
-
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
-/*-----------------------------------------------------------*/
+            /* Each new rank takes the next priority down, until only the
+             * priority above the idle priority is left for the remaining
+             * ranks. */
+            if( ( pxTCB != pxFPPeriodicTasks ) &&
+                ( taskFP_RANK_KEY( pxTCB ) != xPreviousKey ) &&
+                ( uxPriority > ( UBaseType_t ) 1U ) )
+            {
+                uxPriority--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+            xPreviousKey = taskFP_RANK_KEY( pxTCB );
 
-    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
-                                  const MemoryRegion_t * const xRegions )
-    {
-        TCB_t * pxTCB;
+            if( pxTCB->uxAssignedPriority != uxPriority )
+            {
+                pxTCB->uxAssignedPriority = uxPriority;
 
-        /* If null is passed in here then we are modifying the MPU settings of
-         * the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+                /* As vTaskPrioritySet(), without the yield, which is left to
+                 * the caller once every task has its new priority. */
+                uxPriorityUsedOnEntry = pxTCB->uxPriority;
 
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
-    }
+                #if ( configUSE_MUTEXES == 1 )
+                    {
+                        /* An inherited priority is kept until the mutex is
+                         * given back. */
+                        if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+                        {
+                            pxTCB->uxPriority = uxPriority;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
 
-#endif /* portUSING_MPU_WRAPPERS */
-/*-----------------------------------------------------------*/
+                        pxTCB->uxBasePriority = uxPriority;
+                    }
+                #else
+                    {
+                        pxTCB->uxPriority = uxPriority;
+                    }
+                #endif
 
-static void prvInitialiseTaskLists( void )
-{
-    UBaseType_t uxPriority;
+                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
-    {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-    }
+                if( ( pxTCB->uxPriority != uxPriorityUsedOnEntry ) &&
+                    ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+                {
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    {
+                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-		#if ( configUSE_EDF_SCHEDULER == 1 )
-				vListInitialise( &xReadyTasksListEDF );
-		#endif
-		
-    #if ( INCLUDE_vTaskDelete == 1 )
-        {
-            vListInitialise( &xTasksWaitingTermination );
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-    #endif /* INCLUDE_vTaskDelete */
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
-        {
-            vListInitialise( &xSuspendedTaskList );
-        }
-    #endif /* INCLUDE_vTaskSuspend */
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
-/*-----------------------------------------------------------*/
+    static BaseType_t prvFPResponseTimeMeetsDeadline( const TCB_t * const pxTCB )
+    {
+        const TCB_t * pxOtherTCB;
+        uint64_t ullResponseTime, ullNextResponseTime;
+        BaseType_t xReturn = pdTRUE;
 
-static void prvCheckTasksWaitingTermination( void )
-{
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+        /* Iterate R = C + sum of ceil(R / Tj) * Cj over the tasks of the same
+         * or a higher priority from R = C.  R only grows, so it either
+         * settles at the worst case response time or passes the deadline. */
+        ullNextResponseTime = ( uint64_t ) pxTCB->xTaskWcet;
 
-    #if ( INCLUDE_vTaskDelete == 1 )
+        do
         {
-            TCB_t * pxTCB;
+            ullResponseTime = ullNextResponseTime;
+            ullNextResponseTime = ( uint64_t ) pxTCB->xTaskWcet;
 
-            /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-             * being called too often in the idle task. */
-            while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+            for( pxOtherTCB = pxFPPeriodicTasks; pxOtherTCB != NULL; pxOtherTCB = pxOtherTCB->pxNextPeriodicTCB )
             {
-                taskENTER_CRITICAL();
+                if( ( pxOtherTCB != pxTCB ) &&
+                    ( pxOtherTCB->xTaskWcet > ( TickType_t ) 0U ) &&
+                    ( pxOtherTCB->uxAssignedPriority >= pxTCB->uxAssignedPriority ) )
                 {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    --uxCurrentNumberOfTasks;
-                    --uxDeletedTasksWaitingCleanUp;
+                    ullNextResponseTime += ( ( ullResponseTime + ( uint64_t ) pxOtherTCB->xTaskPeriod - ( uint64_t ) 1U ) / ( uint64_t ) pxOtherTCB->xTaskPeriod ) * ( uint64_t ) pxOtherTCB->xTaskWcet;
                 }
-                taskEXIT_CRITICAL();
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
 
-                prvDeleteTCB( pxTCB );
+            if( ullNextResponseTime > ( uint64_t ) pxTCB->xTaskRelativeDeadline )
+            {
+                xReturn = pdFALSE;
+                break;
             }
-        }
-    #endif /* INCLUDE_vTaskDelete */
-}
-/*-----------------------------------------------------------*/
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } while( ullNextResponseTime != ullResponseTime );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
 
-    void vTaskGetInfo( TaskHandle_t xTask,
-                       TaskStatus_t * pxTaskStatus,
-                       BaseType_t xGetFreeStackSpace,
-                       eTaskState eState )
+    eFixedPriorityTestResult eTaskTestFixedPriorityTaskSet( TaskHandle_t * const pxFailingTask )
     {
         TCB_t * pxTCB;
+        const TCB_t * pxPreviousTCB = NULL;
+        TCB_t * pxFailingTCB = NULL;
+        uint32_t ulUtilisation = 0UL, ulBound;
+        UBaseType_t uxTasks = ( UBaseType_t ) 0U;
+        BaseType_t xBoundApplies = pdTRUE;
+        eFixedPriorityTestResult eReturn;
 
-        /* xTask is NULL then get the state of the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
-        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-        pxTaskStatus->pxStackBase = pxTCB->pxStack;
-        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
-
-        #if ( configUSE_MUTEXES == 1 )
+        vTaskSuspendAll();
+        {
+            for( pxTCB = pxFPPeriodicTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextPeriodicTCB )
             {
-                pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+                if( pxTCB->xTaskWcet > ( TickType_t ) 0U )
+                {
+                    ulUtilisation += taskFP_UTILISATION( pxTCB->xTaskWcet, pxTCB->xTaskPeriod );
+                    uxTasks++;
+
+                    /* The bound is for implicit deadlines and rate monotonic
+                     * priorities.  Tasks are ranked in order, so two tasks of
+                     * different rates forced to share a priority are next to
+                     * each other. */
+                    if( ( pxTCB->xTaskRelativeDeadline != pxTCB->xTaskPeriod ) ||
+                        ( ( pxPreviousTCB != NULL ) &&
+                          ( pxPreviousTCB->uxAssignedPriority == pxTCB->uxAssignedPriority ) &&
+                          ( pxPreviousTCB->xTaskPeriod != pxTCB->xTaskPeriod ) ) )
+                    {
+                        xBoundApplies = pdFALSE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxPreviousTCB = pxTCB;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-        #else
+
+            if( uxTasks == ( UBaseType_t ) 0U )
             {
-                pxTaskStatus->uxBasePriority = 0;
+                ulBound = tskUTILISATION_SCALE;
             }
-        #endif
-
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            else if( uxTasks <= ( UBaseType_t ) taskFP_BOUND_TABLE_LENGTH )
             {
-                pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+                ulBound = ulFPUtilisationBound[ uxTasks - ( UBaseType_t ) 1U ];
             }
-        #else
+            else
             {
-                pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+                ulBound = taskFP_BOUND_LIMIT;
             }
-        #endif
 
-        /* Obtaining the task state is a little fiddly, so is only done if the
-         * value of eState passed into this function is eInvalid - otherwise the
-         * state is just set to whatever is passed in. */
-        if( eState != eInvalid )
-        {
-            if( pxTCB == pxCurrentTCB )
+            if( ( xBoundApplies != pdFALSE ) && ( ulUtilisation <= ulBound ) )
             {
-                pxTaskStatus->eCurrentState = eRunning;
+                eReturn = eFixedPriorityBoundMet;
             }
             else
             {
-                pxTaskStatus->eCurrentState = eState;
+                /* The bound is only sufficient, so fall back to the exact
+                 * test, stopping at the highest priority task that fails. */
+                eReturn = eFixedPriorityResponseTimesMet;
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
+                for( pxTCB = pxFPPeriodicTasks; pxTCB != NULL; pxTCB = pxTCB->pxNextPeriodicTCB )
+                {
+                    if( ( pxTCB->xTaskWcet > ( TickType_t ) 0U ) &&
+                        ( prvFPResponseTimeMeetsDeadline( pxTCB ) == pdFALSE ) )
                     {
-                        /* If the task is in the suspended list then there is a
-                         *  chance it is actually just blocked indefinitely - so really
-                         *  it should be reported as being in the Blocked state. */
-                        if( eState == eSuspended )
-                        {
-                            vTaskSuspendAll();
-                            {
-                                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                                {
-                                    pxTaskStatus->eCurrentState = eBlocked;
-                                }
-                            }
-                            ( void ) xTaskResumeAll();
-                        }
+                        pxFailingTCB = pxTCB;
+                        eReturn = eFixedPriorityDeadlineMissed;
+                        break;
                     }
-                #endif /* INCLUDE_vTaskSuspend */
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
         }
-        else
-        {
-            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
-        }
+        ( void ) xTaskResumeAll();
 
-        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-         * parameter is provided to allow it to be skipped. */
-        if( xGetFreeStackSpace != pdFALSE )
+        if( pxFailingTask != NULL )
         {
-            #if ( portSTACK_GROWTH > 0 )
-                {
-                    pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-                }
-            #else
-                {
-                    pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-                }
-            #endif
+            *pxFailingTask = ( TaskHandle_t ) pxFailingTCB;
         }
         else
         {
-            pxTaskStatus->usStackHighWaterMark = 0;
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        return eReturn;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_FP_PRIORITY_ASSIGNMENT */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_EDF_CBS == 1 )
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+    static void prvCBSJobArrival( TCB_t * pxTCB )
     {
-        configLIST_VOLATILE TCB_t * pxNextTCB, * pxFirstTCB;
-        UBaseType_t uxTask = 0;
+        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xDeadline = pxTCB->xTaskAbsoluteDeadline;
 
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
-        {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        pxTCB->ucCBSServerIdle = pdFALSE;
 
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
-            do
-            {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-                uxTask++;
-            } while( pxNextTCB != pxFirstTCB );
+        /* Keep the current deadline and budget if serving the job with them
+         * would not exceed the server bandwidth, that is if
+         * budget / ( deadline - now ) < max budget / period.  Otherwise, or
+         * if the deadline has passed, start a new server period with a full
+         * budget. */
+        if( ( ( TickType_t ) ( xConstTickCount - xDeadline ) <= ( portMAX_DELAY >> 1 ) ) ||
+            ( ( ( uint64_t ) pxTCB->xCBSBudget * ( uint64_t ) pxTCB->xTaskPeriod ) >= ( ( uint64_t ) ( xDeadline - xConstTickCount ) * ( uint64_t ) pxTCB->xCBSMaxBudget ) ) )
+        {
+            pxTCB->xCBSBudget = pxTCB->xCBSMaxBudget;
+            pxTCB->xTaskAbsoluteDeadline = xConstTickCount + pxTCB->xTaskPeriod;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        return uxTask;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
-
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
-
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static BaseType_t prvCBSChargeBudget( TCB_t * pxTCB )
     {
-        uint32_t ulCount = 0U;
+        BaseType_t xReturn = pdFALSE;
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        if( pxTCB->xCBSBudget > ( TickType_t ) 0U )
         {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
+            ( pxTCB->xCBSBudget )--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
-
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
-    }
-
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
-
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        configSTACK_DEPTH_TYPE uxReturn;
-
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
-
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        #if portSTACK_GROWTH < 0
-            {
-                pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-            }
-        #else
-            {
-                pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-            }
-        #endif
-
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+        if( pxTCB->xCBSBudget == ( TickType_t ) 0U )
+        {
+            /* The budget is exhausted.  Recharge it and postpone the deadline
+             * by one period, which moves the server behind the tasks whose
+             * deadlines now come first. */
+            pxTCB->xCBSBudget = pxTCB->xCBSMaxBudget;
+            pxTCB->xTaskAbsoluteDeadline += pxTCB->xTaskPeriod;
+            prvEDFRepositionReadyTask( pxTCB );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        return uxReturn;
+        return xReturn;
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
-
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    void vTaskCBSInitialise( TaskHandle_t xTask,
+                             TickType_t xBudget )
     {
         TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
 
         pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( xBudget > ( TickType_t ) 0U );
+        configASSERT( xBudget <= pxTCB->xTaskPeriod );
 
-        #if portSTACK_GROWTH < 0
-            {
-                pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-            }
-        #else
-            {
-                pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-            }
-        #endif
-
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
-
-        return uxReturn;
-    }
-
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskDelete == 1 )
-
-    static void prvDeleteTCB( TCB_t * pxTCB )
-    {
-        /* This call is required specifically for the TriCore port.  It must be
-         * above the vPortFree() calls.  The call is also used by ports/demos that
-         * want to allocate and clean RAM statically. */
-        portCLEAN_UP_TCB( pxTCB );
-
-        /* Free up the memory allocated by the scheduler for the task.  It is up
-         * to the task to free any memory allocated at the application level.
-         * See the third party link http://www.nadler.com/embedded/newlibAndFreeRTOS.html
-         * for additional information. */
-        #if ( configUSE_NEWLIB_REENTRANT == 1 )
-            {
-                _reclaim_reent( &( pxTCB->xNewLib_reent ) );
-            }
-        #endif /* configUSE_NEWLIB_REENTRANT */
+        taskENTER_CRITICAL();
+        {
+            pxTCB->xCBSMaxBudget = xBudget;
+            pxTCB->xCBSBudget = xBudget;
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
-            {
-                /* The task can only have been allocated dynamically - free both
-                 * the stack and TCB. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
-            }
-        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
-            {
-                /* The task could have been allocated statically or dynamically, so
-                 * check what was statically allocated before trying to free the
-                 * memory. */
-                if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
-                {
-                    /* Both the stack and TCB were allocated dynamically, so both
-                     * must be freed. */
-                    vPortFreeStack( pxTCB->pxStack );
-                    vPortFree( pxTCB );
-                }
-                else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
-                {
-                    /* Only the stack was statically allocated, so the TCB is the
-                     * only memory that must be freed. */
-                    vPortFree( pxTCB );
-                }
-                else
+            #if ( configUSE_EDF_BUDGET_ENFORCEMENT == 1 )
                 {
-                    /* Neither the stack nor the TCB were allocated dynamically, so
-                     * nothing needs to be freed. */
-                    configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The server postpones its deadline when its own budget
+                     * is exhausted, which would otherwise count as an overrun
+                     * of the job it is serving. */
+                    pxTCB->ulJobBudget = ( configRUN_TIME_COUNTER_TYPE ) 0U;
                 }
-            }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+            #endif
+        }
+        taskEXIT_CRITICAL();
     }
+    /*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
-
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
+    void vTaskCBSSetServerIdle( BaseType_t xIdle )
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        taskENTER_CRITICAL();
+        {
+            pxCurrentTCB->ucCBSServerIdle = ( uint8_t ) xIdle;
+        }
+        taskEXIT_CRITICAL();
     }
-}
+
+#endif /* configUSE_EDF_CBS */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4248,6 +8281,15 @@ static void prvResetNextTaskUnblockTime( void )
          * needed as interrupts can no longer use mutexes? */
         if( pxMutexHolder != NULL )
         {
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* The mutex holder runs with the deadline of the task
+                     * attempting to obtain the mutex if it is earlier than its
+                     * own. */
+                    xReturn = prvEDFInheritDeadline( pxMutexHolderTCB, pxCurrentTCB );
+                }
+            #endif
+
             /* If the holder of the mutex has a priority below the priority of
              * the task attempting to obtain the mutex then it will temporarily
              * inherit the priority of the task attempting to obtain the mutex. */
@@ -4343,6 +8385,21 @@ static void prvResetNextTaskUnblockTime( void )
             configASSERT( pxTCB->uxMutexesHeld );
             ( pxTCB->uxMutexesHeld )--;
 
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* As with priorities, an inherited deadline is only given
+                     * back once no other mutexes are held. */
+                    if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+                    {
+                        xReturn = prvEDFDisinheritDeadline( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
             /* Has the holder of the mutex inherited the priority of another
              * task? */
             if( pxTCB->uxPriority != pxTCB->uxBasePriority )
@@ -4355,7 +8412,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * given from an interrupt, and if a mutex is given by the
                      * holding task then it must be the running state task.  Remove
                      * the holding task from the ready list. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    if( prvRemoveTaskFromStateList( pxTCB ) == ( UBaseType_t ) 0 )
                     {
                         portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
                     }
@@ -4421,6 +8478,24 @@ static void prvResetNextTaskUnblockTime( void )
              * one mutex. */
             configASSERT( pxTCB->uxMutexesHeld );
 
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* The deadlines of the tasks still waiting are not known
+                     * here, so an inherited deadline is only given back if no
+                     * task is left waiting for the only mutex held.  Otherwise
+                     * it is kept until the mutex is released, even when it was
+                     * the task that timed out that lent it. */
+                    if( ( uxHighestPriorityWaitingTask == tskIDLE_PRIORITY ) && ( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld ) )
+                    {
+                        ( void ) prvEDFDisinheritDeadline( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            #endif
+
             /* Determine the priority to which the priority of the task that
              * holds the mutex should be set.  This will be the greater of the
              * holding task's base priority and the priority of the highest
@@ -4787,7 +8862,7 @@ static void prvResetNextTaskUnblockTime( void )
                     {
                         #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
                             {
-                                sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+                                sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
                             }
                         #else
                             {
@@ -4803,7 +8878,7 @@ static void prvResetNextTaskUnblockTime( void )
                          * consumed less than 1% of the total run time. */
                         #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
                             {
-                                sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+                                sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
                             }
                         #else
                             {
@@ -4835,6 +8910,399 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_EDF_JOB_STATISTICS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    void vTaskGetJobStats( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        const TaskJobStatistics_t * pxStats;
+        TickType_t xMeanResponseTime, xStartJitter;
+
+        #if ( configUSE_TRACE_FACILITY != 1 )
+            {
+                #error configUSE_TRACE_FACILITY must also be set to 1 in FreeRTOSConfig.h to use vTaskGetJobStats().
+            }
+        #endif
+
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, like
+         * vTaskGetRunTimeStats(), and has the same dependency on sprintf().
+         *
+         * vTaskGetJobStats() calls uxTaskGetSystemState(), then formats the job
+         * statistics of each task that has completed a job into a human
+         * readable table of the number of jobs, the minimum, mean and maximum
+         * response time, the start jitter, the maximum lateness and the number
+         * of deadline misses, all times in ticks.
+         */
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* Allocate an array index for each task.  NOTE!  If
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
+        {
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+
+            /* Create a human readable table from the binary data. */
+            for( x = 0; x < uxArraySize; x++ )
+            {
+                pxStats = &( pxTaskStatusArray[ x ].xJobStatistics );
+
+                /* Tasks without a completed job have nothing to report. */
+                if( pxStats->uxJobsCompleted > ( UBaseType_t ) 0U )
+                {
+                    xMeanResponseTime = ( TickType_t ) ( pxStats->ulTotalResponseTime / ( uint32_t ) pxStats->uxJobsCompleted );
+                    xStartJitter = pxStats->xMaxStartDelay - pxStats->xMinStartDelay;
+
+                    /* Write the task name to the string, padding with spaces so
+                     * it can be printed in tabular form more easily. */
+                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                    /* Write the rest of the string. */
+                    sprintf( pcWriteBuffer, "\t%u\t%u\t%u\t%u\t%u\t%u\t%u\r\n", ( unsigned int ) pxStats->uxJobsCompleted, ( unsigned int ) pxStats->xMinResponseTime, ( unsigned int ) xMeanResponseTime, ( unsigned int ) pxStats->xMaxResponseTime, ( unsigned int ) xStartJitter, ( unsigned int ) pxTaskStatusArray[ x ].xMaxLateness, ( unsigned int ) pxTaskStatusArray[ x ].uxDeadlineMisses ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configUSE_EDF_JOB_STATISTICS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+    static TCB_t * prvStatsNextTaskInList( List_t * pxList,
+                                           UBaseType_t uxAfter,
+                                           TCB_t * pxNextTCB,
+                                           eTaskState eListState,
+                                           eTaskState * peState )
+    {
+        const ListItem_t * pxItem;
+        const ListItem_t * const pxEnd = listGET_END_MARKER( pxList );
+        TCB_t * pxTCB;
+
+        /* The list is walked from its end marker rather than with
+         * listGET_OWNER_OF_NEXT_ENTRY(), which would move the index that
+         * shares the processor between tasks of equal priority. */
+        for( pxItem = listGET_HEAD_ENTRY( pxList ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+        {
+            pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            if( ( pxTCB->uxTCBNumber > uxAfter ) &&
+                ( ( pxNextTCB == NULL ) || ( pxTCB->uxTCBNumber < pxNextTCB->uxTCBNumber ) ) )
+            {
+                pxNextTCB = pxTCB;
+                *peState = eListState;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pxNextTCB;
+    }
+    /*-----------------------------------------------------------*/
+
+    static uint8_t * prvStatsWriteDecimal( uint8_t * pucRecord,
+                                           uint64_t ullValue )
+    {
+        uint8_t ucDigits[ 20 ];
+        uint32_t ulValue;
+        UBaseType_t uxDigits = 0;
+
+        /* Divide in 64 bits only while the value needs it, as 64 bit division
+         * is done by a slow library call on most 32 bit targets. */
+        while( ullValue > ( uint64_t ) 0xffffffffUL )
+        {
+            ucDigits[ uxDigits++ ] = ( uint8_t ) ( '0' + ( uint8_t ) ( ullValue % 10U ) );
+            ullValue /= 10U;
+        }
+
+        ulValue = ( uint32_t ) ullValue;
+
+        do
+        {
+            ucDigits[ uxDigits++ ] = ( uint8_t ) ( '0' + ( uint8_t ) ( ulValue % 10UL ) );
+            ulValue /= 10UL;
+        } while( ulValue > 0UL );
+
+        /* The digits were found least significant first. */
+        while( uxDigits > ( UBaseType_t ) 0U )
+        {
+            *pucRecord++ = ucDigits[ --uxDigits ];
+        }
+
+        return pucRecord;
+    }
+    /*-----------------------------------------------------------*/
+
+    static uint8_t * prvStatsWriteVarint( uint8_t * pucRecord,
+                                          uint64_t ullValue )
+    {
+        while( ullValue >= ( uint64_t ) 0x80U )
+        {
+            *pucRecord++ = ( uint8_t ) ( ( ullValue & 0x7fU ) | 0x80U );
+            ullValue >>= 7;
+        }
+
+        *pucRecord++ = ( uint8_t ) ullValue;
+
+        return pucRecord;
+    }
+    /*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskStreamStats( eTaskStatsEncoding eEncoding,
+                                   TaskStatsSink_t pxSink,
+                                   void * pvContext )
+    {
+        static const char pcColumns[] = "name,number,state,priority,stack,run_time,cpu\r\n";
+        uint8_t ucRecord[ tskSTATS_RECORD_LENGTH ];
+        uint8_t * pucEnd;
+        TaskStatus_t xTaskStatus;
+        TCB_t * pxTCB;
+        eTaskState eState = eInvalid;
+        UBaseType_t uxLastNumber = ( UBaseType_t ) 0U, uxRecords = ( UBaseType_t ) 0U, uxQueue, uxNameLength;
+        uint64_t ullTotalTime = 0U, ullHundredths;
+        BaseType_t xContinue = pdTRUE;
+        char cStatus;
+
+        configASSERT( pxSink );
+
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, like
+         * vTaskGetRunTimeStats(), but does not hold the whole report at once.
+         * Instead of copying every task with uxTaskGetSystemState() it finds
+         * the task with the next task number on each step, so the stack used
+         * does not grow with the number of tasks and nothing is allocated.
+         * Each step walks every state list, so a whole report takes time in
+         * proportion to the square of the number of tasks, spread over steps
+         * that each suspend the scheduler for time in proportion to the
+         * number of tasks.
+         */
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    {
+                        configRUN_TIME_COUNTER_TYPE ulTotalTime;
+
+                        portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalTime );
+                        ullTotalTime = ( uint64_t ) ulTotalTime;
+                    }
+                #else
+                    {
+                        ullTotalTime = ( uint64_t ) portGET_RUN_TIME_COUNTER_VALUE();
+                    }
+                #endif
+            }
+        #endif
+
+        /* For percentage calculations, in hundredths of a percent. */
+        ullTotalTime /= 10000U;
+
+        if( eEncoding == eTaskStatsCSV )
+        {
+            xContinue = pxSink( ( const uint8_t * ) pcColumns, sizeof( pcColumns ) - 1U, pvContext );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        while( xContinue != pdFALSE )
+        {
+            pxTCB = NULL;
+
+            vTaskSuspendAll();
+            {
+                /* Find the task with the lowest task number not yet reported,
+                 * which can be in any of the state lists. */
+                for( uxQueue = ( UBaseType_t ) 0U; uxQueue < ( UBaseType_t ) configMAX_PRIORITIES; uxQueue++ )
+                {
+                    pxTCB = prvStatsNextTaskInList( &( pxReadyTasksLists[ uxQueue ] ), uxLastNumber, pxTCB, eReady, &eState );
+                }
+
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    {
+                        /* The heap backend also keeps every Ready task in
+                         * this list, so the heap itself need not be read. */
+                        pxTCB = prvStatsNextTaskInList( &( xReadyTasksListEDF ), uxLastNumber, pxTCB, eReady, &eState );
+                    }
+                #endif
+
+                pxTCB = prvStatsNextTaskInList( ( List_t * ) pxDelayedTaskList, uxLastNumber, pxTCB, eBlocked, &eState );
+                pxTCB = prvStatsNextTaskInList( ( List_t * ) pxOverflowDelayedTaskList, uxLastNumber, pxTCB, eBlocked, &eState );
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                    {
+                        pxTCB = prvStatsNextTaskInList( &xTasksWaitingTermination, uxLastNumber, pxTCB, eDeleted, &eState );
+                    }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                    {
+                        pxTCB = prvStatsNextTaskInList( &xSuspendedTaskList, uxLastNumber, pxTCB, eSuspended, &eState );
+                    }
+                #endif
+
+                /* Read the status while the task cannot be deleted. */
+                if( pxTCB != NULL )
+                {
+                    vTaskGetInfo( ( TaskHandle_t ) pxTCB, &xTaskStatus, pdTRUE, eState );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( pxTCB == NULL )
+            {
+                /* Every task has been reported. */
+                break;
+            }
+            else
+            {
+                uxLastNumber = xTaskStatus.xTaskNumber;
+            }
+
+            /* Avoid divide by zero errors. */
+            if( ullTotalTime > 0U )
+            {
+                ullHundredths = ( uint64_t ) xTaskStatus.ulRunTimeCounter / ullTotalTime;
+
+                /* A task can have run since the total was read. */
+                if( ullHundredths > 10000U )
+                {
+                    ullHundredths = 10000U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                ullHundredths = 0U;
+            }
+
+            uxNameLength = ( UBaseType_t ) strlen( xTaskStatus.pcTaskName ); /*lint !e9016 The task name is always terminated. */
+
+            if( eEncoding == eTaskStatsCSV )
+            {
+                switch( xTaskStatus.eCurrentState )
+                {
+                    case eRunning:
+                        cStatus = tskRUNNING_CHAR;
+                        break;
+
+                    case eReady:
+                        cStatus = tskREADY_CHAR;
+                        break;
+
+                    case eBlocked:
+                        cStatus = tskBLOCKED_CHAR;
+                        break;
+
+                    case eSuspended:
+                        cStatus = tskSUSPENDED_CHAR;
+                        break;
+
+                    case eDeleted:
+                        cStatus = tskDELETED_CHAR;
+                        break;
+
+                    case eInvalid: /* Fall through. */
+                    default:       /* Should not get here, but it is included
+                                    * to prevent static checking errors. */
+                        cStatus = '?';
+                        break;
+                }
+
+                ( void ) memcpy( ( void * ) ucRecord, ( const void * ) xTaskStatus.pcTaskName, ( size_t ) uxNameLength );
+                pucEnd = &( ucRecord[ uxNameLength ] );
+                *pucEnd++ = ( uint8_t ) ',';
+                pucEnd = prvStatsWriteDecimal( pucEnd, ( uint64_t ) xTaskStatus.xTaskNumber );
+                *pucEnd++ = ( uint8_t ) ',';
+                *pucEnd++ = ( uint8_t ) cStatus;
+                *pucEnd++ = ( uint8_t ) ',';
+                pucEnd = prvStatsWriteDecimal( pucEnd, ( uint64_t ) xTaskStatus.uxCurrentPriority );
+                *pucEnd++ = ( uint8_t ) ',';
+                pucEnd = prvStatsWriteDecimal( pucEnd, ( uint64_t ) xTaskStatus.usStackHighWaterMark );
+                *pucEnd++ = ( uint8_t ) ',';
+                pucEnd = prvStatsWriteDecimal( pucEnd, ( uint64_t ) xTaskStatus.ulRunTimeCounter );
+                *pucEnd++ = ( uint8_t ) ',';
+                pucEnd = prvStatsWriteDecimal( pucEnd, ullHundredths / 100U );
+                *pucEnd++ = ( uint8_t ) '.';
+                *pucEnd++ = ( uint8_t ) ( '0' + ( uint8_t ) ( ( ullHundredths / 10U ) % 10U ) );
+                *pucEnd++ = ( uint8_t ) ( '0' + ( uint8_t ) ( ullHundredths % 10U ) );
+                *pucEnd++ = ( uint8_t ) '\r';
+                *pucEnd++ = ( uint8_t ) '\n';
+            }
+            else
+            {
+                /* The length byte is filled in once the record is complete. */
+                pucEnd = &( ucRecord[ 1 ] );
+                *pucEnd++ = ( uint8_t ) xTaskStatus.eCurrentState;
+                pucEnd = prvStatsWriteVarint( pucEnd, ( uint64_t ) xTaskStatus.xTaskNumber );
+                pucEnd = prvStatsWriteVarint( pucEnd, ( uint64_t ) xTaskStatus.uxCurrentPriority );
+                pucEnd = prvStatsWriteVarint( pucEnd, ( uint64_t ) xTaskStatus.usStackHighWaterMark );
+                pucEnd = prvStatsWriteVarint( pucEnd, ( uint64_t ) xTaskStatus.ulRunTimeCounter );
+                pucEnd = prvStatsWriteVarint( pucEnd, ullHundredths );
+                *pucEnd++ = ( uint8_t ) uxNameLength;
+                ( void ) memcpy( ( void * ) pucEnd, ( const void * ) xTaskStatus.pcTaskName, ( size_t ) uxNameLength );
+                pucEnd += uxNameLength;
+                ucRecord[ 0 ] = ( uint8_t ) ( ( pucEnd - ucRecord ) - 1 );
+            }
+
+            configASSERT( ( size_t ) ( pucEnd - ucRecord ) <= sizeof( ucRecord ) );
+
+            xContinue = pxSink( ucRecord, ( size_t ) ( pucEnd - ucRecord ), pvContext );
+
+            if( xContinue != pdFALSE )
+            {
+                uxRecords++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return uxRecords;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*-----------------------------------------------------------*/
+
 TickType_t uxTaskResetEventItemValue( void )
 {
     TickType_t uxReturn;
@@ -5123,7 +9591,11 @@ TickType_t uxTaskResetEventItemValue( void )
                     }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                #else
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5258,7 +9730,11 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                #else
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5349,7 +9825,11 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                    if( prvEDFPreemptsCurrentTask( pxTCB ) != pdFALSE )
+                #else
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #endif
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5491,7 +9971,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
-    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+    if( prvRemoveTaskFromStateList( pxCurrentTCB ) == ( UBaseType_t ) 0 )
     {
         /* The current task must be in a ready list, so there is no need to
          * check, and the port reset macro can be called directly. */
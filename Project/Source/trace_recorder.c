@@ -0,0 +1,451 @@
+/*
+ * FreeRTOS Kernel V10.4.6
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace recorder. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+    #if ( configTRACE_RECORDER_BUFFER_SIZE < ( 2 * recorderMAX_RECORD_LENGTH ) )
+        #error configTRACE_RECORDER_BUFFER_SIZE must hold at least two records of recorderMAX_RECORD_LENGTH bytes
+    #endif
+
+/* The number of varint parameters that follow the time in a record of each
+ * event.  The last parameter of recorderEVENT_TASK_CREATE is the length of the
+ * name that follows it. */
+    static const uint8_t ucParameterCount[ recorderNUMBER_OF_EVENTS ] =
+    {
+        1U, /* recorderEVENT_TICKS */
+        1U, /* recorderEVENT_TASK_SWITCHED_IN */
+        1U, /* recorderEVENT_TASK_READY */
+        1U, /* recorderEVENT_TASK_DELAY */
+        1U, /* recorderEVENT_BLOCK_ON_SEND */
+        1U, /* recorderEVENT_BLOCK_ON_RECEIVE */
+        1U, /* recorderEVENT_QUEUE_SEND */
+        1U, /* recorderEVENT_QUEUE_SEND_FAILED */
+        1U, /* recorderEVENT_QUEUE_RECEIVE */
+        1U, /* recorderEVENT_QUEUE_RECEIVE_FAILED */
+        1U, /* recorderEVENT_QUEUE_SEND_FROM_ISR */
+        1U, /* recorderEVENT_QUEUE_RECEIVE_FROM_ISR */
+        2U, /* recorderEVENT_QUEUE_CREATE */
+        3U, /* recorderEVENT_TASK_CREATE */
+        1U, /* recorderEVENT_TASK_DELETE */
+        2U, /* recorderEVENT_DEADLINE_MISSED */
+        1U, /* recorderEVENT_ISR_ENTER */
+        0U, /* recorderEVENT_ISR_EXIT */
+        1U  /* recorderEVENT_DROPPED */
+    };
+
+/* Recording starts at reset so the tasks and queues created before the
+ * scheduler starts are in the trace. */
+    PRIVILEGED_DATA TraceRecorderBuffer_t xTraceRecorderBuffer = { 0U, 0U, 0U, 0U, 0U, 0U, 0U, ( uint32_t ) pdTRUE, { 0U } };
+
+/* The trace number given to the last queue created. */
+    PRIVILEGED_DATA static UBaseType_t uxLastQueueNumber = 0U;
+
+/*
+ * Write ulValue as an unsigned LEB128 varint at pucBuffer, returning the
+ * number of bytes written, from 1 to 5.
+ */
+    static size_t prvEncodeVarint( uint8_t * pucBuffer,
+                                   uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the oldest record from the buffer, moving ulTailTimestamp on to the
+ * time of the record removed.  Snapshot mode only.
+ */
+    #if ( configTRACE_RECORDER_MODE == tskTRACE_SNAPSHOT )
+        static void prvDropOldestRecord( void ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Copy a record of xLength bytes into the buffer, making room for it first in
+ * snapshot mode.  Returns pdFAIL if there is no room in stream mode.
+ */
+    static BaseType_t prvWriteRecord( const uint8_t * pucRecord,
+                                      size_t xLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * Encode and write a record of ucEvent, first writing the ticks counted and,
+ * in stream mode, the number of records lost since the last record.  Called
+ * with interrupts masked.
+ */
+    static void prvRecord( uint8_t ucEvent,
+                           const uint32_t * pulParameters,
+                           const char * pcName ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static size_t prvEncodeVarint( uint8_t * pucBuffer,
+                                   uint32_t ulValue )
+    {
+        size_t xLength = 0;
+
+        while( ulValue >= 0x80UL )
+        {
+            pucBuffer[ xLength ] = ( uint8_t ) ( ( ulValue & 0x7FUL ) | 0x80UL );
+            ulValue >>= 7;
+            xLength++;
+        }
+
+        pucBuffer[ xLength ] = ( uint8_t ) ulValue;
+
+        return xLength + 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configTRACE_RECORDER_MODE == tskTRACE_SNAPSHOT )
+
+        static void prvDropOldestRecord( void )
+        {
+            uint32_t ulIndex = xTraceRecorderBuffer.ulTail;
+            uint32_t ulLength = 0UL, ulValue = 0UL, ulShift, ulFields;
+            uint8_t ucByte, ucEvent;
+
+            ucEvent = xTraceRecorderBuffer.ucData[ ulIndex ];
+            configASSERT( ucEvent < recorderNUMBER_OF_EVENTS );
+
+            /* Skip the event byte, then the time and the parameters, keeping the
+             * value of the last varint read. */
+            for( ulFields = 0UL; ulFields <= ( uint32_t ) ucParameterCount[ ucEvent ]; ulFields++ )
+            {
+                ulValue = 0UL;
+                ulShift = 0UL;
+
+                do
+                {
+                    ulLength++;
+                    ulIndex = ( ulIndex + 1UL ) % ( uint32_t ) configTRACE_RECORDER_BUFFER_SIZE;
+                    ucByte = xTraceRecorderBuffer.ucData[ ulIndex ];
+                    ulValue |= ( uint32_t ) ( ucByte & 0x7FU ) << ulShift;
+                    ulShift += 7UL;
+                } while( ( ucByte & 0x80U ) != 0U );
+
+                if( ulFields == 0UL )
+                {
+                    xTraceRecorderBuffer.ulTailTimestamp += ulValue;
+                }
+            }
+
+            /* The name of a task follows its length. */
+            if( ucEvent == recorderEVENT_TASK_CREATE )
+            {
+                ulLength += ulValue;
+            }
+
+            ulLength++;
+            xTraceRecorderBuffer.ulTail = ( xTraceRecorderBuffer.ulTail + ulLength ) % ( uint32_t ) configTRACE_RECORDER_BUFFER_SIZE;
+            xTraceRecorderBuffer.ulUsed -= ulLength;
+        }
+
+    #endif /* configTRACE_RECORDER_MODE */
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvWriteRecord( const uint8_t * pucRecord,
+                                      size_t xLength )
+    {
+        BaseType_t xReturn = pdPASS;
+        uint32_t ulFirst;
+
+        #if ( configTRACE_RECORDER_MODE == tskTRACE_SNAPSHOT )
+            {
+                /* A record is at least two bytes long, so this loop runs at
+                 * most recorderMAX_RECORD_LENGTH / 2 times. */
+                while( ( ( uint32_t ) configTRACE_RECORDER_BUFFER_SIZE - xTraceRecorderBuffer.ulUsed ) < ( uint32_t ) xLength )
+                {
+                    prvDropOldestRecord();
+                }
+            }
+        #else
+            {
+                if( ( ( uint32_t ) configTRACE_RECORDER_BUFFER_SIZE - xTraceRecorderBuffer.ulUsed ) < ( uint32_t ) xLength )
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+        #endif /* configTRACE_RECORDER_MODE */
+
+        if( xReturn == pdPASS )
+        {
+            /* Copy in at most two parts, either side of the end of the buffer. */
+            ulFirst = ( uint32_t ) configTRACE_RECORDER_BUFFER_SIZE - xTraceRecorderBuffer.ulHead;
+
+            if( ulFirst >= ( uint32_t ) xLength )
+            {
+                ( void ) memcpy( &( xTraceRecorderBuffer.ucData[ xTraceRecorderBuffer.ulHead ] ), pucRecord, xLength );
+            }
+            else
+            {
+                ( void ) memcpy( &( xTraceRecorderBuffer.ucData[ xTraceRecorderBuffer.ulHead ] ), pucRecord, ( size_t ) ulFirst );
+                ( void ) memcpy( &( xTraceRecorderBuffer.ucData[ 0 ] ), &( pucRecord[ ulFirst ] ), xLength - ( size_t ) ulFirst );
+            }
+
+            xTraceRecorderBuffer.ulHead = ( xTraceRecorderBuffer.ulHead + ( uint32_t ) xLength ) % ( uint32_t ) configTRACE_RECORDER_BUFFER_SIZE;
+            xTraceRecorderBuffer.ulUsed += ( uint32_t ) xLength;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecord( uint8_t ucEvent,
+                           const uint32_t * pulParameters,
+                           const char * pcName )
+    {
+        uint8_t ucRecord[ recorderMAX_RECORD_LENGTH ];
+        uint32_t ulNow, ulDelta;
+        size_t xLength;
+        UBaseType_t uxParameter;
+        BaseType_t xWritten = pdPASS;
+
+        if( xTraceRecorderBuffer.ulRunning != ( uint32_t ) pdFALSE )
+        {
+            ulNow = configTRACE_RECORDER_TIMESTAMP();
+            ulDelta = ulNow - xTraceRecorderBuffer.ulLastTimestamp;
+
+            /* The ticks counted since the last record go first, with the time
+             * of this record.  If they cannot be written in stream mode they
+             * stay counted, and this record is dropped so the records that are
+             * kept stay in order. */
+            if( xTraceRecorderBuffer.ulPendingTicks != 0UL )
+            {
+                ucRecord[ 0 ] = recorderEVENT_TICKS;
+                xLength = 1U + prvEncodeVarint( &( ucRecord[ 1 ] ), ulDelta );
+                xLength += prvEncodeVarint( &( ucRecord[ xLength ] ), xTraceRecorderBuffer.ulPendingTicks );
+                xWritten = prvWriteRecord( ucRecord, xLength );
+
+                if( xWritten == pdPASS )
+                {
+                    xTraceRecorderBuffer.ulPendingTicks = 0UL;
+                    xTraceRecorderBuffer.ulLastTimestamp = ulNow;
+                    ulDelta = 0UL;
+                }
+            }
+
+            #if ( configTRACE_RECORDER_MODE == tskTRACE_STREAM )
+                {
+                    if( ( xWritten == pdPASS ) && ( xTraceRecorderBuffer.ulDropped != 0UL ) )
+                    {
+                        ucRecord[ 0 ] = recorderEVENT_DROPPED;
+                        xLength = 1U + prvEncodeVarint( &( ucRecord[ 1 ] ), ulDelta );
+                        xLength += prvEncodeVarint( &( ucRecord[ xLength ] ), xTraceRecorderBuffer.ulDropped );
+                        xWritten = prvWriteRecord( ucRecord, xLength );
+
+                        if( xWritten == pdPASS )
+                        {
+                            xTraceRecorderBuffer.ulDropped = 0UL;
+                            xTraceRecorderBuffer.ulLastTimestamp = ulNow;
+                            ulDelta = 0UL;
+                        }
+                    }
+                }
+            #endif /* configTRACE_RECORDER_MODE */
+
+            if( xWritten == pdPASS )
+            {
+                ucRecord[ 0 ] = ucEvent;
+                xLength = 1U + prvEncodeVarint( &( ucRecord[ 1 ] ), ulDelta );
+
+                for( uxParameter = 0U; uxParameter < ( UBaseType_t ) ucParameterCount[ ucEvent ]; uxParameter++ )
+                {
+                    xLength += prvEncodeVarint( &( ucRecord[ xLength ] ), pulParameters[ uxParameter ] );
+                }
+
+                /* The name follows its length, the last parameter. */
+                if( pcName != NULL )
+                {
+                    ( void ) memcpy( &( ucRecord[ xLength ] ), pcName, ( size_t ) pulParameters[ uxParameter - 1U ] );
+                    xLength += ( size_t ) pulParameters[ uxParameter - 1U ];
+                }
+
+                xWritten = prvWriteRecord( ucRecord, xLength );
+
+                if( xWritten == pdPASS )
+                {
+                    xTraceRecorderBuffer.ulLastTimestamp = ulNow;
+                }
+            }
+
+            if( xWritten != pdPASS )
+            {
+                xTraceRecorderBuffer.ulDropped++;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderEvent( uint8_t ucEvent,
+                              uint32_t ulParameter1,
+                              uint32_t ulParameter2 )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulParameters[ 2 ];
+
+        configASSERT( ucEvent < recorderNUMBER_OF_EVENTS );
+        configASSERT( ucEvent != recorderEVENT_TASK_CREATE );
+
+        ulParameters[ 0 ] = ulParameter1;
+        ulParameters[ 1 ] = ulParameter2;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvRecord( ucEvent, ulParameters, NULL );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderTaskCreate( uint32_t ulTask,
+                                   uint32_t ulPriority,
+                                   const char * pcName )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulParameters[ 3 ];
+        uint32_t ulNameLength = 0UL;
+
+        /* pcTaskName is not terminated if the name filled it. */
+        while( ( ulNameLength < ( uint32_t ) configMAX_TASK_NAME_LEN ) && ( pcName[ ulNameLength ] != ( char ) 0x00 ) )
+        {
+            ulNameLength++;
+        }
+
+        ulParameters[ 0 ] = ulTask;
+        ulParameters[ 1 ] = ulPriority;
+        ulParameters[ 2 ] = ulNameLength;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvRecord( recorderEVENT_TASK_CREATE, ulParameters, pcName );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTraceRecorderNextQueueNumber( void )
+    {
+        UBaseType_t uxSavedInterruptStatus, uxReturn;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            uxLastQueueNumber++;
+            uxReturn = uxLastQueueNumber;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderISREnter( uint8_t ucISR )
+    {
+        vTraceRecorderEvent( recorderEVENT_ISR_ENTER, ( uint32_t ) ucISR, 0UL );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderISRExit( void )
+    {
+        vTraceRecorderEvent( recorderEVENT_ISR_EXIT, 0UL, 0UL );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStart( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xTraceRecorderBuffer.ulHead = 0UL;
+            xTraceRecorderBuffer.ulTail = 0UL;
+            xTraceRecorderBuffer.ulUsed = 0UL;
+            xTraceRecorderBuffer.ulTailTimestamp = configTRACE_RECORDER_TIMESTAMP();
+            xTraceRecorderBuffer.ulLastTimestamp = xTraceRecorderBuffer.ulTailTimestamp;
+            xTraceRecorderBuffer.ulPendingTicks = 0UL;
+            xTraceRecorderBuffer.ulDropped = 0UL;
+            xTraceRecorderBuffer.ulRunning = ( uint32_t ) pdTRUE;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStop( void )
+    {
+        xTraceRecorderBuffer.ulRunning = ( uint32_t ) pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configTRACE_RECORDER_MODE == tskTRACE_STREAM )
+
+        size_t xTraceRecorderRead( uint8_t * pucBuffer,
+                                   size_t xLength )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+            size_t xCopied = 0, xChunk;
+
+            /* Interrupts are masked for one record's worth of bytes at a time,
+             * so a long read does not hold them off for longer than an event. */
+            do
+            {
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+                {
+                    xChunk = 0;
+
+                    while( ( xChunk < ( size_t ) recorderMAX_RECORD_LENGTH ) && ( xCopied < xLength ) && ( xTraceRecorderBuffer.ulUsed != 0UL ) )
+                    {
+                        pucBuffer[ xCopied ] = xTraceRecorderBuffer.ucData[ xTraceRecorderBuffer.ulTail ];
+                        xTraceRecorderBuffer.ulTail = ( xTraceRecorderBuffer.ulTail + 1UL ) % ( uint32_t ) configTRACE_RECORDER_BUFFER_SIZE;
+                        xTraceRecorderBuffer.ulUsed--;
+                        xCopied++;
+                        xChunk++;
+                    }
+                }
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            } while( xChunk == ( size_t ) recorderMAX_RECORD_LENGTH );
+
+            return xCopied;
+        }
+
+    #endif /* configTRACE_RECORDER_MODE */
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TRACE_RECORDER */
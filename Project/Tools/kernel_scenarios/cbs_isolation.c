@@ -0,0 +1,240 @@
+/*
+ * cbs_isolation - checks that a constant bandwidth server cannot take more
+ * than its bandwidth from the hard periodic tasks it runs next to.
+ *
+ * Two hard periodic tasks use 30% and 45% of the processor.  A server with a
+ * budget of 5 ticks every 20 ticks, 25%, is posted a single aperiodic job
+ * from the tick hook that executes for 200 ms, forty times its budget.  The
+ * processor is then fully used, so the server has no idle time to take beyond
+ * its bandwidth.  The server must keep running the job a budget at a time,
+ * postponing its deadline each time the budget runs out, so that:
+ *
+ *  - every job of the hard tasks completes by its deadline, both as seen in
+ *    virtual time to the microsecond and as counted by the kernel,
+ *  - from the job arrival to the end of every tick the server has executed
+ *    for no more than Qs/Ts of the elapsed time plus one budget,
+ *  - the aperiodic job still completes, no earlier than its execution time
+ *    at Qs/Ts of the processor allows.
+ *
+ * Build from this directory with:
+ *
+ *     gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/VirtualTime
+ *         cbs_isolation.c ../../Source/tasks.c ../../Source/list.c ../../Source/queue.c
+ *         ../../Source/cbs.c ../../Source/portable/ThirdParty/GCC/VirtualTime/port.c
+ *         ../../Source/portable/MemMang/heap_3.c -o cbs_isolation
+ *
+ * The last line printed is the result, as key=value pairs, and the exit
+ * status is non-zero if any check failed:
+ *
+ *     result scenario=cbs_isolation hard_jobs=250 misses=0 kernel_misses=0 server_us=200000 job_done_ms=803 errors=0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cbs.h"
+
+#define scnSERVER_BUDGET        ( ( TickType_t ) 5 )
+#define scnSERVER_PERIOD        ( ( TickType_t ) 20 )
+#define scnJOB_ARRIVAL          ( ( TickType_t ) 5 )
+#define scnJOB_US               ( 200000ULL )
+#define scnDURATION_US          ( 2000000ULL )
+
+typedef struct SCN_HARD_TASK
+{
+    const char * pcName;
+    TickType_t xPeriod;     /* In ticks, the deadline is equal to the period. */
+    uint64_t ullWcet;       /* In microseconds. */
+    TaskHandle_t xHandle;
+    unsigned long ulJobs;
+    unsigned long ulMisses; /* Jobs completed after their deadline. */
+} ScnHardTask_t;
+
+static ScnHardTask_t xHardTasks[] =
+{
+    { "hard10", 10, 3000,  NULL, 0, 0 },
+    { "hard40", 40, 18000, NULL, 0, 0 }
+};
+
+#define scnHARD_TASK_COUNT    ( sizeof( xHardTasks ) / sizeof( xHardTasks[ 0 ] ) )
+
+static CBSServerHandle_t xServer = NULL;
+static uint64_t ullJobDone = 0;
+
+/* The largest amount, in microseconds, by which the server execution time
+ * from the job arrival exceeded its bandwidth, sampled on the tick. */
+static uint64_t ullMaxExcessUs = 0;
+static TickType_t xMaxExcessTick = 0;
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char * pcMessage,
+                     const char * pcDetail )
+{
+    fprintf( stderr, "cbs_isolation: %s%s\n", pcMessage, pcDetail );
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHardTask( void * pvParameters )
+{
+    ScnHardTask_t * const pxTask = ( ScnHardTask_t * ) pvParameters;
+    PeriodicJob_t xJob;
+
+    for( ; ; )
+    {
+        ( void ) xTaskWaitForNextPeriod( &xJob );
+        vPortSimulateExecution( pxTask->ullWcet );
+
+        if( ullPortGetSimulatedTime() > ( uint64_t ) xJob.xDeadline * portTICK_PERIOD_US )
+        {
+            printf( "  %s job %lu: completed at %llu us, deadline %llu us\n", pxTask->pcName,
+                    ( unsigned long ) xJob.uxJobIndex, ( unsigned long long ) ullPortGetSimulatedTime(),
+                    ( unsigned long long ) xJob.xDeadline * portTICK_PERIOD_US );
+            pxTask->ulMisses++;
+        }
+
+        pxTask->ulJobs++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvOverrunningJob( void * pvParameter )
+{
+    ( void ) pvParameter;
+
+    vPortSimulateExecution( scnJOB_US );
+    ullJobDone = ullPortGetSimulatedTime();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    PeriodicTaskParameters_t xParameters;
+    TaskStatus_t xStatus;
+    unsigned long ulHardJobs = 0, ulMisses = 0, ulKernelMisses = 0, ulErrors = 0;
+    uint64_t ullServerUs;
+    size_t x;
+
+    for( x = 0; x < scnHARD_TASK_COUNT; x++ )
+    {
+        xParameters.pvTaskCode = prvHardTask;
+        xParameters.pcName = xHardTasks[ x ].pcName;
+        xParameters.usStackDepth = configMINIMAL_STACK_SIZE * 4;
+        xParameters.pvParameters = &( xHardTasks[ x ] );
+        xParameters.uxPriority = tskIDLE_PRIORITY + 1;
+        xParameters.xPeriod = xHardTasks[ x ].xPeriod;
+        xParameters.xRelativeDeadline = xHardTasks[ x ].xPeriod;
+        xParameters.xWcet = ( TickType_t ) ( xHardTasks[ x ].ullWcet / portTICK_PERIOD_US );
+        xParameters.xReleaseOffset = 0;
+
+        if( xTaskPeriodicCreateExtended( &xParameters, &( xHardTasks[ x ].xHandle ) ) != pdPASS )
+        {
+            prvFail( "cannot create ", xHardTasks[ x ].pcName );
+        }
+    }
+
+    if( xCBSServerCreate( "server", configMINIMAL_STACK_SIZE * 4, tskIDLE_PRIORITY + 1, scnSERVER_BUDGET,
+                          scnSERVER_PERIOD, 4, &xServer ) != pdPASS )
+    {
+        prvFail( "cannot create the server", "" );
+    }
+
+    printf( "cbs_isolation: server %lu/%lu ticks, one %llu us job at tick %lu\n", ( unsigned long ) scnSERVER_BUDGET,
+            ( unsigned long ) scnSERVER_PERIOD, ( unsigned long long ) scnJOB_US, ( unsigned long ) scnJOB_ARRIVAL );
+
+    vPortSetSimulationEnd( scnDURATION_US );
+    vTaskStartScheduler();
+
+    for( x = 0; x < scnHARD_TASK_COUNT; x++ )
+    {
+        vTaskGetInfo( xHardTasks[ x ].xHandle, &xStatus, pdFALSE, eRunning );
+        printf( "  %-8s %5lu jobs %3lu misses %3lu kernel misses\n", xHardTasks[ x ].pcName, xHardTasks[ x ].ulJobs,
+                xHardTasks[ x ].ulMisses, ( unsigned long ) xStatus.uxDeadlineMisses );
+        ulHardJobs += xHardTasks[ x ].ulJobs;
+        ulMisses += xHardTasks[ x ].ulMisses;
+        ulKernelMisses += ( unsigned long ) xStatus.uxDeadlineMisses;
+    }
+
+    ulErrors += ulMisses + ulKernelMisses;
+
+    vTaskGetInfo( xCBSServerGetTaskHandle( xServer ), &xStatus, pdFALSE, eRunning );
+    ullServerUs = ( uint64_t ) xStatus.ulRunTimeCounter;
+
+    if( ullMaxExcessUs > 0 )
+    {
+        printf( "  server ran %llu us beyond its bandwidth by tick %lu\n", ( unsigned long long ) ullMaxExcessUs,
+                ( unsigned long ) xMaxExcessTick );
+        ulErrors++;
+    }
+
+    if( ullJobDone == 0 )
+    {
+        printf( "  the aperiodic job did not complete\n" );
+        ulErrors++;
+    }
+    else if( ( ullJobDone - ( uint64_t ) scnJOB_ARRIVAL * portTICK_PERIOD_US ) * scnSERVER_BUDGET <
+             ( scnJOB_US - ( uint64_t ) scnSERVER_BUDGET * portTICK_PERIOD_US ) * scnSERVER_PERIOD )
+    {
+        printf( "  the aperiodic job completed at %llu us, sooner than its bandwidth allows\n",
+                ( unsigned long long ) ullJobDone );
+        ulErrors++;
+    }
+
+    printf( "result scenario=cbs_isolation hard_jobs=%lu misses=%lu kernel_misses=%lu server_us=%llu job_done_ms=%llu errors=%lu\n",
+            ulHardJobs, ulMisses, ulKernelMisses, ( unsigned long long ) ullServerUs,
+            ( unsigned long long ) ( ullJobDone / 1000ULL ), ulErrors );
+
+    return ( ulErrors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+    const TickType_t xNow = xTaskGetTickCountFromISR();
+    TaskStatus_t xStatus;
+    uint64_t ullRunTime, ullAllowed;
+
+    if( xNow == scnJOB_ARRIVAL )
+    {
+        if( xCBSServerPostJobFromISR( xServer, prvOverrunningJob, NULL, NULL ) != pdPASS )
+        {
+            prvFail( "cannot post the job", "" );
+        }
+    }
+    else if( xNow > scnJOB_ARRIVAL )
+    {
+        /* The server only runs from the job arrival, so its run time is all
+         * spent since then.  Allow Qs/Ts of the elapsed time, and one budget
+         * for the server to run it ahead of the period it belongs to. */
+        vTaskGetInfo( xCBSServerGetTaskHandle( xServer ), &xStatus, pdFALSE, eRunning );
+        ullRunTime = ( uint64_t ) xStatus.ulRunTimeCounter;
+        ullAllowed = ( ( ( uint64_t ) ( xNow - scnJOB_ARRIVAL ) * scnSERVER_BUDGET / scnSERVER_PERIOD ) + scnSERVER_BUDGET ) * portTICK_PERIOD_US;
+
+        if( ( ullRunTime > ullAllowed ) && ( ullRunTime - ullAllowed > ullMaxExcessUs ) )
+        {
+            ullMaxExcessUs = ullRunTime - ullAllowed;
+            xMaxExcessTick = xNow;
+        }
+    }
+    else
+    {
+        /* The server has no job before the arrival. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    vPortSimulateIdle();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "cbs_isolation: assertion failed at %s:%lu, %llu us into the scenario\n", pcFile, ulLine,
+             ( unsigned long long ) ullPortGetSimulatedTime() );
+    exit( EXIT_FAILURE );
+}
@@ -0,0 +1,239 @@
+/*
+ * sporadic_queue - checks the release times the kernel gives to the queued
+ * jobs of a sporadic task.
+ *
+ * A sporadic task with a minimum inter-arrival time of 15 ticks and a relative
+ * deadline of 10 ticks is released from the tick hook, as an interrupt would
+ * release it with xTaskReleaseSporadicFromISR().  Its first job overruns to
+ * 100 ms, so the requests that arrive meanwhile queue up behind it, one more
+ * than configEDF_SPORADIC_QUEUE_LENGTH so the last is dropped.  A later pair
+ * of requests closer than the minimum inter-arrival time checks that the
+ * second is deferred.
+ *
+ * Every job must be released at the tick its request arrived, or later if the
+ * minimum inter-arrival time from the previous release requires it, and its
+ * deadline must be its release plus the relative deadline.  A job released
+ * before its request arrived would get a deadline that may already have
+ * passed.
+ *
+ * Build from this directory with:
+ *
+ *     gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/VirtualTime
+ *         sporadic_queue.c ../../Source/tasks.c ../../Source/list.c ../../Source/queue.c
+ *         ../../Source/portable/ThirdParty/GCC/VirtualTime/port.c
+ *         ../../Source/portable/MemMang/heap_3.c -o sporadic_queue
+ *
+ * The last line printed is the result, as key=value pairs, and the exit
+ * status is non-zero if any check failed:
+ *
+ *     result scenario=sporadic_queue jobs=7 errors=0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configEDF_SPORADIC_QUEUE_LENGTH != 4 )
+    #error The requests below fill a queue of 4 pending releases
+#endif
+
+#define scnMIN_INTER_ARRIVAL    ( ( TickType_t ) 15 )
+#define scnRELATIVE_DEADLINE    ( ( TickType_t ) 10 )
+#define scnFIRST_JOB_US         ( 100000ULL )
+#define scnOTHER_JOB_US         ( 1000ULL )
+#define scnDURATION_US          ( 300000ULL )
+
+typedef struct SCN_REQUEST
+{
+    TickType_t xArrival;      /* The tick at which the request is made. */
+    BaseType_t xExpected;     /* What xTaskReleaseSporadicFromISR() must return. */
+    TickType_t xRelease;      /* The release of the job it requests, 0 if it is dropped. */
+} ScnRequest_t;
+
+/* While the first job runs until tick 110 the requests at 40 to 95 fill the
+ * queue and the one at 105 is dropped.  The request at 205 comes 5 ticks after
+ * the one at 200, so its job is deferred to 215. */
+static const ScnRequest_t xRequests[] =
+{
+    { 10,  pdPASS, 10  },
+    { 40,  pdPASS, 40  },
+    { 60,  pdPASS, 60  },
+    { 80,  pdPASS, 80  },
+    { 95,  pdPASS, 95  },
+    { 105, pdFAIL, 0   },
+    { 200, pdPASS, 200 },
+    { 205, pdFAIL, 215 }
+};
+
+#define scnREQUEST_COUNT    ( sizeof( xRequests ) / sizeof( xRequests[ 0 ] ) )
+
+static TaskHandle_t xSporadicTask = NULL;
+static unsigned long ulJobs = 0;
+static unsigned long ulErrors = 0;
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char * pcMessage,
+                     const char * pcDetail )
+{
+    fprintf( stderr, "sporadic_queue: %s%s\n", pcMessage, pcDetail );
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcWhat,
+                      unsigned long ulJob,
+                      unsigned long ulGot,
+                      unsigned long ulExpected )
+{
+    printf( "  job %lu: %s is %lu, expected %lu\n", ulJob, pcWhat, ulGot, ulExpected );
+    ulErrors++;
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the request that the job with index uxJob was released for. */
+static const ScnRequest_t * prvRequestOfJob( UBaseType_t uxJob )
+{
+    size_t x;
+
+    for( x = 0; x < scnREQUEST_COUNT; x++ )
+    {
+        if( xRequests[ x ].xRelease != 0 )
+        {
+            if( uxJob == 0 )
+            {
+                return &( xRequests[ x ] );
+            }
+
+            uxJob--;
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSporadicTask( void * pvParameters )
+{
+    PeriodicJob_t xJob;
+    const ScnRequest_t * pxRequest;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xTaskWaitForNextPeriod( &xJob );
+
+        pxRequest = prvRequestOfJob( xJob.uxJobIndex );
+
+        if( pxRequest == NULL )
+        {
+            printf( "  job %lu: released without a request\n", ( unsigned long ) xJob.uxJobIndex );
+            ulErrors++;
+        }
+        else
+        {
+            printf( "  job %lu: arrival %lu release %lu deadline %lu\n", ( unsigned long ) xJob.uxJobIndex,
+                    ( unsigned long ) pxRequest->xArrival, ( unsigned long ) xJob.xReleaseTime,
+                    ( unsigned long ) xJob.xDeadline );
+
+            if( xJob.xReleaseTime != pxRequest->xRelease )
+            {
+                prvError( "release", xJob.uxJobIndex, xJob.xReleaseTime, pxRequest->xRelease );
+            }
+
+            if( xJob.xDeadline != xJob.xReleaseTime + scnRELATIVE_DEADLINE )
+            {
+                prvError( "deadline", xJob.uxJobIndex, xJob.xDeadline, xJob.xReleaseTime + scnRELATIVE_DEADLINE );
+            }
+        }
+
+        ulJobs++;
+        vPortSimulateExecution( ( xJob.uxJobIndex == 0 ) ? scnFIRST_JOB_US : scnOTHER_JOB_US );
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    TaskStatus_t xStatus;
+    unsigned long ulExpectedJobs = 0;
+    unsigned long ulExpectedViolations = 0;
+    size_t x;
+
+    if( xTaskSporadicCreate( prvSporadicTask, "sporadic", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1,
+                             &xSporadicTask, scnMIN_INTER_ARRIVAL, scnRELATIVE_DEADLINE, 1 ) != pdPASS )
+    {
+        prvFail( "cannot create the sporadic task", "" );
+    }
+
+    printf( "sporadic_queue: T=%lu D=%lu, %lu requests\n", ( unsigned long ) scnMIN_INTER_ARRIVAL,
+            ( unsigned long ) scnRELATIVE_DEADLINE, ( unsigned long ) scnREQUEST_COUNT );
+
+    vPortSetSimulationEnd( scnDURATION_US );
+    vTaskStartScheduler();
+
+    for( x = 0; x < scnREQUEST_COUNT; x++ )
+    {
+        ulExpectedJobs += ( xRequests[ x ].xRelease != 0 ) ? 1UL : 0UL;
+        ulExpectedViolations += ( xRequests[ x ].xExpected == pdFAIL ) ? 1UL : 0UL;
+    }
+
+    if( ulJobs != ulExpectedJobs )
+    {
+        printf( "  %lu jobs, expected %lu\n", ulJobs, ulExpectedJobs );
+        ulErrors++;
+    }
+
+    vTaskGetInfo( xSporadicTask, &xStatus, pdFALSE, eRunning );
+
+    if( xStatus.uxSeparationViolations != ulExpectedViolations )
+    {
+        printf( "  %lu separation violations, expected %lu\n", ( unsigned long ) xStatus.uxSeparationViolations,
+                ulExpectedViolations );
+        ulErrors++;
+    }
+
+    printf( "result scenario=sporadic_queue jobs=%lu errors=%lu\n", ulJobs, ulErrors );
+
+    return ( ulErrors == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+    const TickType_t xNow = xTaskGetTickCountFromISR();
+    BaseType_t xReturn;
+    size_t x;
+
+    for( x = 0; x < scnREQUEST_COUNT; x++ )
+    {
+        if( xRequests[ x ].xArrival == xNow )
+        {
+            xReturn = xTaskReleaseSporadicFromISR( xSporadicTask, NULL );
+
+            if( xReturn != xRequests[ x ].xExpected )
+            {
+                printf( "  request at %lu: returned %ld, expected %ld\n", ( unsigned long ) xNow, ( long ) xReturn,
+                        ( long ) xRequests[ x ].xExpected );
+                ulErrors++;
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    vPortSimulateIdle();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "sporadic_queue: assertion failed at %s:%lu, %llu us into the scenario\n", pcFile, ulLine,
+             ( unsigned long long ) ullPortGetSimulatedTime() );
+    exit( EXIT_FAILURE );
+}
@@ -0,0 +1,119 @@
+/*
+ * FreeRTOS V202112.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Configuration of the kernel simulator.
+ *
+ * The scheduling settings follow Project/ARM7_LPC2129_Keil_RVDS/FreeRTOSConfig.h
+ * so the simulated kernel makes the decisions the target makes.  Each of them
+ * can be changed from the compiler command line, for example with
+ * -DconfigUSE_EDF_SCHEDULER=0 -DconfigUSE_FP_PRIORITY_ASSIGNMENT=1
+ * -DconfigUSE_EDF_ADMISSION_CONTROL=0 -DconfigEDF_CHECK_DEADLINES_ON_TICK=0
+ * -DconfigUSE_EDF_JOB_STATISTICS=0 to simulate rate monotonic priorities.
+ *----------------------------------------------------------*/
+
+#define configUSE_PREEMPTION		1
+#define configUSE_IDLE_HOOK			1	/* The idle hook lets virtual time pass. */
+#define configUSE_TICK_HOOK			1	/* The tick hook checks the EDF order. */
+#define configCPU_CLOCK_HZ			( ( unsigned long ) 60000000 )
+#define configTICK_RATE_HZ			( ( TickType_t ) 1000 )
+#define configMAX_PRIORITIES		( 4 )
+#define configMINIMAL_STACK_SIZE	( ( unsigned short ) 1024 )
+#define configTOTAL_HEAP_SIZE		( ( size_t ) 0 )	/* Unused, heap_3 allocates from the host. */
+#define configMAX_TASK_NAME_LEN		( 16 )
+#define configUSE_TRACE_FACILITY	1
+#define configUSE_16_BIT_TICKS		0
+#define configIDLE_SHOULD_YIELD		1
+#define configUSE_TICKLESS_IDLE		1
+
+#ifndef configUSE_EDF_SCHEDULER
+	#define configUSE_EDF_SCHEDULER		1
+#endif
+
+#ifndef configUSE_FP_PRIORITY_ASSIGNMENT
+	#define configUSE_FP_PRIORITY_ASSIGNMENT	0
+#endif
+#ifndef configFP_PRIORITY_POLICY
+	#define configFP_PRIORITY_POLICY			tskPRIORITY_RATE_MONOTONIC
+#endif
+
+#ifndef configEDF_USE_READY_HEAP
+	#define configEDF_USE_READY_HEAP		0
+#endif
+#ifndef configEDF_READY_HEAP_LENGTH
+	#define configEDF_READY_HEAP_LENGTH	( 1024 )
+#endif
+
+#ifndef configEDF_CHECK_DEADLINES_ON_TICK
+	#define configEDF_CHECK_DEADLINES_ON_TICK	1
+#endif
+#define configUSE_DEADLINE_MISS_HOOK		0
+
+#ifndef configUSE_EDF_ADMISSION_CONTROL
+	#define configUSE_EDF_ADMISSION_CONTROL	1
+#endif
+
+#ifndef configUSE_EDF_JOB_STATISTICS
+	#define configUSE_EDF_JOB_STATISTICS		1
+#endif
+
+#define configQUEUE_REGISTRY_SIZE 	0
+#define configUSE_MUTEXES				1
+#define configUSE_TIMERS				0
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES 		0
+#define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet		1
+#define INCLUDE_uxTaskPriorityGet		1
+#define INCLUDE_vTaskDelete				1
+#define INCLUDE_vTaskSuspend			1
+#define INCLUDE_vTaskDelayUntil			1
+#define INCLUDE_vTaskDelay				1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+
+/* Run time status, counted in virtual microseconds by the port.  A 32 bit
+	count would wrap after 71 simulated minutes. */
+#define configGENERATE_RUN_TIME_STATS  1
+#define configRUN_TIME_COUNTER_TYPE		uint64_t
+#define configSUPPORT_DYNAMIC_ALLOCATION	1
+#define configUSE_STATS_FORMATTING_FUNCTIONS    1
+
+/* A failed assertion stops the simulation with the file and line. */
+void vAssertCalled( const char * pcFile, unsigned long ulLine );
+#define configASSERT( x )	if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,633 @@
+/*
+ * kernel_sim - runs the kernel scheduler against a SimSo task set in virtual
+ * time.
+ *
+ * The unmodified tasks.c, list.c and queue.c are linked with the virtual time
+ * port in Source/portable/ThirdParty/GCC/VirtualTime.  Each periodic task of
+ * the SimSo configuration becomes a task created with
+ * xTaskPeriodicCreateExtended(), and each of its jobs simulates its execution
+ * time with vPortSimulateExecution().  Time jumps from one tick or job
+ * completion to the next, and over whole idle times through tickless idle,
+ * so hours of schedule run in seconds.
+ *
+ * For each task the simulator reports the jobs that completed, the deadline
+ * misses it observed to the microsecond next to those the kernel counted at
+ * tick resolution, the response times, the largest lateness, and any job the
+ * kernel released at another time than offset plus a whole number of
+ * periods.  With -o every completed job is written to a CSV trace.
+ *
+ * Under EDF the simulator also checks on every tick that the running job has
+ * the earliest deadline of the jobs released before that tick, and counts the
+ * ticks on which it has not as order errors.  The schedule does not depend on
+ * the value the tick count starts from, so building with, for example,
+ * -DconfigINITIAL_TICK_COUNT=0xFFFFFF00 wraps the tick count 256 ms into the
+ * run and must give the same result.  Run it for longer than that to check
+ * that deadlines are still ordered across the wrap.
+ *
+ * Build from this directory with, for example:
+ *
+ *     gcc -O2 -I. -I../../Source/include -I../../Source/portable/ThirdParty/GCC/VirtualTime
+ *         kernel_sim.c ../../Source/tasks.c ../../Source/list.c ../../Source/queue.c
+ *         ../../Source/portable/ThirdParty/GCC/VirtualTime/port.c
+ *         ../../Source/portable/MemMang/heap_3.c -o kernel_sim
+ *
+ * Add -D options for the scheduler settings to simulate, see FreeRTOSConfig.h.
+ *
+ * Usage:
+ *
+ *     kernel_sim [-d duration_ms] [-e min_ratio] [-s seed] [-o trace.csv] Simso.xml
+ *
+ * The duration defaults to the one of the SimSo configuration.  Jobs execute
+ * for their WCET unless -e is given, in which case each execution time is
+ * drawn uniformly between min_ratio times the WCET and the WCET, from the
+ * generator seeded with -s.  Periods, deadlines and activation dates must be
+ * whole ticks, execution times are simulated to the microsecond.  Only the
+ * periodic tasks are simulated.
+ *
+ * The last line printed is the result, as key=value pairs:
+ *
+ *     result set=Simso.xml jobs=40000 misses=0 kernel_misses=0 release_errors=0 order_errors=0 refused=0
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define simSTACK_DEPTH       ( configMINIMAL_STACK_SIZE * 4 )
+#define simTASK_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+#define simMAX_NAME_LENGTH   64
+
+typedef struct SIM_TASK
+{
+    char acName[ simMAX_NAME_LENGTH ];
+    double dPeriodMs;
+    double dDeadlineMs;
+    double dWcetMs;
+    double dOffsetMs;
+    TickType_t xPeriod;             /* In ticks. */
+    TickType_t xDeadline;           /* In ticks. */
+    TickType_t xOffset;             /* In ticks. */
+    uint64_t ullWcet;               /* In microseconds. */
+    TaskHandle_t xHandle;           /* NULL if the task was refused. */
+    uint32_t ulJobs;                /* Completed jobs. */
+    uint32_t ulMisses;              /* Jobs completed after their deadline. */
+    uint32_t ulReleaseErrors;       /* Jobs released at an unexpected time. */
+    uint64_t ullMaxResponse;
+    uint64_t ullTotalResponse;
+    uint64_t ullMaxLateness;
+} SimTask_t;
+
+static SimTask_t * pxSimTasks = NULL;
+static size_t uxSimTaskCount = 0;
+static FILE * pxTraceFile = NULL;
+static double dMinimumRatio = 1.0;
+static uint64_t ullRandomState = 1;
+static uint32_t ulOrderErrors = 0;  /* Ticks on which the running job did not have the earliest deadline. */
+
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char * pcMessage,
+                     const char * pcDetail )
+{
+    fprintf( stderr, "kernel_sim: %s%s\n", pcMessage, pcDetail );
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+/* Copies the value of attribute pcKey of the element that starts at pcElement
+ * and ends at pcEnd into pcValue.  Returns pdFALSE if it is not present. */
+static BaseType_t prvAttribute( const char * pcElement,
+                                const char * pcEnd,
+                                const char * pcKey,
+                                char * pcValue,
+                                size_t uxValueLength )
+{
+    char acPattern[ 64 ];
+    const char * pcStart;
+    const char * pcValueEnd;
+    size_t uxLength;
+
+    snprintf( acPattern, sizeof( acPattern ), " %s=\"", pcKey );
+
+    pcStart = strstr( pcElement, acPattern );
+
+    if( ( pcStart == NULL ) || ( pcStart >= pcEnd ) )
+    {
+        return pdFALSE;
+    }
+
+    pcStart += strlen( acPattern );
+    pcValueEnd = strchr( pcStart, '"' );
+
+    if( ( pcValueEnd == NULL ) || ( pcValueEnd > pcEnd ) )
+    {
+        prvFail( "unterminated attribute ", pcKey );
+    }
+
+    uxLength = ( size_t ) ( pcValueEnd - pcStart );
+
+    if( uxLength >= uxValueLength )
+    {
+        uxLength = uxValueLength - 1;
+    }
+
+    memcpy( pcValue, pcStart, uxLength );
+    pcValue[ uxLength ] = '\0';
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNumber( const char * pcText,
+                         const char * pcWhat )
+{
+    char * pcEnd;
+    double dValue = strtod( pcText, &pcEnd );
+
+    if( ( *pcText == '\0' ) || ( *pcEnd != '\0' ) || !( dValue >= 0.0 ) )
+    {
+        prvFail( "bad ", pcWhat );
+    }
+
+    return dValue;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvWholeTicks( double dMs,
+                                 const char * pcWhat )
+{
+    double dTicks = dMs * ( double ) configTICK_RATE_HZ / 1000.0;
+    double dRounded = floor( dTicks + 0.5 );
+
+    if( ( fabs( dTicks - dRounded ) > 1e-6 ) || ( dRounded > ( double ) ( portMAX_DELAY / 2 ) ) )
+    {
+        prvFail( "not a whole number of ticks: ", pcWhat );
+    }
+
+    return ( TickType_t ) dRounded;
+}
+/*-----------------------------------------------------------*/
+
+/* Reads the periodic tasks and the duration, in milliseconds, of a SimSo
+ * configuration. */
+static void prvReadSimso( const char * pcPath,
+                          double * pdDurationMs )
+{
+    FILE * pxFile = fopen( pcPath, "rb" );
+    char * pcXml;
+    const char * pcElement;
+    const char * pcEnd;
+    char acValue[ simMAX_NAME_LENGTH ];
+    long lSize;
+    size_t uxCapacity = 0;
+
+    if( pxFile == NULL )
+    {
+        prvFail( "cannot open ", pcPath );
+    }
+
+    fseek( pxFile, 0, SEEK_END );
+    lSize = ftell( pxFile );
+    fseek( pxFile, 0, SEEK_SET );
+    pcXml = malloc( ( size_t ) lSize + 1 );
+
+    if( ( pcXml == NULL ) || ( fread( pcXml, 1, ( size_t ) lSize, pxFile ) != ( size_t ) lSize ) )
+    {
+        prvFail( "cannot read ", pcPath );
+    }
+
+    pcXml[ lSize ] = '\0';
+    fclose( pxFile );
+
+    pcElement = strstr( pcXml, "<simulation " );
+
+    if( pcElement != NULL )
+    {
+        char acCycles[ 32 ], acDuration[ 32 ];
+
+        pcEnd = strchr( pcElement, '>' );
+
+        if( ( pcEnd != NULL ) &&
+            ( prvAttribute( pcElement, pcEnd, "cycles_per_ms", acCycles, sizeof( acCycles ) ) != pdFALSE ) &&
+            ( prvAttribute( pcElement, pcEnd, "duration", acDuration, sizeof( acDuration ) ) != pdFALSE ) )
+        {
+            *pdDurationMs = prvNumber( acDuration, "duration" ) / prvNumber( acCycles, "cycles_per_ms" );
+        }
+    }
+
+    for( pcElement = strstr( pcXml, "<task " ); pcElement != NULL; pcElement = strstr( pcEnd, "<task " ) )
+    {
+        SimTask_t * pxTask;
+
+        pcEnd = strchr( pcElement, '>' );
+
+        if( pcEnd == NULL )
+        {
+            prvFail( "unterminated task element in ", pcPath );
+        }
+
+        if( ( prvAttribute( pcElement, pcEnd, "task_type", acValue, sizeof( acValue ) ) == pdFALSE ) || ( strcmp( acValue, "Periodic" ) != 0 ) )
+        {
+            ( void ) prvAttribute( pcElement, pcEnd, "name", acValue, sizeof( acValue ) );
+            fprintf( stderr, "kernel_sim: %s: skipping %s, it is not periodic\n", pcPath, acValue );
+            continue;
+        }
+
+        if( uxSimTaskCount == uxCapacity )
+        {
+            uxCapacity = ( uxCapacity == 0 ) ? 16 : uxCapacity * 2;
+            pxSimTasks = realloc( pxSimTasks, uxCapacity * sizeof( SimTask_t ) );
+
+            if( pxSimTasks == NULL )
+            {
+                prvFail( "out of memory", "" );
+            }
+        }
+
+        pxTask = &( pxSimTasks[ uxSimTaskCount++ ] );
+        memset( pxTask, 0, sizeof( SimTask_t ) );
+
+        ( void ) prvAttribute( pcElement, pcEnd, "name", pxTask->acName, sizeof( pxTask->acName ) );
+
+        if( prvAttribute( pcElement, pcEnd, "period", acValue, sizeof( acValue ) ) == pdFALSE )
+        {
+            prvFail( "no period for ", pxTask->acName );
+        }
+
+        pxTask->dPeriodMs = prvNumber( acValue, pxTask->acName );
+
+        if( prvAttribute( pcElement, pcEnd, "WCET", acValue, sizeof( acValue ) ) == pdFALSE )
+        {
+            prvFail( "no WCET for ", pxTask->acName );
+        }
+
+        pxTask->dWcetMs = prvNumber( acValue, pxTask->acName );
+        pxTask->dDeadlineMs = pxTask->dPeriodMs;
+
+        if( prvAttribute( pcElement, pcEnd, "deadline", acValue, sizeof( acValue ) ) != pdFALSE )
+        {
+            pxTask->dDeadlineMs = prvNumber( acValue, pxTask->acName );
+        }
+
+        if( prvAttribute( pcElement, pcEnd, "activationDate", acValue, sizeof( acValue ) ) != pdFALSE )
+        {
+            pxTask->dOffsetMs = prvNumber( acValue, pxTask->acName );
+        }
+    }
+
+    free( pcXml );
+}
+/*-----------------------------------------------------------*/
+
+/* xorshift64*, so runs with the same seed simulate the same execution
+ * times on any host. */
+static double prvRandom( void )
+{
+    ullRandomState ^= ullRandomState >> 12;
+    ullRandomState ^= ullRandomState << 25;
+    ullRandomState ^= ullRandomState >> 27;
+
+    return ( double ) ( ( ullRandomState * 2685821657736338717ULL ) >> 11 ) / 9007199254740992.0;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvExecutionTime( const SimTask_t * pxTask )
+{
+    if( dMinimumRatio >= 1.0 )
+    {
+        return pxTask->ullWcet;
+    }
+
+    return ( uint64_t ) ceil( ( double ) pxTask->ullWcet * ( dMinimumRatio + ( ( 1.0 - dMinimumRatio ) * prvRandom() ) ) );
+}
+/*-----------------------------------------------------------*/
+
+/* Converts a tick count of the kernel, which wraps, into the number of ticks
+ * since the simulation started. */
+static uint64_t prvUnwrapTicks( TickType_t xTick )
+{
+    uint64_t ullTicksNow = ullPortGetSimulatedTime() / portTICK_PERIOD_US;
+
+    return ullTicksNow - ( TickType_t ) ( xTaskGetTickCount() - xTick );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeriodicTask( void * pvParameters )
+{
+    SimTask_t * pxTask = ( SimTask_t * ) pvParameters;
+    PeriodicJob_t xJob;
+    uint64_t ullRelease, ullStart, ullCompletion, ullDeadline, ullResponse, ullLateness;
+
+    for( ; ; )
+    {
+        ( void ) xTaskWaitForNextPeriod( &xJob );
+
+        ullStart = ullPortGetSimulatedTime();
+        ullRelease = prvUnwrapTicks( xJob.xReleaseTime );
+        ullDeadline = ( ullRelease + ( TickType_t ) ( xJob.xDeadline - xJob.xReleaseTime ) ) * portTICK_PERIOD_US;
+
+        if( ullRelease != ( uint64_t ) pxTask->xOffset + ( ( uint64_t ) xJob.uxJobIndex * pxTask->xPeriod ) )
+        {
+            pxTask->ulReleaseErrors++;
+        }
+
+        ullRelease *= portTICK_PERIOD_US;
+
+        vPortSimulateExecution( prvExecutionTime( pxTask ) );
+
+        ullCompletion = ullPortGetSimulatedTime();
+        ullResponse = ullCompletion - ullRelease;
+        ullLateness = ( ullCompletion > ullDeadline ) ? ullCompletion - ullDeadline : 0;
+
+        pxTask->ulJobs++;
+        pxTask->ullTotalResponse += ullResponse;
+
+        if( ullResponse > pxTask->ullMaxResponse )
+        {
+            pxTask->ullMaxResponse = ullResponse;
+        }
+
+        if( ullLateness > 0 )
+        {
+            pxTask->ulMisses++;
+
+            if( ullLateness > pxTask->ullMaxLateness )
+            {
+                pxTask->ullMaxLateness = ullLateness;
+            }
+        }
+
+        if( pxTraceFile != NULL )
+        {
+            fprintf( pxTraceFile, "%s,%lu,%llu,%llu,%llu,%llu,%llu,%llu\n", pxTask->acName, ( unsigned long ) xJob.uxJobIndex,
+                     ( unsigned long long ) ullRelease, ( unsigned long long ) ullStart, ( unsigned long long ) ullCompletion,
+                     ( unsigned long long ) ullDeadline, ( unsigned long long ) ullResponse, ( unsigned long long ) ullLateness );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateTasks( void )
+{
+    PeriodicTaskParameters_t xParameters;
+    size_t x;
+
+    for( x = 0; x < uxSimTaskCount; x++ )
+    {
+        SimTask_t * pxTask = &( pxSimTasks[ x ] );
+
+        pxTask->xPeriod = prvWholeTicks( pxTask->dPeriodMs, pxTask->acName );
+        pxTask->xDeadline = prvWholeTicks( pxTask->dDeadlineMs, pxTask->acName );
+        pxTask->xOffset = prvWholeTicks( pxTask->dOffsetMs, pxTask->acName );
+        pxTask->ullWcet = ( uint64_t ) ceil( ( pxTask->dWcetMs * 1000.0 ) - 1e-6 );
+
+        if( ( pxTask->xPeriod == 0 ) || ( pxTask->xDeadline == 0 ) )
+        {
+            prvFail( "a period and deadline of at least one tick are needed for ", pxTask->acName );
+        }
+
+        xParameters.pvTaskCode = prvPeriodicTask;
+        xParameters.pcName = pxTask->acName;
+        xParameters.usStackDepth = simSTACK_DEPTH;
+        xParameters.pvParameters = pxTask;
+        xParameters.uxPriority = simTASK_PRIORITY;
+        xParameters.xPeriod = pxTask->xPeriod;
+        xParameters.xRelativeDeadline = pxTask->xDeadline;
+        xParameters.xWcet = ( TickType_t ) ( ( pxTask->ullWcet + portTICK_PERIOD_US - 1 ) / portTICK_PERIOD_US );
+        xParameters.xReleaseOffset = pxTask->xOffset;
+
+        if( xTaskPeriodicCreateExtended( &xParameters, &( pxTask->xHandle ) ) != pdPASS )
+        {
+            fprintf( stderr, "kernel_sim: %s was refused by the kernel\n", pxTask->acName );
+            pxTask->xHandle = NULL;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcSource,
+                       double dDurationMs,
+                       double dHostSeconds )
+{
+    TaskStatus_t * pxStatus = malloc( ( uxSimTaskCount + 2 ) * sizeof( TaskStatus_t ) );
+    UBaseType_t uxStatusCount, uxStatus;
+    unsigned long ulJobs = 0, ulMisses = 0, ulKernelMisses = 0, ulReleaseErrors = 0, ulRefused = 0;
+    size_t x;
+
+    if( pxStatus == NULL )
+    {
+        prvFail( "out of memory", "" );
+    }
+
+    uxStatusCount = uxTaskGetSystemState( pxStatus, ( UBaseType_t ) ( uxSimTaskCount + 2 ), NULL );
+
+    printf( "%s: %lu tasks, %.0f ms simulated in %.3f s\n", pcSource, ( unsigned long ) uxSimTaskCount, dDurationMs, dHostSeconds );
+    printf( "  %-16s %9s %8s %8s %10s %10s %10s %8s\n", "task", "jobs", "misses", "kernel", "max resp", "mean resp", "max late", "release" );
+
+    for( x = 0; x < uxSimTaskCount; x++ )
+    {
+        const SimTask_t * pxTask = &( pxSimTasks[ x ] );
+        unsigned long ulKernel = 0;
+
+        if( pxTask->xHandle == NULL )
+        {
+            printf( "  %-16s refused\n", pxTask->acName );
+            ulRefused++;
+            continue;
+        }
+
+        for( uxStatus = 0; uxStatus < uxStatusCount; uxStatus++ )
+        {
+            if( pxStatus[ uxStatus ].xHandle == pxTask->xHandle )
+            {
+                ulKernel = ( unsigned long ) pxStatus[ uxStatus ].uxDeadlineMisses;
+            }
+        }
+
+        printf( "  %-16s %9lu %8lu %8lu %10.3f %10.3f %10.3f %8lu\n", pxTask->acName, ( unsigned long ) pxTask->ulJobs,
+                ( unsigned long ) pxTask->ulMisses, ulKernel, ( double ) pxTask->ullMaxResponse / 1000.0,
+                ( pxTask->ulJobs > 0 ) ? ( double ) pxTask->ullTotalResponse / ( 1000.0 * pxTask->ulJobs ) : 0.0,
+                ( double ) pxTask->ullMaxLateness / 1000.0, ( unsigned long ) pxTask->ulReleaseErrors );
+
+        ulJobs += pxTask->ulJobs;
+        ulMisses += pxTask->ulMisses;
+        ulKernelMisses += ulKernel;
+        ulReleaseErrors += pxTask->ulReleaseErrors;
+    }
+
+    if( ulOrderErrors > 0 )
+    {
+        printf( "  a job ran on %lu ticks while another had an earlier deadline\n", ( unsigned long ) ulOrderErrors );
+    }
+
+    printf( "result set=%s jobs=%lu misses=%lu kernel_misses=%lu release_errors=%lu order_errors=%lu refused=%lu\n", pcSource,
+            ulJobs, ulMisses, ulKernelMisses, ulReleaseErrors, ( unsigned long ) ulOrderErrors, ulRefused );
+
+    free( pxStatus );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char * argv[] )
+{
+    const char * pcPath = NULL;
+    const char * pcSource;
+    const char * pcTracePath = NULL;
+    double dDurationMs = -1.0;
+    double dCommandLineDurationMs = -1.0;
+    clock_t xHostStart;
+    int i;
+
+    for( i = 1; i < argc; i++ )
+    {
+        if( ( strcmp( argv[ i ], "-d" ) == 0 ) || ( strcmp( argv[ i ], "-e" ) == 0 ) ||
+            ( strcmp( argv[ i ], "-s" ) == 0 ) || ( strcmp( argv[ i ], "-o" ) == 0 ) )
+        {
+            if( i + 1 == argc )
+            {
+                prvFail( "missing value after ", argv[ i ] );
+            }
+
+            switch( argv[ i ][ 1 ] )
+            {
+                case 'd':
+                    dCommandLineDurationMs = prvNumber( argv[ i + 1 ], "duration" );
+                    break;
+
+                case 'e':
+                    dMinimumRatio = prvNumber( argv[ i + 1 ], "ratio" );
+                    break;
+
+                case 's':
+                    ullRandomState = strtoull( argv[ i + 1 ], NULL, 0 ) | 1ULL;
+                    break;
+
+                default:
+                    pcTracePath = argv[ i + 1 ];
+                    break;
+            }
+
+            i++;
+        }
+        else if( ( argv[ i ][ 0 ] == '-' ) || ( pcPath != NULL ) )
+        {
+            prvFail( "usage: kernel_sim [-d duration_ms] [-e min_ratio] [-s seed] [-o trace.csv] Simso.xml", "" );
+        }
+        else
+        {
+            pcPath = argv[ i ];
+        }
+    }
+
+    if( pcPath == NULL )
+    {
+        prvFail( "no SimSo configuration given", "" );
+    }
+
+    pcSource = strrchr( pcPath, '/' );
+    pcSource = ( pcSource == NULL ) ? pcPath : pcSource + 1;
+
+    prvReadSimso( pcPath, &dDurationMs );
+
+    if( dCommandLineDurationMs >= 0.0 )
+    {
+        dDurationMs = dCommandLineDurationMs;
+    }
+
+    if( dDurationMs <= 0.0 )
+    {
+        prvFail( "no duration, give one with -d", "" );
+    }
+
+    if( pcTracePath != NULL )
+    {
+        pxTraceFile = fopen( pcTracePath, "w" );
+
+        if( pxTraceFile == NULL )
+        {
+            prvFail( "cannot create ", pcTracePath );
+        }
+
+        fprintf( pxTraceFile, "task,job,release_us,start_us,completion_us,deadline_us,response_us,lateness_us\n" );
+    }
+
+    prvCreateTasks();
+
+    vPortSetSimulationEnd( ( uint64_t ) ( dDurationMs * 1000.0 ) );
+    xHostStart = clock();
+    vTaskStartScheduler();
+
+    prvReport( pcSource, dDurationMs, ( double ) ( clock() - xHostStart ) / CLOCKS_PER_SEC );
+
+    if( pxTraceFile != NULL )
+    {
+        fclose( pxTraceFile );
+    }
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    vPortSimulateIdle();
+}
+/*-----------------------------------------------------------*/
+
+/* Checks that the running job has the earliest deadline of the jobs released
+ * before this tick.  The jobs released on this tick may not have preempted
+ * it yet.  The oldest job of each task that has not completed is the one
+ * after its completed jobs, as every job is released at offset plus a whole
+ * number of periods. */
+void vApplicationTickHook( void )
+{
+    #if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_FP_PRIORITY_ASSIGNMENT == 0 ) )
+        const uint64_t ullTicksNow = ullPortGetSimulatedTime() / portTICK_PERIOD_US;
+        const TaskHandle_t xRunning = xTaskGetCurrentTaskHandle();
+        uint64_t ullRelease, ullDeadline;
+        uint64_t ullRunningDeadline = UINT64_MAX, ullEarliestDeadline = UINT64_MAX;
+        size_t x;
+
+        for( x = 0; x < uxSimTaskCount; x++ )
+        {
+            const SimTask_t * pxTask = &( pxSimTasks[ x ] );
+
+            if( pxTask->xHandle == NULL )
+            {
+                continue;
+            }
+
+            ullRelease = ( uint64_t ) pxTask->xOffset + ( ( uint64_t ) pxTask->ulJobs * pxTask->xPeriod );
+            ullDeadline = ullRelease + pxTask->xDeadline;
+
+            if( pxTask->xHandle == xRunning )
+            {
+                ullRunningDeadline = ullDeadline;
+            }
+
+            if( ( ullRelease < ullTicksNow ) && ( ullDeadline < ullEarliestDeadline ) )
+            {
+                ullEarliestDeadline = ullDeadline;
+            }
+        }
+
+        if( ullEarliestDeadline < ullRunningDeadline )
+        {
+            ulOrderErrors++;
+        }
+    #endif /* if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_FP_PRIORITY_ASSIGNMENT == 0 ) ) */
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "kernel_sim: assertion failed at %s:%lu, %llu us into the simulation\n", pcFile, ulLine,
+             ( unsigned long long ) ullPortGetSimulatedTime() );
+    exit( EXIT_FAILURE );
+}
@@ -0,0 +1,231 @@
+/*
+ * ready_queue_bench - measures what the EDF ready queue backend costs the
+ * kernel per job as the number of Ready tasks grows.
+ *
+ * Like kernel_sim the unmodified tasks.c, list.c and queue.c are linked with
+ * the virtual time port.  A number of periodic tasks are made Ready together
+ * and kept Ready: a first task with the earliest deadline simulates a long
+ * execution, during which every other task falls behind by many jobs.  From
+ * then on each job of those tasks does nothing but complete, and as its next
+ * job is already due xTaskWaitForNextPeriod() removes the task from the head
+ * of the ready queue and reinserts it with its next deadline, which is later
+ * than that of every other Ready task.  The kernel then switches to the new
+ * head.  The host time of those jobs, divided by their number, is the cost of
+ * one job: the remove and reinsert, plus a context switch and the job
+ * accounting that do not depend on the backend.
+ *
+ * Build from this directory once for each backend, for example:
+ *
+ *     gcc -O2 -DconfigEDF_USE_READY_HEAP=1 -I. -I../../Source/include
+ *         -I../../Source/portable/ThirdParty/GCC/VirtualTime
+ *         ready_queue_bench.c ../../Source/tasks.c ../../Source/list.c ../../Source/queue.c
+ *         ../../Source/portable/ThirdParty/GCC/VirtualTime/port.c
+ *         ../../Source/portable/MemMang/heap_3.c -o ready_queue_bench_heap
+ *
+ * and with -DconfigEDF_USE_READY_HEAP=0 for the sorted list.  The number of
+ * tasks must stay below configEDF_READY_HEAP_LENGTH less the idle task.
+ *
+ * Usage:
+ *
+ *     ready_queue_bench [-j jobs] tasks
+ *
+ * The number of timed jobs defaults to 1000000.  The last line printed is the
+ * result, as key=value pairs:
+ *
+ *     result backend=heap tasks=512 jobs=1000000 ns_per_job=210.4
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchSTACK_DEPTH       ( configMINIMAL_STACK_SIZE )
+#define benchTASK_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+#define benchMAX_TASKS         ( configEDF_READY_HEAP_LENGTH - 2 )
+
+#if ( configEDF_USE_READY_HEAP == 1 )
+    #define benchBACKEND       "heap"
+#else
+    #define benchBACKEND       "list"
+#endif
+
+static unsigned long ulTaskCount = 0;
+static unsigned long ulTimedJobs = 1000000UL;
+static unsigned long ulJobs = 0;
+static struct timespec xStart;
+static struct timespec xEnd;
+/*-----------------------------------------------------------*/
+
+static void prvFail( const char * pcMessage,
+                     const char * pcDetail )
+{
+    fprintf( stderr, "ready_queue_bench: %s%s\n", pcMessage, pcDetail );
+    exit( EXIT_FAILURE );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long prvCount( const char * pcText,
+                               const char * pcWhat )
+{
+    char * pcEnd;
+    unsigned long ulValue = strtoul( pcText, &pcEnd, 10 );
+
+    if( ( *pcText == '\0' ) || ( *pcEnd != '\0' ) || ( ulValue == 0 ) )
+    {
+        prvFail( "bad ", pcWhat );
+    }
+
+    return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+/* The first job runs until every other task is behind by enough jobs for the
+ * timed run, then the task waits out a period that does not end before the
+ * benchmark does. */
+static void prvBacklogTask( void * pvParameters )
+{
+    const TickType_t xBacklog = ( TickType_t ) ( ulTimedJobs / ulTaskCount + 2 ) * ( TickType_t ) ( ulTaskCount + 1 );
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xTaskWaitForNextPeriod( NULL );
+        vPortSimulateExecution( ( uint64_t ) xBacklog * portTICK_PERIOD_US );
+        clock_gettime( CLOCK_MONOTONIC, &xStart );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvJobTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xTaskWaitForNextPeriod( NULL );
+
+        if( xStart.tv_sec != 0 )
+        {
+            ulJobs++;
+
+            if( ulJobs == ulTimedJobs )
+            {
+                clock_gettime( CLOCK_MONOTONIC, &xEnd );
+                vTaskEndScheduler();
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateTasks( void )
+{
+    PeriodicTaskParameters_t xParameters;
+    unsigned long x;
+
+    memset( &xParameters, 0, sizeof( xParameters ) );
+    xParameters.usStackDepth = benchSTACK_DEPTH;
+    xParameters.uxPriority = benchTASK_PRIORITY;
+
+    /* A deadline of one tick puts the backlog task ahead of every other. */
+    xParameters.pvTaskCode = prvBacklogTask;
+    xParameters.pcName = "backlog";
+    xParameters.xPeriod = ( TickType_t ) ( portMAX_DELAY >> 2 );
+    xParameters.xRelativeDeadline = ( TickType_t ) 1;
+
+    if( xTaskPeriodicCreateExtended( &xParameters, NULL ) != pdPASS )
+    {
+        prvFail( "cannot create the backlog task", "" );
+    }
+
+    /* Distinct relative deadlines within one period, so each task reinserted
+     * with its next deadline goes behind all the others. */
+    xParameters.pvTaskCode = prvJobTask;
+    xParameters.pcName = "job";
+    xParameters.xPeriod = ( TickType_t ) ( ulTaskCount + 1 );
+
+    for( x = 0; x < ulTaskCount; x++ )
+    {
+        xParameters.xRelativeDeadline = ( TickType_t ) ( x + 2 );
+
+        if( xTaskPeriodicCreateExtended( &xParameters, NULL ) != pdPASS )
+        {
+            prvFail( "cannot create a job task", "" );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char * argv[] )
+{
+    double dNanoseconds;
+    int i;
+
+    for( i = 1; i < argc; i++ )
+    {
+        if( ( strcmp( argv[ i ], "-j" ) == 0 ) && ( i + 1 < argc ) )
+        {
+            ulTimedJobs = prvCount( argv[ ++i ], "number of jobs" );
+        }
+        else if( ( argv[ i ][ 0 ] == '-' ) || ( ulTaskCount != 0 ) )
+        {
+            prvFail( "usage: ready_queue_bench [-j jobs] tasks", "" );
+        }
+        else
+        {
+            ulTaskCount = prvCount( argv[ i ], "number of tasks" );
+        }
+    }
+
+    if( ulTaskCount == 0 )
+    {
+        prvFail( "no number of tasks given", "" );
+    }
+
+    if( ulTaskCount > ( unsigned long ) benchMAX_TASKS )
+    {
+        prvFail( "too many tasks for configEDF_READY_HEAP_LENGTH", "" );
+    }
+
+    prvCreateTasks();
+    vTaskStartScheduler();
+
+    if( ulJobs != ulTimedJobs )
+    {
+        prvFail( "the benchmark ended early", "" );
+    }
+
+    dNanoseconds = ( ( double ) ( xEnd.tv_sec - xStart.tv_sec ) * 1e9 ) + ( double ) ( xEnd.tv_nsec - xStart.tv_nsec );
+
+    printf( "result backend=%s tasks=%lu jobs=%lu ns_per_job=%.1f\n", benchBACKEND, ulTaskCount, ulJobs,
+            dNanoseconds / ( double ) ulJobs );
+
+    return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    vPortSimulateIdle();
+}
+/*-----------------------------------------------------------*/
+
+/* kernel_sim uses the tick hook, the benchmark has nothing to check. */
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    unsigned long ulLine )
+{
+    fprintf( stderr, "ready_queue_bench: assertion failed at %s:%lu, %llu us into the simulation\n", pcFile, ulLine,
+             ( unsigned long long ) ullPortGetSimulatedTime() );
+    exit( EXIT_FAILURE );
+}
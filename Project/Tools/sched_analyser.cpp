@@ -0,0 +1,714 @@
+/*
+ * sched_analyser - offline schedulability analysis of SimSo task sets.
+ *
+ * Reads the tasks of one or more SimSo configurations, or tasks given on the
+ * command line, and for each task set reports:
+ *
+ *  - the total utilisation,
+ *  - the EDF processor demand test, run with quick processor-demand analysis
+ *    (QPA) from the end of the synchronous busy period, or of the bound
+ *    La when the utilisation is below one, whichever is shorter, and never
+ *    beyond the hyperperiod plus the longest deadline,
+ *  - response time analysis under rate monotonic and deadline monotonic
+ *    priorities, with the worst case response time and slack of each task.
+ *
+ * These are the tests applied on the target by configUSE_EDF_ADMISSION_CONTROL
+ * and eTaskTestFixedPriorityTaskSet(), run here on whole task sets.  QPA only
+ * evaluates the demand at the few deadlines it jumps to rather than at every
+ * deadline up to the hyperperiod, and the response time of each task starts
+ * from that of the task above it, so sets of thousands of tasks are analysed
+ * in well under a second.
+ *
+ * Build on the host with any C++11 compiler, for example:
+ *
+ *     g++ -std=c++11 -O2 -o sched_analyser sched_analyser.cpp
+ *
+ * Usage:
+ *
+ *     sched_analyser [-u unit_ms] [-q] [Simso.xml]... [-T name:period:wcet[:deadline]]...
+ *
+ * Times are in milliseconds, as in SimSo, and are analysed in whole units of
+ * unit_ms, 0.001 ms by default.  Periods and deadlines must be whole numbers
+ * of units, WCETs are rounded up.  Each file is analysed as its own task set,
+ * the tasks given with -T form one more set.  Only periodic tasks are
+ * analysed, as an aperiodic task has no minimum inter-arrival time to bound
+ * its demand.  -q leaves out the per task report.
+ *
+ * The last line printed for each set is its verdict, as key=value pairs:
+ *
+ *     verdict set=Simso.xml tasks=4 utilisation=0.6600 edf=pass rm=pass dm=pass
+ *
+ * The exit status is 0 if every set was analysed, whatever the verdicts.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    typedef unsigned long long Time;
+
+    /* Stands for a response time or interval too long to be represented. */
+    const Time infinite = std::numeric_limits< Time >::max();
+
+    struct Task
+    {
+        std::string name;
+        double periodMs;
+        double wcetMs;
+        double deadlineMs;
+        Time period;   /* In units. */
+        Time wcet;     /* In units. */
+        Time deadline; /* In units. */
+    };
+
+    struct TaskSet
+    {
+        std::string source;
+        std::vector< Task > tasks;
+    };
+
+    struct PriorityResult
+    {
+        bool schedulable;
+        std::vector< Time > response; /* By task index, infinite if unbounded. */
+    };
+
+    struct EdfResult
+    {
+        bool schedulable;
+        Time failedAt; /* The interval the demand exceeded, if not schedulable. */
+    };
+
+    void fail( const std::string & message )
+    {
+        std::fprintf( stderr, "sched_analyser: %s\n", message.c_str() );
+        std::exit( EXIT_FAILURE );
+    }
+
+    /* Returns the value of attribute key in the element text, or an empty
+     * string if it is not present. */
+    std::string attribute( const std::string & element,
+                           const std::string & key )
+    {
+        const std::string pattern = " " + key + "=\"";
+        const std::string::size_type start = element.find( pattern );
+
+        if( start == std::string::npos )
+        {
+            return std::string();
+        }
+
+        const std::string::size_type valueStart = start + pattern.size();
+        const std::string::size_type end = element.find( '"', valueStart );
+
+        if( end == std::string::npos )
+        {
+            fail( "unterminated attribute " + key );
+        }
+
+        return element.substr( valueStart, end - valueStart );
+    }
+
+    double number( const std::string & text,
+                   const std::string & what )
+    {
+        char * end = NULL;
+        const double value = std::strtod( text.c_str(), &end );
+
+        if( text.empty() || ( *end != '\0' ) || !( value >= 0.0 ) )
+        {
+            fail( "bad " + what + " '" + text + "'" );
+        }
+
+        return value;
+    }
+
+    void readSimso( const std::string & path,
+                    std::vector< Task > & tasks )
+    {
+        std::ifstream file( path.c_str() );
+
+        if( !file )
+        {
+            fail( "cannot open " + path );
+        }
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string xml = buffer.str();
+
+        std::string::size_type position = 0;
+
+        while( ( position = xml.find( "<task ", position ) ) != std::string::npos )
+        {
+            const std::string::size_type end = xml.find( '>', position );
+
+            if( end == std::string::npos )
+            {
+                fail( "unterminated task element in " + path );
+            }
+
+            const std::string element = xml.substr( position, end - position );
+            position = end;
+
+            const std::string name = attribute( element, "name" );
+
+            if( attribute( element, "task_type" ) != "Periodic" )
+            {
+                std::fprintf( stderr, "sched_analyser: %s: skipping %s, it is not periodic\n", path.c_str(), name.c_str() );
+                continue;
+            }
+
+            Task task;
+            task.name = name;
+            task.periodMs = number( attribute( element, "period" ), "period of " + name );
+            task.wcetMs = number( attribute( element, "WCET" ), "WCET of " + name );
+            const std::string deadline = attribute( element, "deadline" );
+            task.deadlineMs = deadline.empty() ? task.periodMs : number( deadline, "deadline of " + name );
+            tasks.push_back( task );
+        }
+    }
+
+    /* Parses name:period:wcet[:deadline]. */
+    Task parseTask( const std::string & text )
+    {
+        std::vector< std::string > fields;
+        std::string::size_type start = 0, colon;
+
+        while( ( colon = text.find( ':', start ) ) != std::string::npos )
+        {
+            fields.push_back( text.substr( start, colon - start ) );
+            start = colon + 1;
+        }
+
+        fields.push_back( text.substr( start ) );
+
+        if( ( fields.size() < 3 ) || ( fields.size() > 4 ) || fields[ 0 ].empty() )
+        {
+            fail( "bad task '" + text + "', expected name:period:wcet[:deadline]" );
+        }
+
+        Task task;
+        task.name = fields[ 0 ];
+        task.periodMs = number( fields[ 1 ], "period of " + task.name );
+        task.wcetMs = number( fields[ 2 ], "WCET of " + task.name );
+        task.deadlineMs = ( fields.size() == 4 ) ? number( fields[ 3 ], "deadline of " + task.name ) : task.periodMs;
+
+        return task;
+    }
+
+    Time wholeUnits( double ms,
+                     double unitMs,
+                     const std::string & what )
+    {
+        const double units = ms / unitMs;
+        const double rounded = std::floor( units + 0.5 );
+
+        if( ( rounded < 1.0 ) || ( std::fabs( units - rounded ) > 1e-6 * std::max( 1.0, rounded ) ) || ( rounded > 1e15 ) )
+        {
+            fail( what + " is not a whole number of units" );
+        }
+
+        return static_cast< Time >( rounded );
+    }
+
+    Time gcd( Time a,
+              Time b )
+    {
+        while( b != 0 )
+        {
+            const Time r = a % b;
+            a = b;
+            b = r;
+        }
+
+        return a;
+    }
+
+    /* a + b, or infinite if that does not fit. */
+    Time add( Time a,
+              Time b )
+    {
+        return ( a > infinite - b ) ? infinite : a + b;
+    }
+
+    /* a * b, or infinite if that does not fit. */
+    Time multiply( Time a,
+                   Time b )
+    {
+        return ( ( a != 0 ) && ( b > infinite / a ) ) ? infinite : a * b;
+    }
+
+    Time ceilDiv( Time a,
+                  Time b )
+    {
+        return ( a / b ) + ( ( a % b ) != 0 ? 1 : 0 );
+    }
+
+    double utilisation( const std::vector< Task > & tasks )
+    {
+        double total = 0.0;
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            total += static_cast< double >( tasks[ i ].wcet ) / static_cast< double >( tasks[ i ].period );
+        }
+
+        return total;
+    }
+
+    /* The execution time of the jobs of all tasks both released and due in
+     * [0, t] after a synchronous release. */
+    Time demand( const std::vector< Task > & tasks,
+                 Time t )
+    {
+        Time total = 0;
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            if( t >= tasks[ i ].deadline )
+            {
+                total = add( total, multiply( ( ( t - tasks[ i ].deadline ) / tasks[ i ].period ) + 1, tasks[ i ].wcet ) );
+            }
+        }
+
+        return total;
+    }
+
+    /* The latest absolute deadline strictly before t, 0 if there is none. */
+    Time deadlineBefore( const std::vector< Task > & tasks,
+                         Time t )
+    {
+        Time latest = 0;
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            if( t > tasks[ i ].deadline )
+            {
+                latest = std::max( latest, ( ( ( t - 1 - tasks[ i ].deadline ) / tasks[ i ].period ) * tasks[ i ].period ) + tasks[ i ].deadline );
+            }
+        }
+
+        return latest;
+    }
+
+    /* The smallest w > 0 with w equal to the work released in [0, w) by the
+     * tasks in members after a synchronous release, starting from start, or
+     * infinite if it grows past limit. */
+    Time busyPeriod( const std::vector< Task > & tasks,
+                     const std::vector< unsigned > & members,
+                     Time start,
+                     Time limit )
+    {
+        Time next = start;
+        Time current;
+
+        do
+        {
+            current = next;
+            next = 0;
+
+            for( unsigned k = 0; k < members.size(); k++ )
+            {
+                const Task & task = tasks[ members[ k ] ];
+                next = add( next, multiply( ceilDiv( current, task.period ), task.wcet ) );
+            }
+
+            if( next > limit )
+            {
+                return infinite;
+            }
+        } while( next != current );
+
+        return current;
+    }
+
+    EdfResult analyseEdf( const std::vector< Task > & tasks,
+                          double totalUtilisation,
+                          Time hyperperiod )
+    {
+        EdfResult result = { true, 0 };
+        Time minimumDeadline = infinite, maximumDeadline = 0, totalWcet = 0;
+        bool implicitDeadlines = true;
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            minimumDeadline = std::min( minimumDeadline, tasks[ i ].deadline );
+            maximumDeadline = std::max( maximumDeadline, tasks[ i ].deadline );
+            totalWcet = add( totalWcet, tasks[ i ].wcet );
+            implicitDeadlines = implicitDeadlines && ( tasks[ i ].deadline >= tasks[ i ].period );
+
+            if( tasks[ i ].wcet > tasks[ i ].deadline )
+            {
+                result.schedulable = false;
+                result.failedAt = tasks[ i ].deadline;
+                return result;
+            }
+        }
+
+        if( totalUtilisation > 1.0 + 1e-12 )
+        {
+            result.schedulable = false;
+            result.failedAt = infinite;
+            return result;
+        }
+
+        /* With deadlines no shorter than the periods a utilisation of at most
+         * one is both necessary and sufficient. */
+        if( implicitDeadlines )
+        {
+            return result;
+        }
+
+        /* The demand can only exceed the interval before the end of the
+         * first idle time, and when the utilisation is below one before La. */
+        Time limit = add( hyperperiod, maximumDeadline );
+
+        if( totalUtilisation < 1.0 - 1e-12 )
+        {
+            double la = 0.0;
+
+            for( unsigned i = 0; i < tasks.size(); i++ )
+            {
+                if( tasks[ i ].period > tasks[ i ].deadline )
+                {
+                    la += static_cast< double >( tasks[ i ].period - tasks[ i ].deadline ) * static_cast< double >( tasks[ i ].wcet ) / static_cast< double >( tasks[ i ].period );
+                }
+            }
+
+            la = std::ceil( la / ( 1.0 - totalUtilisation ) );
+
+            if( la < 1e18 )
+            {
+                limit = std::min( limit, std::max( maximumDeadline, static_cast< Time >( la ) ) );
+            }
+        }
+
+        std::vector< unsigned > all( tasks.size() );
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            all[ i ] = i;
+        }
+
+        const Time busy = busyPeriod( tasks, all, totalWcet, limit );
+        limit = std::min( limit, busy );
+
+        if( limit == infinite )
+        {
+            fail( "cannot bound the processor demand test" );
+        }
+
+        /* QPA: from the last deadline within the limit, jump straight to the
+         * demand at t while it is below t, which skips every deadline in
+         * between as none of them can fail. */
+        Time t = deadlineBefore( tasks, add( limit, 1 ) );
+        Time h = demand( tasks, t );
+
+        while( ( h <= t ) && ( h > minimumDeadline ) )
+        {
+            t = ( h < t ) ? h : deadlineBefore( tasks, t );
+            h = demand( tasks, t );
+        }
+
+        if( h > t )
+        {
+            result.schedulable = false;
+            result.failedAt = t;
+        }
+
+        return result;
+    }
+
+    /* Response time analysis with priorities given by order, highest first.
+     * A task whose deadline is longer than its period is analysed over every
+     * job of its level-i busy period. */
+    PriorityResult analysePriorities( const std::vector< Task > & tasks,
+                                      const std::vector< unsigned > & order )
+    {
+        PriorityResult result;
+        std::vector< unsigned > higher;
+        Time previousFirstResponse = 0;
+
+        result.schedulable = true;
+        result.response.assign( tasks.size(), infinite );
+
+        for( unsigned position = 0; position < order.size(); position++ )
+        {
+            const unsigned index = order[ position ];
+            const Task & task = tasks[ index ];
+            Time worst = 0;
+
+            /* The first job cannot complete before the task above it plus
+             * its own execution time, which saves most of the iterations. */
+            Time next = std::max( task.wcet, add( previousFirstResponse, task.wcet ) );
+            Time response;
+            const Time firstLimit = ( task.deadline <= task.period ) ? task.deadline : infinite - 1;
+
+            do
+            {
+                response = next;
+                next = task.wcet;
+
+                for( unsigned k = 0; k < higher.size(); k++ )
+                {
+                    next = add( next, multiply( ceilDiv( response, tasks[ higher[ k ] ].period ), tasks[ higher[ k ] ].wcet ) );
+                }
+            } while( ( next != response ) && ( next <= firstLimit ) );
+
+            previousFirstResponse = next;
+            worst = next;
+
+            if( ( task.deadline > task.period ) && ( worst <= task.deadline ) )
+            {
+                std::vector< unsigned > level( higher );
+                level.push_back( index );
+
+                const Time busy = busyPeriod( tasks, level, task.wcet, add( task.deadline, multiply( task.period, 1000000 ) ) );
+
+                if( busy == infinite )
+                {
+                    worst = infinite;
+                }
+                else
+                {
+                    Time completion = next;
+
+                    for( Time job = 1; multiply( job, task.period ) < busy; job++ )
+                    {
+                        Time nextCompletion = std::max( add( completion, task.wcet ), multiply( job + 1, task.wcet ) );
+
+                        do
+                        {
+                            completion = nextCompletion;
+                            nextCompletion = multiply( job + 1, task.wcet );
+
+                            for( unsigned k = 0; k < higher.size(); k++ )
+                            {
+                                nextCompletion = add( nextCompletion, multiply( ceilDiv( completion, tasks[ higher[ k ] ].period ), tasks[ higher[ k ] ].wcet ) );
+                            }
+                        } while( ( nextCompletion != completion ) && ( nextCompletion - job * task.period <= task.deadline ) );
+
+                        worst = std::max( worst, nextCompletion - job * task.period );
+
+                        if( worst > task.deadline )
+                        {
+                            break;
+                        }
+                    }
+                }
+            }
+
+            if( worst > task.deadline )
+            {
+                result.schedulable = false;
+
+                /* The iteration stopped as soon as the deadline was passed,
+                 * so the response time is only known to exceed it. */
+                worst = infinite;
+            }
+
+            result.response[ index ] = worst;
+            higher.push_back( index );
+        }
+
+        return result;
+    }
+
+    /* Priority order by the given key, ties going to the task listed first. */
+    std::vector< unsigned > priorityOrder( const std::vector< Task > & tasks,
+                                           bool byDeadline )
+    {
+        std::vector< unsigned > order( tasks.size() );
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            order[ i ] = i;
+        }
+
+        std::stable_sort( order.begin(), order.end(), [ &tasks, byDeadline ]( unsigned a, unsigned b )
+                          {
+                              return byDeadline ? ( tasks[ a ].deadline < tasks[ b ].deadline ) : ( tasks[ a ].period < tasks[ b ].period );
+                          } );
+
+        return order;
+    }
+
+    std::string formatTime( Time units,
+                            double unitMs )
+    {
+        if( units == infinite )
+        {
+            return "-";
+        }
+
+        std::ostringstream text;
+        text << static_cast< double >( units ) * unitMs;
+        return text.str();
+    }
+
+    std::string formatSlack( const Task & task,
+                             Time response,
+                             double unitMs )
+    {
+        if( response == infinite )
+        {
+            return "miss";
+        }
+
+        return formatTime( task.deadline - response, unitMs );
+    }
+
+    void analyse( TaskSet & set,
+                  double unitMs,
+                  bool quiet )
+    {
+        if( set.tasks.empty() )
+        {
+            std::printf( "verdict set=%s tasks=0 utilisation=0.0000 edf=pass rm=pass dm=pass\n", set.source.c_str() );
+            return;
+        }
+
+        Time hyperperiod = 1;
+
+        for( unsigned i = 0; i < set.tasks.size(); i++ )
+        {
+            Task & task = set.tasks[ i ];
+            task.period = wholeUnits( task.periodMs, unitMs, set.source + ": the period of " + task.name );
+            task.deadline = wholeUnits( task.deadlineMs, unitMs, set.source + ": the deadline of " + task.name );
+            task.wcet = static_cast< Time >( std::ceil( task.wcetMs / unitMs - 1e-9 ) );
+
+            if( task.wcet == 0 )
+            {
+                fail( set.source + ": task " + task.name + " has no execution time" );
+            }
+
+            /* Past the range of a Time the hyperperiod no longer bounds the
+             * demand test, which then relies on the busy period alone. */
+            if( hyperperiod != infinite )
+            {
+                hyperperiod = multiply( hyperperiod / gcd( hyperperiod, task.period ), task.period );
+            }
+        }
+
+        const double totalUtilisation = utilisation( set.tasks );
+        const EdfResult edf = analyseEdf( set.tasks, totalUtilisation, hyperperiod );
+        const PriorityResult rm = analysePriorities( set.tasks, priorityOrder( set.tasks, false ) );
+        const PriorityResult dm = analysePriorities( set.tasks, priorityOrder( set.tasks, true ) );
+
+        if( !quiet )
+        {
+            std::printf( "%s: %u tasks, utilisation %.4f, hyperperiod %s ms\n", set.source.c_str(),
+                         static_cast< unsigned >( set.tasks.size() ), totalUtilisation, formatTime( hyperperiod, unitMs ).c_str() );
+            std::printf( "  %-16s %10s %10s %10s %8s %10s %10s %10s %10s\n", "task", "period", "deadline", "wcet", "util",
+                         "R(RM)", "slack(RM)", "R(DM)", "slack(DM)" );
+
+            for( unsigned i = 0; i < set.tasks.size(); i++ )
+            {
+                const Task & task = set.tasks[ i ];
+                std::printf( "  %-16s %10s %10s %10s %8.4f %10s %10s %10s %10s\n", task.name.c_str(),
+                             formatTime( task.period, unitMs ).c_str(), formatTime( task.deadline, unitMs ).c_str(),
+                             formatTime( task.wcet, unitMs ).c_str(),
+                             static_cast< double >( task.wcet ) / static_cast< double >( task.period ),
+                             formatTime( rm.response[ i ], unitMs ).c_str(), formatSlack( task, rm.response[ i ], unitMs ).c_str(),
+                             formatTime( dm.response[ i ], unitMs ).c_str(), formatSlack( task, dm.response[ i ], unitMs ).c_str() );
+            }
+
+            if( edf.schedulable )
+            {
+                std::printf( "  EDF: schedulable, %.4f of the processor is left\n", 1.0 - totalUtilisation );
+            }
+            else if( edf.failedAt == infinite )
+            {
+                std::printf( "  EDF: not schedulable, the utilisation exceeds 1\n" );
+            }
+            else
+            {
+                std::printf( "  EDF: not schedulable, the demand exceeds the interval at %s ms\n", formatTime( edf.failedAt, unitMs ).c_str() );
+            }
+        }
+
+        std::printf( "verdict set=%s tasks=%u utilisation=%.4f edf=%s rm=%s dm=%s\n", set.source.c_str(),
+                     static_cast< unsigned >( set.tasks.size() ), totalUtilisation,
+                     edf.schedulable ? "pass" : "fail", rm.schedulable ? "pass" : "fail", dm.schedulable ? "pass" : "fail" );
+    }
+}
+
+int main( int argc,
+          char * argv[] )
+{
+    std::vector< TaskSet > sets;
+    TaskSet commandLine;
+    double unitMs = 0.001;
+    bool quiet = false;
+
+    commandLine.source = "command-line";
+
+    for( int i = 1; i < argc; i++ )
+    {
+        const std::string argument = argv[ i ];
+
+        if( ( argument == "-u" ) || ( argument == "-T" ) )
+        {
+            if( ++i == argc )
+            {
+                fail( "missing value after " + argument );
+            }
+
+            if( argument == "-u" )
+            {
+                unitMs = number( argv[ i ], "unit" );
+
+                if( unitMs <= 0.0 )
+                {
+                    fail( "the unit must be above 0" );
+                }
+            }
+            else
+            {
+                commandLine.tasks.push_back( parseTask( argv[ i ] ) );
+            }
+        }
+        else if( argument == "-q" )
+        {
+            quiet = true;
+        }
+        else if( !argument.empty() && ( argument[ 0 ] == '-' ) )
+        {
+            fail( "usage: sched_analyser [-u unit_ms] [-q] [Simso.xml]... [-T name:period:wcet[:deadline]]..." );
+        }
+        else
+        {
+            TaskSet set;
+            const std::string::size_type slash = argument.find_last_of( "/\\" );
+            set.source = ( slash == std::string::npos ) ? argument : argument.substr( slash + 1 );
+            readSimso( argument, set.tasks );
+            sets.push_back( set );
+        }
+    }
+
+    if( !commandLine.tasks.empty() )
+    {
+        sets.push_back( commandLine );
+    }
+
+    if( sets.empty() )
+    {
+        fail( "no task sets given" );
+    }
+
+    for( unsigned i = 0; i < sets.size(); i++ )
+    {
+        analyse( sets[ i ], unitMs, quiet );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,362 @@
+/*
+ * trace_decode - prints the records of the kernel trace recorder as text.
+ *
+ * The trace recorder (configUSE_TRACE_RECORDER, see trace_recorder.h) writes
+ * each kernel event as an event byte followed by LEB128 varints: the time
+ * since the previous record, then the parameters of the event.  This tool
+ * reads them back from either of:
+ *
+ *  - a memory dump of xTraceRecorderBuffer, saved by the debugger after
+ *    vTraceRecorderStop(), for snapshot mode.  The dump is the header of
+ *    eight little endian 32 bit words followed by the buffer, whose size is
+ *    taken from the size of the file,
+ *  - with -s, the bytes returned by xTraceRecorderRead() in stream mode,
+ *    written one after the other to a file.
+ *
+ * Each record is printed on one line with its time in counts of
+ * configTRACE_RECORDER_TIMESTAMP() from the start of the trace, the tick
+ * count from the start of the trace, the event and its parameters.  Tasks are
+ * shown with their names once their creation is in the trace.  With -u the
+ * times are printed in microseconds instead, given the microseconds per count.
+ *
+ * Build on the host with any C++11 compiler, for example:
+ *
+ *     g++ -std=c++11 -O2 -o trace_decode trace_decode.cpp
+ *
+ * Usage:
+ *
+ *     trace_decode [-s] [-u us_per_count] [-q] trace.bin
+ *
+ * The last line printed is a summary, as key=value pairs, which -q prints
+ * on its own:
+ *
+ *     summary records=1024 bytes=3890 bytes_per_record=3.80 span=99990500 ticks=99990 dropped=0
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    /* The events as numbered in trace_recorder.h, with the names of their
+     * parameters.  A parameter named "task" or "queue" is shown by name. */
+    struct Event
+    {
+        const char * name;
+        unsigned parameters;
+        const char * parameterNames[ 3 ];
+    };
+
+    const Event events[] =
+    {
+        { "TICKS",              1, { "ticks" } },
+        { "TASK_SWITCHED_IN",   1, { "task" } },
+        { "TASK_READY",         1, { "task" } },
+        { "TASK_DELAY",         1, { "ticks" } },
+        { "BLOCK_ON_SEND",      1, { "queue" } },
+        { "BLOCK_ON_RECEIVE",   1, { "queue" } },
+        { "QUEUE_SEND",         1, { "queue" } },
+        { "QUEUE_SEND_FAILED",  1, { "queue" } },
+        { "QUEUE_RECEIVE",      1, { "queue" } },
+        { "QUEUE_RECEIVE_FAILED", 1, { "queue" } },
+        { "QUEUE_SEND_FROM_ISR", 1, { "queue" } },
+        { "QUEUE_RECEIVE_FROM_ISR", 1, { "queue" } },
+        { "QUEUE_CREATE",       2, { "queue", "type" } },
+        { "TASK_CREATE",        3, { "task", "priority", "name" } },
+        { "TASK_DELETE",        1, { "task" } },
+        { "DEADLINE_MISSED",    2, { "task", "lateness" } },
+        { "ISR_ENTER",          1, { "isr" } },
+        { "ISR_EXIT",           0, { 0 } },
+        { "DROPPED",            1, { "records" } }
+    };
+
+    const unsigned eventTicks = 0;
+    const unsigned eventTaskCreate = 13;
+    const unsigned eventDropped = 18;
+    const unsigned numberOfEvents = sizeof( events ) / sizeof( events[ 0 ] );
+
+    /* The size of the header of xTraceRecorderBuffer before ucData. */
+    const std::size_t headerSize = 8 * 4;
+
+    void fail( const std::string & message )
+    {
+        std::fprintf( stderr, "trace_decode: %s\n", message.c_str() );
+        std::exit( EXIT_FAILURE );
+    }
+
+    double number( const std::string & text,
+                   const std::string & what )
+    {
+        char * end;
+        const double value = std::strtod( text.c_str(), &end );
+
+        if( text.empty() || ( *end != '\0' ) )
+        {
+            fail( "bad " + what + " '" + text + "'" );
+        }
+
+        return value;
+    }
+
+    unsigned long word( const std::vector< unsigned char > & bytes,
+                        std::size_t offset )
+    {
+        return static_cast< unsigned long >( bytes[ offset ] ) |
+               ( static_cast< unsigned long >( bytes[ offset + 1 ] ) << 8 ) |
+               ( static_cast< unsigned long >( bytes[ offset + 2 ] ) << 16 ) |
+               ( static_cast< unsigned long >( bytes[ offset + 3 ] ) << 24 );
+    }
+
+    /* Reads the records in order from a run of bytes, which can wrap around
+     * the end of a ring buffer. */
+    class Reader
+    {
+        public:
+            Reader( const std::vector< unsigned char > & bytes,
+                    std::size_t start,
+                    std::size_t length,
+                    std::size_t ringSize ) :
+                bytes( bytes ), start( start ), length( length ), ringSize( ringSize ), position( 0 )
+            {
+            }
+
+            bool atEnd() const
+            {
+                return position >= length;
+            }
+
+            std::size_t consumed() const
+            {
+                return position;
+            }
+
+            unsigned char byte()
+            {
+                if( atEnd() )
+                {
+                    fail( "the trace ends part way through a record" );
+                }
+
+                return bytes[ ( start + position++ ) % ringSize ];
+            }
+
+            unsigned long varint()
+            {
+                unsigned long value = 0;
+                unsigned shift = 0;
+                unsigned char next;
+
+                do
+                {
+                    next = byte();
+
+                    if( shift < 32 )
+                    {
+                        value |= static_cast< unsigned long >( next & 0x7f ) << shift;
+                    }
+
+                    shift += 7;
+                } while( ( next & 0x80 ) != 0 );
+
+                return value & 0xffffffffUL;
+            }
+
+        private:
+            const std::vector< unsigned char > & bytes;
+            std::size_t start;
+            std::size_t length;
+            std::size_t ringSize;
+            std::size_t position;
+    };
+
+    std::string formatTime( unsigned long long counts,
+                            double usPerCount )
+    {
+        char text[ 32 ];
+
+        if( usPerCount > 0.0 )
+        {
+            std::snprintf( text, sizeof( text ), "%.1fus", static_cast< double >( counts ) * usPerCount );
+        }
+        else
+        {
+            std::snprintf( text, sizeof( text ), "%llu", counts );
+        }
+
+        return text;
+    }
+}
+
+int main( int argc,
+          char * argv[] )
+{
+    bool stream = false;
+    bool quiet = false;
+    double usPerCount = 0.0;
+    std::string path;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        const std::string argument = argv[ i ];
+
+        if( argument == "-s" )
+        {
+            stream = true;
+        }
+        else if( argument == "-q" )
+        {
+            quiet = true;
+        }
+        else if( argument == "-u" )
+        {
+            if( ++i == argc )
+            {
+                fail( "missing value after -u" );
+            }
+
+            usPerCount = number( argv[ i ], "unit" );
+
+            if( usPerCount <= 0.0 )
+            {
+                fail( "the unit must be above 0" );
+            }
+        }
+        else if( !argument.empty() && ( argument[ 0 ] != '-' ) && path.empty() )
+        {
+            path = argument;
+        }
+        else
+        {
+            fail( "usage: trace_decode [-s] [-u us_per_count] [-q] trace.bin" );
+        }
+    }
+
+    if( path.empty() )
+    {
+        fail( "no trace given" );
+    }
+
+    std::ifstream file( path.c_str(), std::ios::binary );
+
+    if( !file )
+    {
+        fail( "cannot open " + path );
+    }
+
+    const std::vector< unsigned char > bytes( ( std::istreambuf_iterator< char >( file ) ), std::istreambuf_iterator< char >() );
+    std::size_t start = 0, length = bytes.size(), ringSize = bytes.size();
+    unsigned long pendingTicks = 0, unreportedDrops = 0;
+
+    if( !stream )
+    {
+        if( bytes.size() <= headerSize )
+        {
+            fail( path + " is too short to be a dump of xTraceRecorderBuffer" );
+        }
+
+        ringSize = bytes.size() - headerSize;
+        start = word( bytes, 1 * 4 );
+        length = word( bytes, 2 * 4 );
+        pendingTicks = word( bytes, 5 * 4 );
+        unreportedDrops = word( bytes, 6 * 4 );
+
+        if( ( start >= ringSize ) || ( length > ringSize ) )
+        {
+            fail( path + " does not hold a consistent xTraceRecorderBuffer" );
+        }
+    }
+
+    /* The records of a dump start after the header. */
+    std::vector< unsigned char > ring( bytes.begin() + static_cast< std::ptrdiff_t >( bytes.size() - ringSize ), bytes.end() );
+    Reader reader( ring, start, length, ringSize );
+    std::map< unsigned long, std::string > taskNames;
+    unsigned long long time = 0, ticks = 0, records = 0, dropped = 0;
+
+    while( !reader.atEnd() )
+    {
+        const unsigned event = reader.byte();
+
+        if( event >= numberOfEvents )
+        {
+            std::ostringstream message;
+            message << "unknown event " << event << " at byte " << ( reader.consumed() - 1 );
+            fail( message.str() );
+        }
+
+        time += reader.varint();
+
+        unsigned long parameters[ 3 ] = { 0, 0, 0 };
+
+        for( unsigned i = 0; i < events[ event ].parameters; i++ )
+        {
+            parameters[ i ] = reader.varint();
+        }
+
+        std::string name;
+
+        if( event == eventTaskCreate )
+        {
+            for( unsigned long i = 0; i < parameters[ 2 ]; i++ )
+            {
+                name += static_cast< char >( reader.byte() );
+            }
+
+            taskNames[ parameters[ 0 ] ] = name;
+        }
+        else if( event == eventTicks )
+        {
+            ticks += parameters[ 0 ];
+        }
+        else if( event == eventDropped )
+        {
+            dropped += parameters[ 0 ];
+        }
+
+        records++;
+
+        if( quiet )
+        {
+            continue;
+        }
+
+        std::printf( "%14s %10llu  %-22s", formatTime( time, usPerCount ).c_str(), ticks, events[ event ].name );
+
+        for( unsigned i = 0; i < events[ event ].parameters; i++ )
+        {
+            const std::string parameterName = events[ event ].parameterNames[ i ];
+
+            if( parameterName == "name" )
+            {
+                std::printf( " name=%s", name.c_str() );
+            }
+            else if( ( parameterName == "task" ) && ( taskNames.count( parameters[ i ] ) != 0 ) )
+            {
+                std::printf( " task=%s(%lu)", taskNames[ parameters[ i ] ].c_str(), parameters[ i ] );
+            }
+            else
+            {
+                std::printf( " %s=%lu", parameterName.c_str(), parameters[ i ] );
+            }
+        }
+
+        std::printf( "\n" );
+    }
+
+    if( !quiet && ( pendingTicks != 0 ) )
+    {
+        std::printf( "%14s %10llu  %lu ticks not yet recorded\n", "", ticks, pendingTicks );
+    }
+
+    std::printf( "summary records=%llu bytes=%lu bytes_per_record=%.2f span=%s ticks=%llu dropped=%llu\n", records,
+                 static_cast< unsigned long >( reader.consumed() ),
+                 ( records != 0 ) ? static_cast< double >( reader.consumed() ) / static_cast< double >( records ) : 0.0,
+                 formatTime( time, usPerCount ).c_str(), ticks + pendingTicks, dropped + unreportedDrops );
+
+    return EXIT_SUCCESS;
+}
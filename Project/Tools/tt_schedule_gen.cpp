@@ -0,0 +1,504 @@
+/*
+ * tt_schedule_gen - offline schedule table generator for the time-triggered
+ * scheduler (configUSE_TIME_TRIGGERED_SCHEDULER).
+ *
+ * Reads the periodic tasks of a SimSo configuration, or tasks given on the
+ * command line, simulates one hyperperiod of preemptive EDF at tick resolution
+ * with every job running for its full WCET, and writes the resulting slots as
+ * a TimeTriggeredSchedule_t to be passed to xTaskSetTimeTriggeredSchedule().
+ * The table is refused if any job would miss its deadline.
+ *
+ * Build on the host with any C++11 compiler, for example:
+ *
+ *     g++ -std=c++11 -O2 -o tt_schedule_gen tt_schedule_gen.cpp
+ *
+ * Usage:
+ *
+ *     tt_schedule_gen [-t tick_ms] [-o basename] [Simso.xml] [-T name:period:wcet[:deadline]]...
+ *
+ * Times are in milliseconds, as in SimSo.  -t gives the tick period
+ * (1 / configTICK_RATE_HZ), 1 ms by default.  Periods and deadlines must be
+ * whole numbers of ticks, WCETs are rounded up to whole ticks.  The output is
+ * written to basename.c and basename.h, tt_schedule by default.  The header
+ * defines the index of each task, which is the position of its handle in the
+ * array passed to xTaskSetTimeTriggeredSchedule().
+ *
+ * The periods and WCETs of Starter_Files_V0/source/main.c give a 1500 tick
+ * table with:
+ *
+ *     tt_schedule_gen -T Task1:300:50 -T Task2:500:150 -T Task3:750:100
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Task
+    {
+        std::string name;
+        double periodMs;
+        double wcetMs;
+        double deadlineMs;
+        unsigned long period;   /* In ticks. */
+        unsigned long wcet;     /* In ticks. */
+        unsigned long deadline; /* In ticks. */
+    };
+
+    struct Job
+    {
+        unsigned task;
+        unsigned long release;
+        unsigned long deadline;
+        unsigned long remaining;
+        bool started;
+    };
+
+    struct Slot
+    {
+        unsigned long start;
+        int task; /* -1 for an idle slot. */
+        bool release;
+    };
+
+    const int idleSlot = -1;
+
+    void fail( const std::string & message )
+    {
+        std::fprintf( stderr, "tt_schedule_gen: %s\n", message.c_str() );
+        std::exit( EXIT_FAILURE );
+    }
+
+    /* Returns the value of attribute key in the element text, or an empty
+     * string if it is not present. */
+    std::string attribute( const std::string & element,
+                           const std::string & key )
+    {
+        const std::string pattern = " " + key + "=\"";
+        const std::string::size_type start = element.find( pattern );
+
+        if( start == std::string::npos )
+        {
+            return std::string();
+        }
+
+        const std::string::size_type valueStart = start + pattern.size();
+        const std::string::size_type end = element.find( '"', valueStart );
+
+        if( end == std::string::npos )
+        {
+            fail( "unterminated attribute " + key );
+        }
+
+        return element.substr( valueStart, end - valueStart );
+    }
+
+    double number( const std::string & text,
+                   const std::string & what )
+    {
+        char * end = NULL;
+        const double value = std::strtod( text.c_str(), &end );
+
+        if( text.empty() || ( *end != '\0' ) || !( value >= 0.0 ) )
+        {
+            fail( "bad " + what + " '" + text + "'" );
+        }
+
+        return value;
+    }
+
+    void readSimso( const std::string & path,
+                    std::vector< Task > & tasks )
+    {
+        std::ifstream file( path.c_str() );
+
+        if( !file )
+        {
+            fail( "cannot open " + path );
+        }
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        const std::string xml = buffer.str();
+
+        std::string::size_type position = 0;
+
+        while( ( position = xml.find( "<task ", position ) ) != std::string::npos )
+        {
+            const std::string::size_type end = xml.find( '>', position );
+
+            if( end == std::string::npos )
+            {
+                fail( "unterminated task element in " + path );
+            }
+
+            const std::string element = xml.substr( position, end - position );
+            position = end;
+
+            const std::string name = attribute( element, "name" );
+
+            /* Only periodic tasks have a place in the table, anything else
+             * has to use the time the table leaves free. */
+            if( attribute( element, "task_type" ) != "Periodic" )
+            {
+                std::fprintf( stderr, "tt_schedule_gen: skipping %s, it is not periodic\n", name.c_str() );
+                continue;
+            }
+
+            const std::string activation = attribute( element, "activationDate" );
+
+            if( !activation.empty() && ( number( activation, "activation date of " + name ) != 0.0 ) )
+            {
+                fail( "task " + name + " has a release offset, which is not supported" );
+            }
+
+            Task task;
+            task.name = name;
+            task.periodMs = number( attribute( element, "period" ), "period of " + name );
+            task.wcetMs = number( attribute( element, "WCET" ), "WCET of " + name );
+            const std::string deadline = attribute( element, "deadline" );
+            task.deadlineMs = deadline.empty() ? task.periodMs : number( deadline, "deadline of " + name );
+            tasks.push_back( task );
+        }
+    }
+
+    /* Parses name:period:wcet[:deadline]. */
+    Task parseTask( const std::string & text )
+    {
+        std::vector< std::string > fields;
+        std::string::size_type start = 0, colon;
+
+        while( ( colon = text.find( ':', start ) ) != std::string::npos )
+        {
+            fields.push_back( text.substr( start, colon - start ) );
+            start = colon + 1;
+        }
+
+        fields.push_back( text.substr( start ) );
+
+        if( ( fields.size() < 3 ) || ( fields.size() > 4 ) || fields[ 0 ].empty() )
+        {
+            fail( "bad task '" + text + "', expected name:period:wcet[:deadline]" );
+        }
+
+        Task task;
+        task.name = fields[ 0 ];
+        task.periodMs = number( fields[ 1 ], "period of " + task.name );
+        task.wcetMs = number( fields[ 2 ], "WCET of " + task.name );
+        task.deadlineMs = ( fields.size() == 4 ) ? number( fields[ 3 ], "deadline of " + task.name ) : task.periodMs;
+
+        return task;
+    }
+
+    unsigned long wholeTicks( double ms,
+                              double tickMs,
+                              const std::string & what )
+    {
+        const double ticks = ms / tickMs;
+        const double rounded = std::floor( ticks + 0.5 );
+
+        if( ( rounded < 1.0 ) || ( std::fabs( ticks - rounded ) > 1e-6 ) )
+        {
+            fail( what + " is not a whole number of ticks" );
+        }
+
+        return static_cast< unsigned long >( rounded );
+    }
+
+    unsigned long gcd( unsigned long a,
+                       unsigned long b )
+    {
+        while( b != 0 )
+        {
+            const unsigned long r = a % b;
+            a = b;
+            b = r;
+        }
+
+        return a;
+    }
+
+    /* Simulates preemptive EDF over one hyperperiod, one tick at a time, and
+     * returns the owner of each tick as slots.  Ties go to the earlier release
+     * and then to the task listed first, so the table is reproducible. */
+    std::vector< Slot > buildSchedule( const std::vector< Task > & tasks,
+                                       unsigned long hyperperiod )
+    {
+        std::vector< Job > jobs;
+        std::vector< Slot > slots;
+        int lastTask = idleSlot;
+
+        for( unsigned long tick = 0; tick < hyperperiod; tick++ )
+        {
+            for( unsigned i = 0; i < tasks.size(); i++ )
+            {
+                if( ( tick % tasks[ i ].period ) == 0 )
+                {
+                    const Job job = { i, tick, tick + tasks[ i ].deadline, tasks[ i ].wcet, false };
+                    jobs.push_back( job );
+                }
+            }
+
+            Job * earliest = NULL;
+
+            for( std::vector< Job >::iterator job = jobs.begin(); job != jobs.end(); ++job )
+            {
+                if( job->deadline <= tick )
+                {
+                    std::ostringstream message;
+                    message << "the job of " << tasks[ job->task ].name << " released at tick " << job->release
+                            << " misses its deadline, the task set cannot be scheduled";
+                    fail( message.str() );
+                }
+
+                if( ( earliest == NULL ) ||
+                    ( job->deadline < earliest->deadline ) ||
+                    ( ( job->deadline == earliest->deadline ) && ( job->release < earliest->release ) ) ||
+                    ( ( job->deadline == earliest->deadline ) && ( job->release == earliest->release ) && ( job->task < earliest->task ) ) )
+                {
+                    earliest = &*job;
+                }
+            }
+
+            if( earliest == NULL )
+            {
+                if( lastTask != idleSlot )
+                {
+                    const Slot slot = { tick, idleSlot, false };
+                    slots.push_back( slot );
+                    lastTask = idleSlot;
+                }
+            }
+            else
+            {
+                const int task = static_cast< int >( earliest->task );
+
+                /* A new slot starts whenever the owner changes, and at the
+                 * start of every job so the slot can release it. */
+                if( ( task != lastTask ) || !earliest->started || slots.empty() )
+                {
+                    const Slot slot = { tick, task, !earliest->started };
+                    slots.push_back( slot );
+                    lastTask = task;
+                }
+
+                earliest->started = true;
+
+                if( --earliest->remaining == 0 )
+                {
+                    jobs.erase( jobs.begin() + ( earliest - &jobs[ 0 ] ) );
+                }
+            }
+        }
+
+        if( !jobs.empty() )
+        {
+            fail( "jobs are still running at the end of the hyperperiod, the task set cannot be scheduled" );
+        }
+
+        /* The table must start at 0 even if the hyperperiod starts idle. */
+        if( slots.empty() || ( slots[ 0 ].start != 0 ) )
+        {
+            const Slot slot = { 0, idleSlot, false };
+            slots.insert( slots.begin(), slot );
+        }
+
+        return slots;
+    }
+
+    std::string macroName( const std::string & name )
+    {
+        std::string macro = "ttTASK_";
+
+        for( std::string::size_type i = 0; i < name.size(); i++ )
+        {
+            const unsigned char c = static_cast< unsigned char >( name[ i ] );
+            macro += std::isalnum( c ) ? static_cast< char >( std::toupper( c ) ) : '_';
+        }
+
+        return macro;
+    }
+
+    void writeOutput( const std::string & basename,
+                      const std::string & source,
+                      const std::vector< Task > & tasks,
+                      const std::vector< Slot > & slots,
+                      unsigned long hyperperiod,
+                      double tickMs )
+    {
+        std::string guard;
+        const std::string::size_type slash = basename.find_last_of( "/\\" );
+        const std::string stem = ( slash == std::string::npos ) ? basename : basename.substr( slash + 1 );
+
+        for( std::string::size_type i = 0; i < stem.size(); i++ )
+        {
+            const unsigned char c = static_cast< unsigned char >( stem[ i ] );
+            guard += std::isalnum( c ) ? static_cast< char >( std::toupper( c ) ) : '_';
+        }
+
+        guard += "_H";
+
+        double utilisation = 0.0;
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            utilisation += static_cast< double >( tasks[ i ].wcet ) / static_cast< double >( tasks[ i ].period );
+        }
+
+        std::ofstream header( ( basename + ".h" ).c_str() );
+        std::ofstream table( ( basename + ".c" ).c_str() );
+
+        if( !header || !table )
+        {
+            fail( "cannot write " + basename + ".h and " + basename + ".c" );
+        }
+
+        header << "/* Generated by tt_schedule_gen from " << source << ", do not edit. */\n\n"
+               << "#ifndef " << guard << "\n"
+               << "#define " << guard << "\n\n"
+               << "#include \"FreeRTOS.h\"\n"
+               << "#include \"task.h\"\n\n"
+               << "/* The index of each task, the handles passed to xTaskSetTimeTriggeredSchedule()\n"
+               << " * must be in this order. */\n";
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            std::string macro = macroName( tasks[ i ].name );
+            macro.resize( std::max< std::string::size_type >( macro.size() + 1, 24 ), ' ' );
+            header << "#define " << macro << i << "\n";
+        }
+
+        header << "#define ttNUMBER_OF_TASKS       " << tasks.size() << "\n\n"
+               << "extern const TimeTriggeredSchedule_t xTimeTriggeredSchedule;\n\n"
+               << "#endif /* " << guard << " */\n";
+
+        table << "/* Generated by tt_schedule_gen from " << source << ", do not edit.\n"
+              << " *\n"
+              << " * Tick " << tickMs << " ms, hyperperiod " << hyperperiod << " ticks, " << slots.size()
+              << " slots, utilisation " << static_cast< int >( utilisation * 1000.0 + 0.5 ) / 10.0 << "%.\n"
+              << " *\n";
+
+        for( unsigned i = 0; i < tasks.size(); i++ )
+        {
+            table << " * " << tasks[ i ].name << ": period " << tasks[ i ].period << ", WCET " << tasks[ i ].wcet
+                  << ", deadline " << tasks[ i ].deadline << " ticks.\n";
+        }
+
+        table << " */\n\n"
+              << "#include \"" << stem << ".h\"\n\n"
+              << "static const TimeTriggeredSlot_t xSlots[] =\n"
+              << "{\n";
+
+        for( unsigned i = 0; i < slots.size(); i++ )
+        {
+            table << "    { " << slots[ i ].start << ", "
+                  << ( ( slots[ i ].task == idleSlot ) ? std::string( "tskTT_IDLE_SLOT" ) : macroName( tasks[ slots[ i ].task ].name ) )
+                  << ", " << ( slots[ i ].release ? "pdTRUE" : "pdFALSE" ) << " },\n";
+        }
+
+        table << "};\n\n"
+              << "const TimeTriggeredSchedule_t xTimeTriggeredSchedule =\n"
+              << "{\n"
+              << "    xSlots,\n"
+              << "    ( UBaseType_t ) ( sizeof( xSlots ) / sizeof( xSlots[ 0 ] ) ),\n"
+              << "    ( TickType_t ) " << hyperperiod << "\n"
+              << "};\n";
+    }
+}
+
+int main( int argc,
+          char * argv[] )
+{
+    std::vector< Task > tasks;
+    std::string basename = "tt_schedule";
+    std::string source;
+    double tickMs = 1.0;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        const std::string argument = argv[ i ];
+
+        if( ( argument == "-t" ) || ( argument == "-o" ) || ( argument == "-T" ) )
+        {
+            if( ++i == argc )
+            {
+                fail( "missing value after " + argument );
+            }
+
+            if( argument == "-t" )
+            {
+                tickMs = number( argv[ i ], "tick period" );
+
+                if( tickMs <= 0.0 )
+                {
+                    fail( "the tick period must be above 0" );
+                }
+            }
+            else if( argument == "-o" )
+            {
+                basename = argv[ i ];
+            }
+            else
+            {
+                tasks.push_back( parseTask( argv[ i ] ) );
+                source = source.empty() ? "the command line" : source;
+            }
+        }
+        else if( !argument.empty() && ( argument[ 0 ] == '-' ) )
+        {
+            fail( "usage: tt_schedule_gen [-t tick_ms] [-o basename] [Simso.xml] [-T name:period:wcet[:deadline]]..." );
+        }
+        else
+        {
+            readSimso( argument, tasks );
+            const std::string::size_type slash = argument.find_last_of( "/\\" );
+            source = ( slash == std::string::npos ) ? argument : argument.substr( slash + 1 );
+        }
+    }
+
+    if( tasks.empty() )
+    {
+        fail( "no periodic tasks given" );
+    }
+
+    if( tasks.size() >= 0xFFU )
+    {
+        fail( "too many tasks, the slot task index is 8 bits" );
+    }
+
+    unsigned long hyperperiod = 1;
+
+    for( unsigned i = 0; i < tasks.size(); i++ )
+    {
+        Task & task = tasks[ i ];
+        task.period = wholeTicks( task.periodMs, tickMs, "the period of " + task.name );
+        task.deadline = wholeTicks( task.deadlineMs, tickMs, "the deadline of " + task.name );
+        task.wcet = static_cast< unsigned long >( std::ceil( task.wcetMs / tickMs - 1e-9 ) );
+
+        if( ( task.wcet == 0 ) || ( task.wcet > task.deadline ) || ( task.deadline > task.period ) )
+        {
+            fail( "task " + task.name + " needs 0 < WCET <= deadline <= period" );
+        }
+
+        hyperperiod = ( hyperperiod / gcd( hyperperiod, task.period ) ) * task.period;
+
+        if( hyperperiod > 1000000UL )
+        {
+            fail( "the hyperperiod is too long for a table" );
+        }
+    }
+
+    const std::vector< Slot > slots = buildSchedule( tasks, hyperperiod );
+    writeOutput( basename, source, tasks, slots, hyperperiod, tickMs );
+
+    std::printf( "%s.c: %lu ticks, %lu slots\n", basename.c_str(), hyperperiod, static_cast< unsigned long >( slots.size() ) );
+
+    return EXIT_SUCCESS;
+}